@@ -38,6 +38,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+
 using namespace std::string_literals;
 
 namespace {
@@ -82,8 +84,100 @@ size_t columnIndex(int col_id) {
   return static_cast<size_t>(col_id - 1000);
 }
 
+/**
+ * Replace strings of a column with ids of the given string dictionary.
+ */
+std::shared_ptr<arrow::ChunkedArray> encodeDictionaryColumn(
+    StringDictionary* string_dict,
+    const int elem_size,
+    std::shared_ptr<arrow::ChunkedArray> col_data) {
+  arrow::ArrayVector col_indices_data;
+  const auto& chunks = col_data->chunks();
+  for (const auto& crt_chunk : chunks) {
+    auto col_strings =
+        std::static_pointer_cast<arrow::StringArray>(crt_chunk->Slice(0));
+    CHECK(col_strings);
+
+    const size_t bulk_size = static_cast<size_t>(col_strings->length());
+
+    // dictionary conversion
+    std::vector<std::string_view> bulk(bulk_size);
+    for (size_t j = 0; j < bulk_size; j++) {
+      if (!col_strings->IsNull(j)) {
+        auto view = col_strings->GetView(j);
+        bulk[j] = std::string_view(view.data(), view.length());
+      }
+    }
+
+    std::shared_ptr<arrow::Array> indices_chunk;
+    if (elem_size == 4) {
+      // not an encoded dictionary
+      std::shared_ptr<arrow::Buffer> indices_buf;
+      auto res = arrow::AllocateBuffer(bulk_size * 4);
+      CHECK(res.ok());
+      indices_buf = std::move(res).ValueOrDie();
+      auto raw_data = reinterpret_cast<int32_t*>(indices_buf->mutable_data());
+      string_dict->getOrAddBulk(bulk, raw_data);
+      indices_chunk = std::make_shared<arrow::Int32Array>(bulk_size, indices_buf);
+    } else {
+      // encoded
+      std::vector<int32_t> indices_buffer(bulk_size);
+      string_dict->getOrAddBulk(bulk, indices_buffer.data());
+
+      // create arrow buffer of encoded size and copy into it
+      std::shared_ptr<arrow::Buffer> encoded_indices_buf;
+      auto res = arrow::AllocateBuffer(bulk_size * elem_size);
+      CHECK(res.ok());
+      encoded_indices_buf = std::move(res).ValueOrDie();
+      switch (elem_size) {
+        case 1: {
+          auto encoded_indices_buf_ptr =
+              reinterpret_cast<int8_t*>(encoded_indices_buf->mutable_data());
+          CHECK(encoded_indices_buf_ptr);
+          for (size_t i = 0; i < bulk_size; i++) {
+            encoded_indices_buf_ptr[i] =
+                indices_buffer[i] == std::numeric_limits<int32_t>::min() ||
+                        indices_buffer[i] > std::numeric_limits<uint8_t>::max()
+                    ? std::numeric_limits<uint8_t>::max()
+                    : indices_buffer[i];
+          }
+          indices_chunk =
+              std::make_shared<arrow::Int8Array>(bulk_size, encoded_indices_buf);
+          break;
+        }
+        case 2: {
+          auto encoded_indices_buf_ptr =
+              reinterpret_cast<int16_t*>(encoded_indices_buf->mutable_data());
+          CHECK(encoded_indices_buf_ptr);
+          for (size_t i = 0; i < bulk_size; i++) {
+            encoded_indices_buf_ptr[i] =
+                indices_buffer[i] == std::numeric_limits<int32_t>::min() ||
+                        indices_buffer[i] > std::numeric_limits<uint16_t>::max()
+                    ? std::numeric_limits<uint16_t>::max()
+                    : indices_buffer[i];
+          }
+          indices_chunk =
+              std::make_shared<arrow::Int16Array>(bulk_size, encoded_indices_buf);
+          break;
+        }
+        default:
+          LOG(FATAL) << "Unrecognized element size " << elem_size;
+      }
+    }
+    CHECK(indices_chunk);
+    col_indices_data.push_back(indices_chunk);
+  }
+
+  CHECK_EQ(col_indices_data.size(), chunks.size());
+  return arrow::ChunkedArray::Make(col_indices_data).ValueOrDie();
+}
+
 }  // anonymous namespace
 
+ArrowStorage::~ArrowStorage() {
+  waitDictionaryMaterialization();
+}
+
 void ArrowStorage::fetchBuffer(const ChunkKey& key,
                                Data_Namespace::AbstractBuffer* dest,
                                const size_t num_bytes) {
@@ -393,6 +487,9 @@ std::shared_ptr<TableFragmentsInfo> ArrowStorage::getEmptyTableMetadata(
 }
 
 const DictDescriptor* ArrowStorage::getDictMetadata(int dict_id, bool load_dict) {
+  // Table data is locked before dictionaries, the same way table creation and
+  // removal do it.
+  mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
   mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
   CHECK_EQ(getSchemaId(dict_id), schema_id_);
   if (dicts_.count(dict_id)) {
@@ -411,6 +508,7 @@ const DictDescriptor* ArrowStorage::getDictMetadata(int dict_id, bool load_dict)
 }
 
 void ArrowStorage::materializeDictionary(DictionaryData* dict) {
+  // Callers hold data_mutex_ and dict_mutex_ shared, and dict->mutex.
   CHECK(dict);
   CHECK(!dict->table_ids.empty());
 
@@ -419,14 +517,14 @@ void ArrowStorage::materializeDictionary(DictionaryData* dict) {
   auto* string_dict = dict_desc->stringDict.get();
   CHECK(string_dict);
   const int elem_size = dict_desc->dictNBits / 8;
+  dict->is_materializing = true;
 
   for (const auto table_id : dict->table_ids) {
-    mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
     auto& table = *tables_.at(table_id);
-    data_lock.unlock();
 
-    // TODO: should we add the data lock here?
-    mapd_unique_lock<mapd_shared_mutex> table_lock(table.mutex);
+    // Columns are encoded under a shared table lock to let queries read the
+    // table meanwhile.
+    mapd_shared_lock<mapd_shared_mutex> table_read_lock(table.mutex);
 
     if (table.row_count == 0) {
       // skip empty tables
@@ -435,6 +533,8 @@ void ArrowStorage::materializeDictionary(DictionaryData* dict) {
     auto col_ids = dict->table_ids_to_column_ids.at(table_id);
     CHECK(!col_ids.empty());
 
+    std::vector<int> str_col_ids;
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> str_col_data;
     for (const auto col_id : col_ids) {
       CHECK_LT(col_id, int(table.col_data.size()))
           << "(" << table_id << ", " << col_id << ")";
@@ -446,87 +546,33 @@ void ArrowStorage::materializeDictionary(DictionaryData* dict) {
                 << col_id << " in table " << table_id;
         continue;
       }
+      str_col_ids.push_back(col_id);
+      str_col_data.push_back(col_data);
+    }
+    table_read_lock.unlock();
+    if (str_col_ids.empty()) {
+      continue;
+    }
 
-      arrow::ArrayVector col_indices_data;
-      const auto& chunks = col_data->chunks();
-      for (const auto& crt_chunk : chunks) {
-        auto col_strings =
-            std::static_pointer_cast<arrow::StringArray>(crt_chunk->Slice(0));
-        CHECK(col_strings);
-
-        const size_t bulk_size = static_cast<size_t>(col_strings->length());
-
-        // dictionary conversion
-        std::vector<std::string_view> bulk(bulk_size);
-        for (size_t j = 0; j < bulk_size; j++) {
-          if (!col_strings->IsNull(j)) {
-            auto view = col_strings->GetView(j);
-            bulk[j] = std::string_view(view.data(), view.length());
-          }
-        }
-
-        std::shared_ptr<arrow::Array> indices_chunk;
-        if (elem_size == 4) {
-          // not an encoded dictionary
-          std::shared_ptr<arrow::Buffer> indices_buf;
-          auto res = arrow::AllocateBuffer(bulk_size * 4);
-          CHECK(res.ok());
-          indices_buf = std::move(res).ValueOrDie();
-          auto raw_data = reinterpret_cast<int32_t*>(indices_buf->mutable_data());
-          string_dict->getOrAddBulk(bulk, raw_data);
-          indices_chunk = std::make_shared<arrow::Int32Array>(bulk_size, indices_buf);
-        } else {
-          // encoded
-          std::vector<int32_t> indices_buffer(bulk_size);
-          string_dict->getOrAddBulk(bulk, indices_buffer.data());
-
-          // create arrow buffer of encoded size and copy into it
-          std::shared_ptr<arrow::Buffer> encoded_indices_buf;
-          auto res = arrow::AllocateBuffer(bulk_size * elem_size);
-          CHECK(res.ok());
-          encoded_indices_buf = std::move(res).ValueOrDie();
-          switch (elem_size) {
-            case 1: {
-              auto encoded_indices_buf_ptr =
-                  reinterpret_cast<int8_t*>(encoded_indices_buf->mutable_data());
-              CHECK(encoded_indices_buf_ptr);
-              for (size_t i = 0; i < bulk_size; i++) {
-                encoded_indices_buf_ptr[i] =
-                    indices_buffer[i] == std::numeric_limits<int32_t>::min() ||
-                            indices_buffer[i] > std::numeric_limits<uint8_t>::max()
-                        ? std::numeric_limits<uint8_t>::max()
-                        : indices_buffer[i];
-              }
-              indices_chunk =
-                  std::make_shared<arrow::Int8Array>(bulk_size, encoded_indices_buf);
-              break;
-            }
-            case 2: {
-              auto encoded_indices_buf_ptr =
-                  reinterpret_cast<int16_t*>(encoded_indices_buf->mutable_data());
-              CHECK(encoded_indices_buf_ptr);
-              for (size_t i = 0; i < bulk_size; i++) {
-                encoded_indices_buf_ptr[i] =
-                    indices_buffer[i] == std::numeric_limits<int32_t>::min() ||
-                            indices_buffer[i] > std::numeric_limits<uint16_t>::max()
-                        ? std::numeric_limits<uint16_t>::max()
-                        : indices_buffer[i];
-              }
-              indices_chunk =
-                  std::make_shared<arrow::Int16Array>(bulk_size, encoded_indices_buf);
-              break;
-              break;
-            }
-            default:
-              LOG(FATAL) << "Unrecognized element size " << elem_size;
-          }
-        }
-        CHECK(indices_chunk);
-        col_indices_data.push_back(indices_chunk);
+    // All these columns share the dictionary, so they are encoded one by one to
+    // get ids independent of task scheduling.
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> new_col_data(str_col_ids.size());
+    for (size_t i = 0; i < str_col_ids.size(); ++i) {
+      if (config_->storage.enable_sorted_dict_import) {
+        addSortedDictionaryStrings(string_dict, elem_size, str_col_data[i]);
       }
+      new_col_data[i] = encodeDictionaryColumn(string_dict, elem_size, str_col_data[i]);
+    }
 
-      CHECK_EQ(col_indices_data.size(), chunks.size());
-      auto new_col_data = arrow::ChunkedArray::Make(col_indices_data).ValueOrDie();
+    mapd_unique_lock<mapd_shared_mutex> table_lock(table.mutex);
+    for (size_t i = 0; i < str_col_ids.size(); ++i) {
+      const auto col_id = str_col_ids[i];
+      if (table.col_data[col_id] != str_col_data[i]) {
+        // Strings were appended to the column while we were encoding it.
+        CHECK(table.col_data[col_id]->type() == arrow::utf8());
+        new_col_data[i] =
+            encodeDictionaryColumn(string_dict, elem_size, table.col_data[col_id]);
+      }
 
       VLOG(1) << "Materialized string dictionary for column " << col_id << " in table "
               << table_id;
@@ -537,22 +583,22 @@ void ArrowStorage::materializeDictionary(DictionaryData* dict) {
         auto& meta = frag.metadata[col_id];
         // compute chunk stats is multi threaded, so we single thread this
         auto stats =
-            computeStats(new_col_data->Slice(frag.offset, frag.row_count), dict->type);
+            computeStats(new_col_data[i]->Slice(frag.offset, frag.row_count), dict->type);
         meta->fillChunkStats(stats);
         table.table_stats[columnId(col_id)] = stats;
       }
-      for (size_t i = 1; i < table.fragments.size(); i++) {
-        auto& frag = table.fragments[i];
+      for (size_t frag_idx = 1; frag_idx < table.fragments.size(); frag_idx++) {
+        auto& frag = table.fragments[frag_idx];
         CHECK_LT(static_cast<size_t>(col_id), frag.metadata.size());
         auto& meta = frag.metadata[col_id];
         // compute chunk stats is multi threaded, so we single thread this
         auto stats =
-            computeStats(new_col_data->Slice(frag.offset, frag.row_count), dict->type);
+            computeStats(new_col_data[i]->Slice(frag.offset, frag.row_count), dict->type);
         meta->fillChunkStats(stats);
         mergeStats(table.table_stats[columnId(col_id)], stats, dict->type);
       }
 
-      table.col_data[col_id] = new_col_data;
+      table.col_data[col_id] = new_col_data[i];
     }  // per column
   }    // per table
   dict->is_materialized = true;
@@ -578,10 +624,20 @@ TableInfoPtr ArrowStorage::createTable(const std::string& table_name,
           type->isArray() ? type->as<hdk::ir::ArrayBaseType>()->elemType() : type;
       // Positive dictionary id means we use existing dictionary. Other values
       // mean we have to create new dictionaries. Columns with equal negative
-      // dict ids will share dictionaries.
+      // dict ids will share dictionaries. Columns of a dictionary domain use
+      // the domain's dictionary if it already exists.
       if (elem_type->isExtDictionary()) {
         auto dict_type = elem_type->as<hdk::ir::ExtDictionaryType>();
         auto sharing_id = dict_type->dictId();
+        const auto domain = getDictDomain(col.name, sharing_id, options);
+        if (!domain.empty() && dict_domains_.count(domain)) {
+          sharing_id = dict_domains_.at(domain);
+          if (dicts_.at(sharing_id)->dict()->dictNBits != dict_type->size() * 8) {
+            throw std::runtime_error("Column '"s + col.name +
+                                     "' and dictionary domain '"s + domain +
+                                     "' use different dictionary id sizes");
+          }
+        }
         if (sharing_id < 0 && dict_ids.count(sharing_id)) {
           const auto dict_id = dict_ids.at(sharing_id);
           elem_type = ctx_.extDict(dict_type->elemType(), dict_id, dict_type->size());
@@ -607,6 +663,9 @@ TableInfoPtr ArrowStorage::createTable(const std::string& table_name,
           if (sharing_id < 0) {
             dict_ids.emplace(sharing_id, dict_id);
           }
+          if (!domain.empty()) {
+            dict_domains_.emplace(domain, dict_id);
+          }
           if (dicts_.find(dict_id) == dicts_.end()) {
             auto dict_data_owned = std::make_unique<DictionaryData>(
                 std::move(dict_desc),
@@ -621,6 +680,7 @@ TableInfoPtr ArrowStorage::createTable(const std::string& table_name,
           CHECK_GT(sharing_id, 0);
           auto* dict_data = dicts_.at(sharing_id).get();
           dict_data->addTableColumnPair(table_id, next_col_idx);
+          elem_type = ctx_.extDict(dict_type->elemType(), sharing_id, dict_type->size());
         }
 
         if (type->isFixedLenArray()) {
@@ -858,6 +918,18 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at,
 }
 
 void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_id) {
+  // Fixed size binary data is imported as strings reusing its values buffer.
+  // TODO: add a fixed-width inline string type to avoid offsets and to compare
+  // and hash such values in generated code without a dictionary.
+  for (int col_idx = 0; col_idx < at->num_columns(); ++col_idx) {
+    if (at->column(col_idx)->type()->id() == arrow::Type::FIXED_SIZE_BINARY) {
+      at = at->SetColumn(col_idx,
+                         at->field(col_idx)->WithType(arrow::utf8()),
+                         convertFixedSizeBinaryToString(at->column(col_idx)))
+               .ValueOrDie();
+    }
+  }
+
   mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
   if (!tables_.count(table_id)) {
     throw std::runtime_error("Invalid table id: "s + std::to_string(table_id));
@@ -902,6 +974,7 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
 
   mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
   std::vector<bool> lazy_fetch_cols(at->columns().size(), false);
+  std::set<int> lazy_dict_ids;
   if (config_->storage.enable_lazy_dict_materialization) {
     VLOG(1) << "Appending arrow table with lazy dictionary materialization enabled";
     for (size_t col_idx = 0; col_idx < at->columns().size(); col_idx++) {
@@ -910,14 +983,52 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
       auto col_type = col_info->type;
       auto col_arr = at->column(col_idx);
       if (col_type->isExtDictionary() && col_arr->type()->id() == arrow::Type::STRING) {
-        auto dict_data =
-            dicts_.at(dynamic_cast<const hdk::ir::ExtDictionaryType*>(col_type)->dictId())
-                .get();
+        auto dict_id = col_type->as<hdk::ir::ExtDictionaryType>()->dictId();
+        auto dict_data = dicts_.at(dict_id).get();
         CHECK(dict_data);
         // appends to materialized dictionaries are automatically materialiezd
         if (!dict_data->is_materialized) {
-          lazy_fetch_cols[col_idx] = true;
+          // Column data already encoded by a running materialization is extended
+          // with encoded data too.
+          bool encoded = table.row_count
+                             ? table.col_data[col_idx]->type() != arrow::utf8()
+                             : dict_data->is_materializing.load();
+          if (!encoded) {
+            lazy_fetch_cols[col_idx] = true;
+            lazy_dict_ids.insert(dict_id);
+          }
+        }
+      }
+    }
+  }
+
+  // Columns sharing a dictionary are encoded one by one in the column order to get
+  // ids independent of task scheduling. Other columns are encoded in parallel.
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> serially_encoded(
+      at->columns().size());
+  {
+    std::map<int, std::vector<int>> dict_cols;
+    for (int col_idx = 0; col_idx < static_cast<int>(at->columns().size()); ++col_idx) {
+      auto col_type = getColumnInfo(db_id_, table_id, columnId(col_idx))->type;
+      if (col_type->isExtDictionary() &&
+          at->column(col_idx)->type()->id() == arrow::Type::STRING &&
+          (config_->storage.enable_non_lazy_data_import || !lazy_fetch_cols[col_idx])) {
+        dict_cols[col_type->as<hdk::ir::ExtDictionaryType>()->dictId()].push_back(
+            col_idx);
+      }
+    }
+    for (auto& [dict_id, col_idxs] : dict_cols) {
+      if (col_idxs.size() < 2) {
+        continue;
+      }
+      auto string_dict = dicts_.at(dict_id)->dict()->stringDict.get();
+      for (auto col_idx : col_idxs) {
+        auto col_type = getColumnInfo(db_id_, table_id, columnId(col_idx))->type;
+        if (config_->storage.enable_sorted_dict_import) {
+          addSortedDictionaryStrings(string_dict, col_type->size(), at->column(col_idx));
         }
+        serially_encoded[col_idx] =
+            createDictionaryEncodedColumn(string_dict, at->column(col_idx), col_type);
       }
     }
   }
@@ -954,9 +1065,14 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
         switch (col_arr->type()->id()) {
           case arrow::Type::STRING:
             // if the dictionary has already been materialized, append indices
-            if (config_->storage.enable_non_lazy_data_import ||
-                !config_->storage.enable_lazy_dict_materialization ||
-                dict_data->is_materialized) {
+            if (serially_encoded[col_idx]) {
+              col_arr = serially_encoded[col_idx];
+            } else if (config_->storage.enable_non_lazy_data_import ||
+                       !lazy_fetch_cols[col_idx]) {
+              if (config_->storage.enable_sorted_dict_import) {
+                addSortedDictionaryStrings(
+                    dict_data->dict()->stringDict.get(), col_type->size(), col_arr);
+              }
               col_arr = createDictionaryEncodedColumn(
                   dict_data->dict()->stringDict.get(), col_arr, col_type);
             }
@@ -1132,6 +1248,9 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
   table_info->fragments = table.fragments.size();
   table_info->row_count = table.row_count;
   setTableMetadata(table, table_id);
+  table_lock.unlock();
+
+  scheduleDictionaryMaterialization(lazy_dict_ids);
 }
 
 TableInfoPtr ArrowStorage::importCsvFile(const std::string& file_name,
@@ -1317,6 +1436,115 @@ void ArrowStorage::dropTable(int table_id, bool throw_if_not_exist) {
   for (auto dict_id : dicts_to_remove) {
     dicts_.erase(dict_id);
   }
+  for (auto it = dict_domains_.begin(); it != dict_domains_.end();) {
+    if (dicts_to_remove.count(it->second)) {
+      it = dict_domains_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+size_t ArrowStorage::compactDictionaries() {
+  mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
+  size_t released = 0;
+  for (auto& [dict_id, dict_data] : dicts_) {
+    // Dictionaries waiting for lazy materialization hold no strings yet.
+    if (dict_data->is_materialized) {
+      std::lock_guard<std::mutex> materialization_lock(dict_data->mutex);
+      released += dict_data->dict()->stringDict->compact();
+    }
+  }
+  return released;
+}
+
+void ArrowStorage::scheduleDictionaryMaterialization(const std::set<int>& dict_ids) {
+  if (!dict_materialization_arena_) {
+    return;
+  }
+  mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
+  for (auto dict_id : dict_ids) {
+    auto dict = dicts_.at(dict_id).get();
+    if (dict->is_materialized || dict->is_scheduled.exchange(true)) {
+      continue;
+    }
+    dict_materialization_arena_->execute([this, dict_id]() {
+      dict_materialization_tasks_.run([this, dict_id]() {
+        mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+        mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
+        // The dictionary might be removed with its last table.
+        if (!dicts_.count(dict_id)) {
+          return;
+        }
+        auto dict_data = dicts_.at(dict_id).get();
+        try {
+          std::lock_guard<std::mutex> materialization_lock(dict_data->mutex);
+          if (!dict_data->is_materialized) {
+            materializeDictionary(dict_data);
+          }
+        } catch (const std::exception& e) {
+          LOG(ERROR) << "Background materialization of dictionary " << dict_id
+                     << " failed: " << e.what();
+        }
+        dict_data->is_scheduled = false;
+      });
+    });
+  }
+}
+
+void ArrowStorage::waitDictionaryMaterialization() {
+  if (dict_materialization_arena_) {
+    dict_materialization_arena_->execute(
+        [this]() { dict_materialization_tasks_.wait(); });
+  }
+}
+
+std::vector<ArrowStorage::DictMaterializationStatus>
+ArrowStorage::getDictMaterializationStatus() const {
+  std::vector<DictMaterializationStatus> res;
+  mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
+  for (auto& [dict_id, dict_data] : dicts_) {
+    DictMaterializationStatus status{dict_id,
+                                     dict_data->is_materialized,
+                                     dict_data->is_scheduled,
+                                     0,
+                                     0};
+    for (auto& [table_id, col_ids] : dict_data->table_ids_to_column_ids) {
+      if (!tables_.count(table_id)) {
+        continue;
+      }
+      auto& table = *tables_.at(table_id);
+      mapd_shared_lock<mapd_shared_mutex> table_lock(table.mutex);
+      for (auto col_id : col_ids) {
+        ++status.column_count;
+        // Columns of empty tables have nothing to materialize.
+        if (status.is_materialized || table.row_count == 0 ||
+            table.col_data[col_id]->type() != arrow::utf8()) {
+          ++status.materialized_column_count;
+        }
+      }
+    }
+    res.push_back(status);
+  }
+  std::sort(res.begin(), res.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.dict_id < rhs.dict_id;
+  });
+  return res;
+}
+
+std::string ArrowStorage::getDictDomain(const std::string& col_name,
+                                        const int dict_id,
+                                        const TableOptions& options) const {
+  // Explicitly referenced dictionaries are never replaced by domains.
+  if (dict_id > 0) {
+    return "";
+  }
+  auto it = options.dict_domains.find(col_name);
+  if (it != options.dict_domains.end()) {
+    return it->second;
+  }
+  return config_->storage.share_dicts_by_column_name ? col_name : "";
 }
 
 void ArrowStorage::checkNewTableParams(const std::string& table_name,
@@ -1377,6 +1605,28 @@ void ArrowStorage::checkNewTableParams(const std::string& table_name,
 
     col_names.insert(col.name);
   }
+
+  for (auto& [col_name, domain] : options.dict_domains) {
+    auto it = std::find_if(columns.begin(), columns.end(), [&](auto& col) {
+      return col.name == col_name;
+    });
+    if (it == columns.end()) {
+      throw std::runtime_error("Dictionary domain is specified for unknown column '"s +
+                               col_name + "'");
+    }
+    auto elem_type = it->type->isArray()
+                         ? it->type->as<hdk::ir::ArrayBaseType>()->elemType()
+                         : it->type;
+    if (!elem_type->isExtDictionary()) {
+      throw std::runtime_error(
+          "Dictionary domain is specified for non-dictionary column '"s + col_name +
+          "'");
+    }
+    if (elem_type->as<hdk::ir::ExtDictionaryType>()->dictId() > 0 && !domain.empty()) {
+      throw std::runtime_error("Column '"s + col_name +
+                               "' cannot reference both a dictionary and a domain");
+    }
+  }
 }
 
 void ArrowStorage::compareSchemas(std::shared_ptr<arrow::Schema> lhs,
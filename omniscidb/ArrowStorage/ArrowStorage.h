@@ -21,6 +21,8 @@
 #include "Shared/mapd_shared_mutex.h"
 
 #include <arrow/api.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
 
 namespace hdk::ir {
 class Type;
@@ -38,6 +40,9 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
     TableOptions(size_t fragment_size_) : fragment_size(fragment_size_){};
 
     size_t fragment_size = 32'000'000;
+    // Maps names of dictionary encoded columns to dictionary domains. Columns of
+    // the same domain, including columns of other tables, share a dictionary.
+    std::unordered_map<std::string, std::string> dict_domains;
   };
 
   struct CsvParseOptions {
@@ -56,11 +61,29 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
     size_t block_size = 1 << 20;  // Default block size is 1MB
   };
 
+  struct DictMaterializationStatus {
+    int dict_id;
+    bool is_materialized;
+    // Materialization is queued for background threads or is in progress.
+    bool is_scheduled;
+    size_t column_count;
+    size_t materialized_column_count;
+  };
+
   ArrowStorage(int schema_id, const std::string& schema_name, int db_id, ConfigPtr config)
       : SimpleSchemaProvider(hdk::ir::Context::defaultCtx(), schema_id, schema_name)
       , db_id_(db_id)
       , schema_id_(getSchemaId(db_id))
-      , config_(config) {}
+      , config_(config) {
+    if (config_->storage.enable_lazy_dict_materialization &&
+        config_->storage.background_dict_materialization_threads) {
+      dict_materialization_arena_ = std::make_unique<tbb::task_arena>(
+          static_cast<int>(config_->storage.background_dict_materialization_threads),
+          0);
+    }
+  }
+
+  ~ArrowStorage() override;
 
   void fetchBuffer(const ChunkKey& key,
                    Data_Namespace::AbstractBuffer* dest,
@@ -136,6 +159,17 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
   void dropTable(const std::string& table_name, bool throw_if_not_exist = false);
   void dropTable(int table_id, bool throw_if_not_exist = false);
 
+  // Releases memory reserved for future additions in all materialized
+  // dictionaries. Returns the number of released bytes.
+  size_t compactDictionaries();
+
+  // Blocks until all scheduled background dictionary materializations are done.
+  void waitDictionaryMaterialization();
+
+  // Reports materialization progress of all lazy dictionaries. Materialized
+  // dictionaries are reported too.
+  std::vector<DictMaterializationStatus> getDictMaterializationStatus() const;
+
   int dbId() const { return db_id_; }
 
   std::shared_ptr<arrow::Table> parseCsvFile(const std::string& file_name,
@@ -181,6 +215,10 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
     std::set<int> table_ids;
     std::unordered_map<int, std::set<int>> table_ids_to_column_ids;
     std::atomic<bool> is_materialized{false};
+    // Set when materialization starts. Appends to tables not yet holding any
+    // data of the dictionary encode new strings right away from this point.
+    std::atomic<bool> is_materializing{false};
+    std::atomic<bool> is_scheduled{false};
 
     DictionaryData(std::unique_ptr<DictDescriptor>&& dict_descriptor,
                    const hdk::ir::ExtDictionaryType* type,
@@ -245,6 +283,10 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
                             size_t num_bytes) const;
   void refragmentTable(TableData& table, const int table_id, const size_t new_frag_size);
   void materializeDictionary(DictionaryData* dict_data);
+  void scheduleDictionaryMaterialization(const std::set<int>& dict_ids);
+  std::string getDictDomain(const std::string& col_name,
+                            const int dict_id,
+                            const TableOptions& options) const;
   void setTableMetadata(TableData& table, const int table_id) const;
 
   int db_id_;
@@ -253,8 +295,12 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
   int next_dict_id_ = 1;
   std::unordered_map<int, std::unique_ptr<TableData>> tables_;
   std::unordered_map<int, std::unique_ptr<DictionaryData>> dicts_;
+  std::unordered_map<std::string, int> dict_domains_;
   mutable mapd_shared_mutex data_mutex_;
   mutable mapd_shared_mutex dict_mutex_;
 
   ConfigPtr config_;
+
+  std::unique_ptr<tbb::task_arena> dict_materialization_arena_;
+  tbb::task_group dict_materialization_tasks_;
 };
@@ -15,12 +15,15 @@
 #include "ArrowStorageUtils.h"
 
 #include "IR/Context.h"
+#include "Shared/ArrowUtil.h"
 #include "Shared/InlineNullValues.h"
 
 #include <arrow/compute/api.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
 #include <tbb/task_group.h>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace std::string_literals;
@@ -985,6 +988,10 @@ const hdk::ir::Type* getTargetImportType(hdk::ir::Context& ctx,
       return ctx.fp64();
     case Type::STRING:
       return ctx.extDict(ctx.text(), 0);
+    case Type::FIXED_SIZE_BINARY:
+      // Fixed size values are usually unique keys and hashes, which are poor
+      // candidates for dictionary encoding.
+      return ctx.text();
     case Type::NA:
       return ctx.fp64();
     case arrow::Type::DICTIONARY: {
@@ -1188,6 +1195,40 @@ std::shared_ptr<arrow::ChunkedArray> createDictionaryEncodedColumn(
   return nullptr;
 }
 
+void addSortedDictionaryStrings(StringDictionary* dict,
+                                int elem_size,
+                                std::shared_ptr<arrow::ChunkedArray> arr) {
+  std::vector<std::string_view> strings;
+  strings.reserve(arr->length());
+  for (auto& chunk : arr->chunks()) {
+    auto str_chunk = std::static_pointer_cast<arrow::StringArray>(chunk);
+    for (int64_t i = 0; i < str_chunk->length(); ++i) {
+      auto view = str_chunk->GetView(i);
+      // Empty strings and nulls are not stored in dictionaries.
+      if (str_chunk->IsValid(i) && view.length()) {
+        strings.emplace_back(view.data(), view.length());
+      }
+    }
+  }
+  tbb::parallel_sort(strings.begin(), strings.end());
+  strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+  // Use the id type of the column, so dictionary overflow is reported here.
+  switch (elem_size) {
+    case 1: {
+      std::vector<uint8_t> ids(strings.size());
+      dict->getOrAddBulk(strings, ids.data());
+      break;
+    }
+    case 2: {
+      std::vector<uint16_t> ids(strings.size());
+      dict->getOrAddBulk(strings, ids.data());
+      break;
+    }
+    default:
+      dict->getOrAddBulk(strings);
+  }
+}
+
 namespace {
 
 template <typename INDEX_TYPE>
@@ -1280,3 +1321,57 @@ std::shared_ptr<arrow::ChunkedArray> decodeArrowDictionary(
   }
   return std::make_shared<arrow::ChunkedArray>(converted_chunks);
 }
+
+std::shared_ptr<arrow::ChunkedArray> convertFixedSizeBinaryToString(
+    std::shared_ptr<arrow::ChunkedArray> arr) {
+  CHECK_EQ(arr->type()->id(), arrow::Type::FIXED_SIZE_BINARY);
+  const int32_t width =
+      static_cast<const arrow::FixedSizeBinaryType&>(*arr->type()).byte_width();
+  // Split big chunks to fit string offsets into int32.
+  const int64_t max_chunk_rows =
+      width ? std::numeric_limits<int32_t>::max() / width
+            : std::numeric_limits<int64_t>::max();
+  std::vector<std::shared_ptr<arrow::Array>> converted_chunks;
+  for (auto& chunk : arr->chunks()) {
+    for (int64_t start = 0; start < chunk->length(); start += max_chunk_rows) {
+      auto src = std::static_pointer_cast<arrow::FixedSizeBinaryArray>(
+          chunk->Slice(start, max_chunk_rows));
+      const int64_t length = src->length();
+
+      if (src->null_count()) {
+        // Nulls are stored as empty strings, so values have to be moved.
+        arrow::StringBuilder builder;
+        ARROW_THROW_NOT_OK(builder.Reserve(length));
+        ARROW_THROW_NOT_OK(builder.ReserveData((length - src->null_count()) * width));
+        for (int64_t i = 0; i < length; ++i) {
+          if (src->IsNull(i)) {
+            builder.UnsafeAppendNull();
+          } else {
+            builder.UnsafeAppend(src->GetValue(i), width);
+          }
+        }
+        std::shared_ptr<arrow::Array> res;
+        ARROW_THROW_NOT_OK(builder.Finish(&res));
+        converted_chunks.push_back(res);
+        continue;
+      }
+
+      std::shared_ptr<arrow::Buffer> offsets_buf =
+          arrow::AllocateBuffer((length + 1) * sizeof(int32_t)).ValueOrDie();
+      auto offsets = reinterpret_cast<int32_t*>(offsets_buf->mutable_data());
+      for (int64_t i = 0; i <= length; ++i) {
+        offsets[i] = static_cast<int32_t>(i * width);
+      }
+      std::shared_ptr<arrow::Buffer> values_buf;
+      if (length) {
+        values_buf =
+            arrow::SliceBuffer(src->values(), src->offset() * width, length * width);
+      } else {
+        values_buf = arrow::AllocateBuffer(0).ValueOrDie();
+      }
+      converted_chunks.push_back(std::make_shared<arrow::StringArray>(
+          length, std::move(offsets_buf), std::move(values_buf)));
+    }
+  }
+  return std::make_shared<arrow::ChunkedArray>(converted_chunks, arrow::utf8());
+}
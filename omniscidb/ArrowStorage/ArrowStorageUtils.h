@@ -40,6 +40,13 @@ std::shared_ptr<arrow::ChunkedArray> createDictionaryEncodedColumn(
     std::shared_ptr<arrow::ChunkedArray> arr,
     const hdk::ir::Type* type);
 
+// Adds strings of the column missing in the dictionary in the lexical order. When the
+// dictionary is filled by a single import, its ids follow the order of strings.
+// Throws if ids don't fit elem_size bytes.
+void addSortedDictionaryStrings(StringDictionary* dict,
+                                int elem_size,
+                                std::shared_ptr<arrow::ChunkedArray> arr);
+
 std::shared_ptr<arrow::ChunkedArray> convertArrowDictionary(
     StringDictionary* dict,
     std::shared_ptr<arrow::ChunkedArray> arr,
@@ -47,3 +54,8 @@ std::shared_ptr<arrow::ChunkedArray> convertArrowDictionary(
 
 std::shared_ptr<arrow::ChunkedArray> decodeArrowDictionary(
     std::shared_ptr<arrow::ChunkedArray> arr);
+
+// Converts a fixed size binary column to strings. Chunks without nulls share their
+// values buffer with the result, only offsets are computed.
+std::shared_ptr<arrow::ChunkedArray> convertFixedSizeBinaryToString(
+    std::shared_ptr<arrow::ChunkedArray> arr);
@@ -0,0 +1,547 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "DataGenerator.h"
+
+#include "Shared/ArrowUtil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+namespace tpch_ssb {
+
+namespace {
+
+// SplitMix64 is used instead of standard distributions, which are implementation
+// defined and would make generated data depend on the standard library.
+class Random {
+ public:
+  explicit Random(uint64_t seed) : state_(seed) {}
+
+  uint64_t next() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  // Uniform integer in [min, max].
+  int64_t uniform(int64_t min, int64_t max) {
+    return min + static_cast<int64_t>(next() % static_cast<uint64_t>(max - min + 1));
+  }
+
+  // Uniform real in [0, 1).
+  double real() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+  template <typename T>
+  const T& pick(const std::vector<T>& values) {
+    return values[next() % values.size()];
+  }
+
+ private:
+  uint64_t state_;
+};
+
+// Values in [1, n], value k has probability proportional to 1 / k^skew.
+class ZipfDistribution {
+ public:
+  ZipfDistribution(size_t n, double skew) : cdf_(n) {
+    double sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+      sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+      cdf_[i] = sum;
+    }
+    for (auto& val : cdf_) {
+      val /= sum;
+    }
+  }
+
+  int64_t operator()(Random& rnd) const {
+    auto pos = std::lower_bound(cdf_.begin(), cdf_.end(), rnd.real()) - cdf_.begin();
+    return std::min<int64_t>(pos, cdf_.size() - 1) + 1;
+  }
+
+ private:
+  std::vector<double> cdf_;
+};
+
+// Each table gets its own random stream, so tables don't depend on the generation
+// order and on sizes of each other.
+enum TableSeed : uint64_t {
+  kCustomerSeed = 1,
+  kOrdersSeed,
+  kSupplierSeed,
+  kPartSeed,
+  kLineorderSeed,
+};
+
+Random table_random(const GeneratorOptions& options, TableSeed table) {
+  return Random(options.seed * 1000003 + table);
+}
+
+size_t scaled(size_t base, double scale_factor) {
+  return std::max<size_t>(1, std::llround(base * scale_factor));
+}
+
+int32_t days_from_civil(int year, unsigned month, unsigned day) {
+  year -= month <= 2;
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(year - era * 400);
+  const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int>(doe) - 719468;
+}
+
+struct CivilDate {
+  int year;
+  unsigned month;
+  unsigned day;
+};
+
+CivilDate civil_from_days(int32_t days) {
+  days += 719468;
+  const int era = (days >= 0 ? days : days - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(days - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+  const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+  return {static_cast<int>(yoe) + era * 400 + (month <= 2), month, day};
+}
+
+double round_cents(double val) {
+  return std::round(val * 100) / 100;
+}
+
+// P_RETAILPRICE formula from the TPC-H specification.
+int64_t part_price_cents(int64_t partkey) {
+  return 90000 + (partkey / 10) % 20001 + 100 * (partkey % 1000);
+}
+
+std::string key_name(const char* prefix, int64_t key) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%s#%09ld", prefix, static_cast<long>(key));
+  return buf;
+}
+
+const std::vector<std::string> kRegions = {
+    "AFRICA", "AMERICA", "ASIA", "EUROPE", "MIDDLE EAST"};
+
+const std::vector<std::pair<std::string, int32_t>> kNations = {
+    {"ALGERIA", 0},      {"ARGENTINA", 1},     {"BRAZIL", 1},  {"CANADA", 1},
+    {"EGYPT", 4},        {"ETHIOPIA", 0},      {"FRANCE", 3},  {"GERMANY", 3},
+    {"INDIA", 2},        {"INDONESIA", 2},     {"IRAN", 4},    {"IRAQ", 4},
+    {"JAPAN", 2},        {"JORDAN", 4},        {"KENYA", 0},   {"MOROCCO", 0},
+    {"MOZAMBIQUE", 0},   {"PERU", 1},          {"CHINA", 2},   {"ROMANIA", 3},
+    {"SAUDI ARABIA", 4}, {"VIETNAM", 2},       {"RUSSIA", 3},  {"UNITED KINGDOM", 3},
+    {"UNITED STATES", 1}};
+
+const std::vector<std::string> kSegments = {
+    "AUTOMOBILE", "BUILDING", "FURNITURE", "HOUSEHOLD", "MACHINERY"};
+
+const std::vector<std::string> kPriorities = {
+    "1-URGENT", "2-HIGH", "3-MEDIUM", "4-NOT SPECIFIED", "5-LOW"};
+
+const std::vector<std::string> kShipModes = {
+    "REG AIR", "AIR", "RAIL", "SHIP", "TRUCK", "MAIL", "FOB"};
+
+const int32_t kStartDate = days_from_civil(1992, 1, 1);
+const int32_t kEndDate = days_from_civil(1998, 12, 31);
+// TPC-H orders are placed up to 151 days before the end date.
+const int32_t kLastOrderDate = kEndDate - 151;
+const int32_t kCurrentDate = days_from_civil(1995, 6, 17);
+
+constexpr size_t kTpchParts = 200'000;
+constexpr size_t kTpchSuppliers = 10'000;
+// SSB uses fewer suppliers than TPC-H, lineorder suppliers are skewed.
+constexpr size_t kSsbSuppliers = 2'000;
+constexpr double kSupplierSkew = 1.0;
+
+class TableBuilder {
+ public:
+  template <typename ArrowType>
+  void add(const std::string& name,
+           const std::vector<typename ArrowType::c_type>& values) {
+    arrow::NumericBuilder<ArrowType> builder;
+    ARROW_THROW_NOT_OK(builder.AppendValues(values));
+    finishColumn(name, builder);
+  }
+
+  void add(const std::string& name, const std::vector<std::string>& values) {
+    arrow::StringBuilder builder;
+    ARROW_THROW_NOT_OK(builder.AppendValues(values));
+    finishColumn(name, builder);
+  }
+
+  std::shared_ptr<arrow::Table> finish() {
+    return arrow::Table::Make(arrow::schema(fields_), columns_);
+  }
+
+ private:
+  void finishColumn(const std::string& name, arrow::ArrayBuilder& builder) {
+    std::shared_ptr<arrow::Array> array;
+    ARROW_THROW_NOT_OK(builder.Finish(&array));
+    fields_.push_back(arrow::field(name, array->type()));
+    columns_.push_back(std::move(array));
+  }
+
+  std::vector<std::shared_ptr<arrow::Field>> fields_;
+  std::vector<std::shared_ptr<arrow::Array>> columns_;
+};
+
+std::shared_ptr<arrow::Table> generate_region() {
+  std::vector<int32_t> r_regionkey;
+  for (size_t i = 0; i < kRegions.size(); ++i) {
+    r_regionkey.push_back(i);
+  }
+  TableBuilder builder;
+  builder.add<arrow::Int32Type>("r_regionkey", r_regionkey);
+  builder.add("r_name", kRegions);
+  return builder.finish();
+}
+
+std::shared_ptr<arrow::Table> generate_nation() {
+  std::vector<int32_t> n_nationkey;
+  std::vector<std::string> n_name;
+  std::vector<int32_t> n_regionkey;
+  for (size_t i = 0; i < kNations.size(); ++i) {
+    n_nationkey.push_back(i);
+    n_name.push_back(kNations[i].first);
+    n_regionkey.push_back(kNations[i].second);
+  }
+  TableBuilder builder;
+  builder.add<arrow::Int32Type>("n_nationkey", n_nationkey);
+  builder.add("n_name", n_name);
+  builder.add<arrow::Int32Type>("n_regionkey", n_regionkey);
+  return builder.finish();
+}
+
+std::shared_ptr<arrow::Table> generate_customer(const GeneratorOptions& options) {
+  auto rnd = table_random(options, kCustomerSeed);
+  const size_t rows = scaled(150'000, options.scale_factor);
+  std::vector<int32_t> c_custkey(rows);
+  std::vector<std::string> c_name(rows);
+  std::vector<int32_t> c_nationkey(rows);
+  std::vector<double> c_acctbal(rows);
+  std::vector<std::string> c_mktsegment(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    c_custkey[i] = i + 1;
+    c_name[i] = key_name("Customer", i + 1);
+    c_nationkey[i] = rnd.uniform(0, kNations.size() - 1);
+    c_acctbal[i] = rnd.uniform(-99999, 999999) / 100.0;
+    c_mktsegment[i] = rnd.pick(kSegments);
+  }
+  TableBuilder builder;
+  builder.add<arrow::Int32Type>("c_custkey", c_custkey);
+  builder.add("c_name", c_name);
+  builder.add<arrow::Int32Type>("c_nationkey", c_nationkey);
+  builder.add<arrow::DoubleType>("c_acctbal", c_acctbal);
+  builder.add("c_mktsegment", c_mktsegment);
+  return builder.finish();
+}
+
+void generate_orders_and_lineitem(const GeneratorOptions& options,
+                                  GeneratedTables& tables) {
+  auto rnd = table_random(options, kOrdersSeed);
+  const size_t orders = scaled(1'500'000, options.scale_factor);
+  const size_t customers = scaled(150'000, options.scale_factor);
+  const size_t parts = scaled(kTpchParts, options.scale_factor);
+  const size_t suppliers = scaled(kTpchSuppliers, options.scale_factor);
+
+  std::vector<int64_t> o_orderkey(orders);
+  std::vector<int32_t> o_custkey(orders);
+  std::vector<std::string> o_orderstatus(orders);
+  std::vector<double> o_totalprice(orders);
+  std::vector<int32_t> o_orderdate(orders);
+  std::vector<std::string> o_orderpriority(orders);
+
+  std::vector<int64_t> l_orderkey;
+  std::vector<int32_t> l_partkey;
+  std::vector<int32_t> l_suppkey;
+  std::vector<int32_t> l_linenumber;
+  std::vector<double> l_quantity;
+  std::vector<double> l_extendedprice;
+  std::vector<double> l_discount;
+  std::vector<double> l_tax;
+  std::vector<std::string> l_returnflag;
+  std::vector<std::string> l_linestatus;
+  std::vector<int32_t> l_shipdate;
+  std::vector<std::string> l_shipmode;
+
+  for (size_t i = 0; i < orders; ++i) {
+    const int64_t orderkey = i + 1;
+    const int32_t orderdate = rnd.uniform(kStartDate, kLastOrderDate);
+    const int32_t lines = rnd.uniform(1, 7);
+    double totalprice = 0;
+    int32_t shipped_lines = 0;
+    for (int32_t line = 1; line <= lines; ++line) {
+      const int64_t partkey = rnd.uniform(1, parts);
+      const int64_t quantity = rnd.uniform(1, 50);
+      const double extendedprice =
+          round_cents(quantity * part_price_cents(partkey) / 100.0);
+      const double discount = rnd.uniform(0, 10) / 100.0;
+      const double tax = rnd.uniform(0, 8) / 100.0;
+      const int32_t shipdate = orderdate + rnd.uniform(1, 121);
+      const int32_t receiptdate = shipdate + rnd.uniform(1, 30);
+      const bool shipped = shipdate <= kCurrentDate;
+
+      l_orderkey.push_back(orderkey);
+      l_partkey.push_back(partkey);
+      l_suppkey.push_back(rnd.uniform(1, suppliers));
+      l_linenumber.push_back(line);
+      l_quantity.push_back(quantity);
+      l_extendedprice.push_back(extendedprice);
+      l_discount.push_back(discount);
+      l_tax.push_back(tax);
+      l_returnflag.push_back(receiptdate <= kCurrentDate ? (rnd.uniform(0, 1) ? "R" : "A")
+                                                         : "N");
+      l_linestatus.push_back(shipped ? "F" : "O");
+      l_shipdate.push_back(shipdate);
+      l_shipmode.push_back(rnd.pick(kShipModes));
+
+      totalprice += extendedprice * (1 + tax) * (1 - discount);
+      shipped_lines += shipped;
+    }
+    o_orderkey[i] = orderkey;
+    o_custkey[i] = rnd.uniform(1, customers);
+    o_orderstatus[i] = shipped_lines == lines ? "F" : (shipped_lines ? "P" : "O");
+    o_totalprice[i] = round_cents(totalprice);
+    o_orderdate[i] = orderdate;
+    o_orderpriority[i] = rnd.pick(kPriorities);
+  }
+
+  TableBuilder orders_builder;
+  orders_builder.add<arrow::Int64Type>("o_orderkey", o_orderkey);
+  orders_builder.add<arrow::Int32Type>("o_custkey", o_custkey);
+  orders_builder.add("o_orderstatus", o_orderstatus);
+  orders_builder.add<arrow::DoubleType>("o_totalprice", o_totalprice);
+  orders_builder.add<arrow::Date32Type>("o_orderdate", o_orderdate);
+  orders_builder.add("o_orderpriority", o_orderpriority);
+  tables["orders"] = orders_builder.finish();
+
+  TableBuilder lineitem_builder;
+  lineitem_builder.add<arrow::Int64Type>("l_orderkey", l_orderkey);
+  lineitem_builder.add<arrow::Int32Type>("l_partkey", l_partkey);
+  lineitem_builder.add<arrow::Int32Type>("l_suppkey", l_suppkey);
+  lineitem_builder.add<arrow::Int32Type>("l_linenumber", l_linenumber);
+  lineitem_builder.add<arrow::DoubleType>("l_quantity", l_quantity);
+  lineitem_builder.add<arrow::DoubleType>("l_extendedprice", l_extendedprice);
+  lineitem_builder.add<arrow::DoubleType>("l_discount", l_discount);
+  lineitem_builder.add<arrow::DoubleType>("l_tax", l_tax);
+  lineitem_builder.add("l_returnflag", l_returnflag);
+  lineitem_builder.add("l_linestatus", l_linestatus);
+  lineitem_builder.add<arrow::Date32Type>("l_shipdate", l_shipdate);
+  lineitem_builder.add("l_shipmode", l_shipmode);
+  tables["lineitem"] = lineitem_builder.finish();
+}
+
+int32_t date_key(int32_t days) {
+  auto date = civil_from_days(days);
+  return date.year * 10000 + date.month * 100 + date.day;
+}
+
+std::shared_ptr<arrow::Table> generate_dates() {
+  std::vector<int32_t> d_datekey;
+  std::vector<int32_t> d_date;
+  std::vector<int32_t> d_year;
+  std::vector<int32_t> d_yearmonthnum;
+  std::vector<int32_t> d_weeknuminyear;
+  for (int32_t days = kStartDate; days <= kEndDate; ++days) {
+    auto date = civil_from_days(days);
+    d_datekey.push_back(date_key(days));
+    d_date.push_back(days);
+    d_year.push_back(date.year);
+    d_yearmonthnum.push_back(date.year * 100 + date.month);
+    d_weeknuminyear.push_back((days - days_from_civil(date.year, 1, 1)) / 7 + 1);
+  }
+  TableBuilder builder;
+  builder.add<arrow::Int32Type>("d_datekey", d_datekey);
+  builder.add<arrow::Date32Type>("d_date", d_date);
+  builder.add<arrow::Int32Type>("d_year", d_year);
+  builder.add<arrow::Int32Type>("d_yearmonthnum", d_yearmonthnum);
+  builder.add<arrow::Int32Type>("d_weeknuminyear", d_weeknuminyear);
+  return builder.finish();
+}
+
+std::shared_ptr<arrow::Table> generate_supplier(const GeneratorOptions& options) {
+  auto rnd = table_random(options, kSupplierSeed);
+  const size_t rows = scaled(kSsbSuppliers, options.scale_factor);
+  std::vector<int32_t> s_suppkey(rows);
+  std::vector<std::string> s_name(rows);
+  std::vector<std::string> s_city(rows);
+  std::vector<std::string> s_nation(rows);
+  std::vector<std::string> s_region(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    auto& nation = kNations[rnd.uniform(0, kNations.size() - 1)];
+    s_suppkey[i] = i + 1;
+    s_name[i] = key_name("Supplier", i + 1);
+    // SSB city is the nation name truncated or padded to 9 chars plus a digit.
+    s_city[i] = nation.first.substr(0, 9);
+    s_city[i].resize(9, ' ');
+    s_city[i] += static_cast<char>('0' + rnd.uniform(0, 9));
+    s_nation[i] = nation.first;
+    s_region[i] = kRegions[nation.second];
+  }
+  TableBuilder builder;
+  builder.add<arrow::Int32Type>("s_suppkey", s_suppkey);
+  builder.add("s_name", s_name);
+  builder.add("s_city", s_city);
+  builder.add("s_nation", s_nation);
+  builder.add("s_region", s_region);
+  return builder.finish();
+}
+
+std::shared_ptr<arrow::Table> generate_part(const GeneratorOptions& options) {
+  auto rnd = table_random(options, kPartSeed);
+  const size_t rows = scaled(kTpchParts, options.scale_factor);
+  std::vector<int32_t> p_partkey(rows);
+  std::vector<std::string> p_mfgr(rows);
+  std::vector<std::string> p_category(rows);
+  std::vector<std::string> p_brand1(rows);
+  std::vector<int32_t> p_size(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    p_partkey[i] = i + 1;
+    p_mfgr[i] = "MFGR#" + std::to_string(rnd.uniform(1, 5));
+    p_category[i] = p_mfgr[i] + std::to_string(rnd.uniform(1, 5));
+    p_brand1[i] = p_category[i] + std::to_string(rnd.uniform(1, 40));
+    p_size[i] = rnd.uniform(1, 50);
+  }
+  TableBuilder builder;
+  builder.add<arrow::Int32Type>("p_partkey", p_partkey);
+  builder.add("p_mfgr", p_mfgr);
+  builder.add("p_category", p_category);
+  builder.add("p_brand1", p_brand1);
+  builder.add<arrow::Int32Type>("p_size", p_size);
+  return builder.finish();
+}
+
+std::shared_ptr<arrow::Table> generate_lineorder(const GeneratorOptions& options) {
+  auto rnd = table_random(options, kLineorderSeed);
+  const size_t rows = scaled(6'000'000, options.scale_factor);
+  const size_t customers = scaled(150'000, options.scale_factor);
+  const size_t parts = scaled(kTpchParts, options.scale_factor);
+  const ZipfDistribution suppliers(scaled(kSsbSuppliers, options.scale_factor),
+                                   kSupplierSkew);
+
+  std::vector<int64_t> lo_orderkey(rows);
+  std::vector<int32_t> lo_linenumber(rows);
+  std::vector<int32_t> lo_custkey(rows);
+  std::vector<int32_t> lo_partkey(rows);
+  std::vector<int32_t> lo_suppkey(rows);
+  std::vector<int32_t> lo_orderdate(rows);
+  std::vector<int32_t> lo_quantity(rows);
+  std::vector<int64_t> lo_extendedprice(rows);
+  std::vector<int32_t> lo_discount(rows);
+  std::vector<int64_t> lo_revenue(rows);
+  std::vector<int64_t> lo_supplycost(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    const int64_t partkey = rnd.uniform(1, parts);
+    const int64_t price = part_price_cents(partkey);
+    lo_orderkey[i] = i / 4 + 1;
+    lo_linenumber[i] = i % 4 + 1;
+    lo_custkey[i] = rnd.uniform(1, customers);
+    lo_partkey[i] = partkey;
+    lo_suppkey[i] = suppliers(rnd);
+    lo_orderdate[i] = date_key(rnd.uniform(kStartDate, kLastOrderDate));
+    lo_quantity[i] = rnd.uniform(1, 50);
+    lo_extendedprice[i] = lo_quantity[i] * price;
+    lo_discount[i] = rnd.uniform(0, 10);
+    lo_revenue[i] = lo_extendedprice[i] * (100 - lo_discount[i]) / 100;
+    lo_supplycost[i] = price * 6 / 10;
+  }
+  TableBuilder builder;
+  builder.add<arrow::Int64Type>("lo_orderkey", lo_orderkey);
+  builder.add<arrow::Int32Type>("lo_linenumber", lo_linenumber);
+  builder.add<arrow::Int32Type>("lo_custkey", lo_custkey);
+  builder.add<arrow::Int32Type>("lo_partkey", lo_partkey);
+  builder.add<arrow::Int32Type>("lo_suppkey", lo_suppkey);
+  builder.add<arrow::Int32Type>("lo_orderdate", lo_orderdate);
+  builder.add<arrow::Int32Type>("lo_quantity", lo_quantity);
+  builder.add<arrow::Int64Type>("lo_extendedprice", lo_extendedprice);
+  builder.add<arrow::Int32Type>("lo_discount", lo_discount);
+  builder.add<arrow::Int64Type>("lo_revenue", lo_revenue);
+  builder.add<arrow::Int64Type>("lo_supplycost", lo_supplycost);
+  return builder.finish();
+}
+
+void append_csv_value(std::string& out, const arrow::Array& array, int64_t row) {
+  char buf[32];
+  switch (array.type_id()) {
+    case arrow::Type::INT32:
+      out += std::to_string(static_cast<const arrow::Int32Array&>(array).Value(row));
+      break;
+    case arrow::Type::INT64:
+      out += std::to_string(static_cast<const arrow::Int64Array&>(array).Value(row));
+      break;
+    case arrow::Type::DOUBLE:
+      snprintf(buf,
+               sizeof(buf),
+               "%.2f",
+               static_cast<const arrow::DoubleArray&>(array).Value(row));
+      out += buf;
+      break;
+    case arrow::Type::DATE32: {
+      auto days = static_cast<const arrow::Date32Array&>(array).Value(row);
+      auto date = civil_from_days(days);
+      snprintf(buf, sizeof(buf), "%04d-%02u-%02u", date.year, date.month, date.day);
+      out += buf;
+    } break;
+    case arrow::Type::STRING: {
+      auto view = static_cast<const arrow::StringArray&>(array).GetView(row);
+      out.append(view.data(), view.size());
+    } break;
+    default:
+      throw std::runtime_error("Unsupported CSV column type: " +
+                               array.type()->ToString());
+  }
+}
+
+}  // namespace
+
+GeneratedTables generateTpch(const GeneratorOptions& options) {
+  GeneratedTables tables;
+  tables["region"] = generate_region();
+  tables["nation"] = generate_nation();
+  tables["customer"] = generate_customer(options);
+  generate_orders_and_lineitem(options, tables);
+  return tables;
+}
+
+GeneratedTables generateSsb(const GeneratorOptions& options) {
+  GeneratedTables tables;
+  tables["dates"] = generate_dates();
+  tables["supplier"] = generate_supplier(options);
+  tables["part"] = generate_part(options);
+  tables["lineorder"] = generate_lineorder(options);
+  return tables;
+}
+
+std::string toCsv(const arrow::Table& table) {
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (auto& column : table.columns()) {
+    if (column->num_chunks() != 1) {
+      throw std::runtime_error("Only single chunk columns can be written to CSV.");
+    }
+    columns.push_back(column->chunk(0));
+  }
+  std::string res;
+  for (int64_t row = 0; row < table.num_rows(); ++row) {
+    for (size_t col = 0; col < columns.size(); ++col) {
+      if (col) {
+        res += ',';
+      }
+      append_csv_value(res, *columns[col], row);
+    }
+    res += '\n';
+  }
+  return res;
+}
+
+}  // namespace tpch_ssb
@@ -0,0 +1,55 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file    DataGenerator.h
+ * @brief   Deterministic in-process generators of TPC-H and SSB like tables.
+ *
+ * Schemas follow TPC-H and Star Schema Benchmark closely enough to run their
+ * typical query shapes, but value distributions are simplified and the output is
+ * not a valid TPC-H or SSB data set. Generated tables depend only on the scale
+ * factor and the seed, so results are comparable across runs and platforms.
+ *
+ * Table sizes for scale factor SF:
+ *   region: 5, nation: 25, customer: 150K * SF, orders: 1.5M * SF,
+ *   lineitem: ~6M * SF, dates: 2557, supplier: 2K * SF, part: 200K * SF,
+ *   lineorder: 6M * SF.
+ *
+ * SSB tables share the customer table with TPC-H ones. lineorder.lo_suppkey
+ * follows Zipf distribution to model skewed keys, other keys are uniform.
+ * Floating point values are rounded to cents.
+ */
+
+#pragma once
+
+#include <arrow/api.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace tpch_ssb {
+
+struct GeneratorOptions {
+  double scale_factor{0.1};
+  uint64_t seed{42};
+};
+
+using GeneratedTables = std::map<std::string, std::shared_ptr<arrow::Table>>;
+
+// region, nation, customer, orders and lineitem.
+GeneratedTables generateTpch(const GeneratorOptions& options);
+
+// dates, supplier, part and lineorder. lineorder.lo_custkey references the
+// customer table generated by generateTpch with the same options.
+GeneratedTables generateSsb(const GeneratorOptions& options);
+
+// Format the table as CSV without a header. Supports int32, int64, double,
+// date32 and string columns.
+std::string toCsv(const arrow::Table& table);
+
+}  // namespace tpch_ssb
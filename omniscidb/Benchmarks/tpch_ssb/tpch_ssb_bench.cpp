@@ -0,0 +1,254 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "DataGenerator.h"
+#include "Tests/ArrowSQLRunner/ArrowSQLRunner.h"
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using namespace TestHelpers::ArrowSQLRunner;
+
+tpch_ssb::GeneratorOptions g_generator_options;
+size_t g_fragment_size = 1'000'000;
+ExecutorDeviceType g_device_type{ExecutorDeviceType::CPU};
+tpch_ssb::GeneratedTables g_tables;
+
+std::istream& operator>>(std::istream& in, ExecutorDeviceType& device_type) {
+  std::string token;
+  in >> token;
+  if (token == "CPU") {
+    device_type = ExecutorDeviceType::CPU;
+  } else if (token == "GPU") {
+    device_type = ExecutorDeviceType::GPU;
+  } else {
+    throw std::runtime_error("Invalid device type: " + token);
+  }
+  return in;
+}
+
+struct QueryBenchmark {
+  const char* name;
+  // The largest table scanned by the query, its size is used to report throughput.
+  const char* fact_table;
+  const char* sql;
+};
+
+// clang-format off
+const std::vector<QueryBenchmark> kQueries = {
+    {"scan_count", "lineitem",
+     "SELECT COUNT(*) FROM lineitem;"},
+    {"scan_sum", "lineitem",
+     "SELECT SUM(l_extendedprice), SUM(l_quantity) FROM lineitem;"},
+    {"filter_numeric", "lineitem",
+     "SELECT SUM(l_extendedprice * l_discount) AS revenue FROM lineitem "
+     "WHERE l_shipdate >= DATE '1994-01-01' AND l_shipdate < DATE '1995-01-01' "
+     "AND l_discount BETWEEN 0.05 AND 0.07 AND l_quantity < 24;"},
+    {"filter_string", "lineitem",
+     "SELECT COUNT(*) FROM lineitem WHERE l_shipmode = 'AIR' AND l_returnflag = 'R';"},
+    {"groupby_low_cardinality", "lineitem",
+     "SELECT l_returnflag, l_linestatus, SUM(l_quantity), SUM(l_extendedprice), "
+     "SUM(l_extendedprice * (1 - l_discount)), "
+     "SUM(l_extendedprice * (1 - l_discount) * (1 + l_tax)), AVG(l_quantity), "
+     "AVG(l_extendedprice), AVG(l_discount), COUNT(*) FROM lineitem "
+     "WHERE l_shipdate <= DATE '1998-09-02' GROUP BY l_returnflag, l_linestatus "
+     "ORDER BY l_returnflag, l_linestatus;"},
+    {"groupby_high_cardinality", "lineitem",
+     "SELECT l_orderkey, SUM(l_quantity), COUNT(*) FROM lineitem GROUP BY l_orderkey;"},
+    {"groupby_skewed", "lineorder",
+     "SELECT lo_suppkey, SUM(lo_revenue), COUNT(*) FROM lineorder GROUP BY lo_suppkey;"},
+    {"join_customer_orders_lineitem", "lineitem",
+     "SELECT l_orderkey, SUM(l_extendedprice * (1 - l_discount)) AS revenue, "
+     "o_orderdate, o_orderpriority FROM customer, orders, lineitem "
+     "WHERE c_mktsegment = 'BUILDING' AND c_custkey = o_custkey "
+     "AND l_orderkey = o_orderkey AND o_orderdate < DATE '1995-03-15' "
+     "AND l_shipdate > DATE '1995-03-15' "
+     "GROUP BY l_orderkey, o_orderdate, o_orderpriority "
+     "ORDER BY revenue DESC, o_orderdate LIMIT 10;"},
+    {"join_five_tables", "lineitem",
+     "SELECT n_name, SUM(l_extendedprice * (1 - l_discount)) AS revenue "
+     "FROM customer, orders, lineitem, nation, region "
+     "WHERE c_custkey = o_custkey AND l_orderkey = o_orderkey "
+     "AND c_nationkey = n_nationkey AND n_regionkey = r_regionkey "
+     "AND r_name = 'ASIA' AND o_orderdate >= DATE '1994-01-01' "
+     "AND o_orderdate < DATE '1995-01-01' GROUP BY n_name ORDER BY revenue DESC;"},
+    {"ssb_q1_1", "lineorder",
+     "SELECT SUM(lo_extendedprice * lo_discount) AS revenue FROM lineorder, dates "
+     "WHERE lo_orderdate = d_datekey AND d_year = 1993 "
+     "AND lo_discount BETWEEN 1 AND 3 AND lo_quantity < 25;"},
+    {"ssb_q2_1", "lineorder",
+     "SELECT SUM(lo_revenue), d_year, p_brand1 FROM lineorder, dates, part, supplier "
+     "WHERE lo_orderdate = d_datekey AND lo_partkey = p_partkey "
+     "AND lo_suppkey = s_suppkey AND p_category = 'MFGR#12' "
+     "AND s_region = 'AMERICA' GROUP BY d_year, p_brand1 ORDER BY d_year, p_brand1;"},
+    {"window_row_number", "orders",
+     "SELECT o_custkey, o_orderdate, ROW_NUMBER() OVER (PARTITION BY o_custkey "
+     "ORDER BY o_orderdate) AS rn FROM orders;"},
+    {"window_running_sum", "orders",
+     "SELECT o_custkey, o_orderdate, SUM(o_totalprice) OVER (PARTITION BY o_custkey "
+     "ORDER BY o_orderdate) AS running_total FROM orders;"},
+    {"sort_top_k", "orders",
+     "SELECT o_orderkey, o_totalprice FROM orders "
+     "ORDER BY o_totalprice DESC LIMIT 100;"},
+    {"sort_full", "orders",
+     "SELECT o_orderkey, o_orderdate FROM orders ORDER BY o_orderdate, o_orderkey;"},
+};
+// clang-format on
+
+static void loadTables() {
+  auto start = std::chrono::steady_clock::now();
+  g_tables = tpch_ssb::generateTpch(g_generator_options);
+  g_tables.merge(tpch_ssb::generateSsb(g_generator_options));
+  auto generated = std::chrono::steady_clock::now();
+
+  ArrowStorage::TableOptions options{g_fragment_size};
+  for (auto& [name, table] : g_tables) {
+    getStorage()->importArrowTable(table, name, options);
+    std::cerr << "Table " << name << ": " << table->num_rows() << " rows" << std::endl;
+  }
+  auto loaded = std::chrono::steady_clock::now();
+
+  using std::chrono::milliseconds;
+  std::cerr << "Generated in "
+            << std::chrono::duration_cast<milliseconds>(generated - start).count()
+            << " ms, imported in "
+            << std::chrono::duration_cast<milliseconds>(loaded - generated).count()
+            << " ms" << std::endl;
+}
+
+static void runQuery(benchmark::State& state, const QueryBenchmark& query) {
+  // Warm up the code cache and the buffer pool, so iterations measure execution
+  // only.
+  run_multiple_agg(query.sql, g_device_type);
+  for (auto _ : state) {
+    run_multiple_agg(query.sql, g_device_type);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          g_tables.at(query.fact_table)->num_rows());
+}
+
+constexpr const char* kImportTable = "lineitem_import";
+
+static void import_arrow(benchmark::State& state) {
+  auto& lineitem = g_tables.at("lineitem");
+  for (auto _ : state) {
+    getStorage()->importArrowTable(
+        lineitem, kImportTable, ArrowStorage::TableOptions{g_fragment_size});
+    state.PauseTiming();
+    getStorage()->dropTable(kImportTable);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * lineitem->num_rows());
+}
+
+static void import_csv(benchmark::State& state) {
+  auto& lineitem = g_tables.at("lineitem");
+  const auto csv = tpch_ssb::toCsv(*lineitem);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Import an empty slice to create the table with the lineitem schema.
+    getStorage()->importArrowTable(lineitem->Slice(0, 0),
+                                   kImportTable,
+                                   ArrowStorage::TableOptions{g_fragment_size});
+    state.ResumeTiming();
+    getStorage()->appendCsvData(csv, kImportTable, parse_options);
+    state.PauseTiming();
+    getStorage()->dropTable(kImportTable);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * lineitem->num_rows());
+  state.SetBytesProcessed(state.iterations() * csv.size());
+}
+
+static void registerBenchmarks() {
+  for (auto& query : kQueries) {
+    benchmark::RegisterBenchmark(query.name,
+                                 [&query](benchmark::State& state) {
+                                   runQuery(state, query);
+                                 })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+  }
+  // Import doesn't depend on the query device.
+  if (g_device_type == ExecutorDeviceType::CPU) {
+    benchmark::RegisterBenchmark("import_arrow", import_arrow)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+    benchmark::RegisterBenchmark("import_csv", import_csv)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::benchmark::Initialize(&argc, argv);
+
+  namespace po = boost::program_options;
+
+  auto config = std::make_shared<Config>();
+
+  po::options_description desc("Options");
+  desc.add_options()("help,h", "Print help messages.");
+  desc.add_options()("scale-factor",
+                     po::value<double>(&g_generator_options.scale_factor)
+                         ->default_value(g_generator_options.scale_factor),
+                     "Scale factor of generated tables, 1 means ~6M rows in lineitem.");
+  desc.add_options()(
+      "seed",
+      po::value<uint64_t>(&g_generator_options.seed)
+          ->default_value(g_generator_options.seed),
+      "Seed of the data generator, the same seed always produces the same data.");
+  desc.add_options()("fragment-size",
+                     po::value<size_t>(&g_fragment_size)->default_value(g_fragment_size),
+                     "Table fragment size.");
+  desc.add_options()("device",
+                     po::value<ExecutorDeviceType>(&g_device_type)
+                         ->implicit_value(ExecutorDeviceType::GPU)
+                         ->default_value(ExecutorDeviceType::CPU),
+                     "Device type to use.");
+
+  logger::LogOptions log_options(argv[0]);
+  log_options.severity_ = logger::Severity::FATAL;
+  log_options.set_options();  // update default values
+  desc.add(log_options.get_options());
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(desc).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    std::cout << "Usage:" << std::endl << desc << std::endl;
+    return 0;
+  }
+
+  logger::init(log_options);
+  init(config);
+
+  // Parameters are stored in the context section of the JSON output, so results
+  // of different runs can be matched.
+  benchmark::AddCustomContext("scale_factor",
+                              std::to_string(g_generator_options.scale_factor));
+  benchmark::AddCustomContext("seed", std::to_string(g_generator_options.seed));
+  benchmark::AddCustomContext("fragment_size", std::to_string(g_fragment_size));
+  benchmark::AddCustomContext("device", deviceToString(g_device_type));
+
+  try {
+    loadTables();
+    registerBenchmarks();
+    ::benchmark::RunSpecifiedBenchmarks();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+    return -1;
+  }
+
+  reset();
+}
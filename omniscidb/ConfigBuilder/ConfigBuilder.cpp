@@ -216,6 +216,79 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(config_->exec.group_by.partitioning_buffer_target_size),
       "A preferred aggregation output buffer size used to compute number of partitions "
       "to use.");
+  opt_desc.add_options()(
+      "enable-adaptive-groupby",
+      po::value<bool>(&config_->exec.group_by.enable_adaptive_groupby)
+          ->default_value(config_->exec.group_by.enable_adaptive_groupby)
+          ->implicit_value(true),
+      "Retry group-by steps which ran out of output buffer slots with a grown buffer "
+      "instead of failing the query. Observed group counts of retried steps are fed "
+      "back into the cardinality cache.");
+  opt_desc.add_options()(
+      "enable-skew-aware-partitioning",
+      po::value<bool>(&config_->exec.group_by.enable_skew_aware_partitioning)
+          ->default_value(config_->exec.group_by.enable_skew_aware_partitioning)
+          ->implicit_value(true),
+      "Take per-thread output buffer copies into account when choosing partitioned "
+      "aggregation. With --enable-adaptive-groupby, also use NDV estimation to size "
+      "buffers of skewed partitions.");
+  opt_desc.add_options()(
+      "groupby-partitioning-skew-threshold",
+      po::value<double>(&config_->exec.group_by.partitioning_skew_threshold)
+          ->default_value(config_->exec.group_by.partitioning_skew_threshold),
+      "A ratio of the biggest partition size to the average one starting from which "
+      "partitions are considered skewed.");
+  opt_desc.add_options()(
+      "enable-tree-reduction",
+      po::value<bool>(&config_->exec.group_by.enable_tree_reduction)
+          ->default_value(config_->exec.group_by.enable_tree_reduction)
+          ->implicit_value(true),
+      "Reduce baseline hash group-by results pairwise in parallel instead of folding "
+      "them into a single result set.");
+  opt_desc.add_options()(
+      "tree-reduction-threshold",
+      po::value<size_t>(&config_->exec.group_by.tree_reduction_threshold)
+          ->default_value(config_->exec.group_by.tree_reduction_threshold),
+      "A minimal number of baseline hash group-by results to use tree reduction.");
+  opt_desc.add_options()(
+      "enable-roaring-count-distinct",
+      po::value<bool>(&config_->exec.group_by.enable_roaring_count_distinct)
+          ->default_value(config_->exec.group_by.enable_roaring_count_distinct)
+          ->implicit_value(true),
+      "Use compressed roaring sets for exact COUNT(DISTINCT) on integers when "
+      "bitmaps would be too large or a hash set would be used otherwise.");
+  opt_desc.add_options()(
+      "roaring-count-distinct-min-density",
+      po::value<double>(&config_->exec.group_by.roaring_count_distinct_min_density)
+          ->default_value(config_->exec.group_by.roaring_count_distinct_min_density),
+      "A minimal expected number of distinct values per 64K-wide range chunk to "
+      "prefer roaring sets over hash sets for COUNT(DISTINCT).");
+  opt_desc.add_options()(
+      "roaring-count-distinct-bitmap-threshold",
+      po::value<size_t>(&config_->exec.group_by.roaring_count_distinct_bitmap_threshold)
+          ->default_value(config_->exec.group_by.roaring_count_distinct_bitmap_threshold),
+      "A minimal total size of COUNT(DISTINCT) bitmaps (in bytes) to consider "
+      "replacing sparse bitmaps with roaring sets.");
+  opt_desc.add_options()(
+      "enable-sparse-hll",
+      po::value<bool>(&config_->exec.group_by.enable_sparse_hll)
+          ->default_value(config_->exec.group_by.enable_sparse_hll)
+          ->implicit_value(true),
+      "Start APPROX_COUNT_DISTINCT sketches in a sparse representation for group-by "
+      "queries on CPU.");
+  opt_desc.add_options()(
+      "sparse-hll-groups-threshold",
+      po::value<size_t>(&config_->exec.group_by.sparse_hll_groups_threshold)
+          ->default_value(config_->exec.group_by.sparse_hll_groups_threshold),
+      "A minimal number of group-by buffer entries to use sparse APPROX_COUNT_DISTINCT "
+      "sketches.");
+  opt_desc.add_options()(
+      "enable-partitioned-top-n",
+      po::value<bool>(&config_->exec.group_by.enable_partitioned_top_n)
+          ->default_value(config_->exec.group_by.enable_partitioned_top_n)
+          ->implicit_value(true),
+      "Drop rows not fitting ORDER BY ... LIMIT of their partition before merging "
+      "partitioned aggregation results.");
 
   // exec.window
   opt_desc.add_options()("enable-window-functions",
@@ -358,6 +431,17 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(config_->exec.parallel_top_min),
       "For ResultSets requiring a heap sort, the number of rows necessary to trigger "
       "parallelTop() to sort.");
+  opt_desc.add_options()(
+      "enable-radix-sort",
+      po::value<bool>(&config_->exec.enable_radix_sort)
+          ->default_value(config_->exec.enable_radix_sort)
+          ->implicit_value(true),
+      "Use parallel radix sort for full single-column sorts of projection results on "
+      "CPU.");
+  opt_desc.add_options()("radix-sort-min",
+                         po::value<size_t>(&config_->exec.radix_sort_min)
+                             ->default_value(config_->exec.radix_sort_min),
+                         "The number of rows necessary to use parallel radix sort.");
   opt_desc.add_options()(
       "enable-experimental-string-functions",
       po::value<bool>(&config_->exec.enable_experimental_string_functions)
@@ -626,6 +710,26 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(config_->debug.enable_gpu_code_compilation_cache)
           ->implicit_value(true),
       "Enable GPU compilation code caching.");
+  opt_desc.add_options()(
+      "enable-query-trace",
+      po::value<bool>(&config_->debug.enable_query_trace)
+          ->default_value(config_->debug.enable_query_trace)
+          ->implicit_value(true),
+      "Write a timeline of each executed query in the Chrome trace event format. Trace "
+      "files can be opened in chrome://tracing or ui.perfetto.dev.");
+  opt_desc.add_options()("query-trace-dir",
+                         po::value<std::string>(&config_->debug.query_trace_dir)
+                             ->default_value(config_->debug.query_trace_dir),
+                         "Directory for query trace files. Log directory is used "
+                         "by default.");
+  opt_desc.add_options()(
+      "enable-perf-counters",
+      po::value<bool>(&config_->debug.enable_perf_counters)
+          ->default_value(config_->debug.enable_perf_counters)
+          ->implicit_value(true),
+      "Collect hardware performance counters (cycles, instructions, LLC misses, "
+      "branch misses) for kernels and hash table builds in EXPLAIN ANALYZE profiles. "
+      "Requires perf events to be allowed by the kernel.");
 
   // storage
   opt_desc.add_options()(
@@ -643,6 +747,30 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       "processing on import as we might require. This might increase overall execution "
       "time. This option can be used to split data import and execution for performance "
       "measurements.");
+  opt_desc.add_options()(
+      "share-dicts-by-column-name",
+      po::value<bool>(&config_->storage.share_dicts_by_column_name)
+          ->default_value(config_->storage.share_dicts_by_column_name)
+          ->implicit_value(true),
+      "Use a single string dictionary for all imported dictionary encoded columns "
+      "with the same name in Arrow Storage. Strings shared by such columns are stored "
+      "once and joins between them need no dictionary translation.");
+  opt_desc.add_options()(
+      "enable-sorted-dict-import",
+      po::value<bool>(&config_->storage.enable_sorted_dict_import)
+          ->default_value(config_->storage.enable_sorted_dict_import)
+          ->implicit_value(true),
+      "Add imported strings to string dictionaries in the lexical order. Dictionaries "
+      "filled by a single import then have ids following the order of strings, so "
+      "string range predicates and sorts work on ids.");
+  opt_desc.add_options()(
+      "background-dict-materialization-threads",
+      po::value<size_t>(&config_->storage.background_dict_materialization_threads)
+          ->default_value(config_->storage.background_dict_materialization_threads),
+      "Number of threads used to materialize lazy string dictionaries in background "
+      "right after data import. Queries wait only for dictionaries they use. Zero "
+      "disables background materialization. Used with lazy dictionary "
+      "materialization only.");
 
   // external
   opt_desc.add_options()("enable-debug-timer",
@@ -27,6 +27,7 @@
 
 #include "DataMgr/BufferMgr/Buffer.h"
 #include "Logger/Logger.h"
+#include "Shared/Metrics.h"
 #include "Shared/measure.h"
 #include "Shared/scope.h"
 
@@ -175,9 +176,13 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
   auto evict_it = evict_start;
   size_t num_pages = 0;
   size_t start_page = evict_start->start_page;
+  size_t evicted_buffers = 0;
+  size_t evicted_pages = 0;
   while (num_pages < num_pages_requested) {
     if (evict_it->mem_status == USED) {
       CHECK(evict_it->buffer->getPinCount() < 1);
+      ++evicted_buffers;
+      evicted_pages += evict_it->num_pages;
     }
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
@@ -192,6 +197,19 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
         evict_it);  // erase operations returns next iterator - safe if we ever move
                     // to a vector (as opposed to erase(evict_it++)
   }
+  if (evicted_buffers) {
+    const metrics::Labels labels{{"level", getMgrType() == GPU_MGR ? "GPU" : "CPU"}};
+    metrics::registry()
+        .counter("hdk_buffer_pool_evicted_buffers_total",
+                 "Buffers evicted from buffer pools.",
+                 labels)
+        .inc(evicted_buffers);
+    metrics::registry()
+        .counter("hdk_buffer_pool_evicted_bytes_total",
+                 "Size of buffers evicted from buffer pools.",
+                 labels)
+        .inc(evicted_pages * page_size_);
+  }
   BufferSeg data_seg(
       start_page, num_pages_requested, USED, buffer_epoch_++);  // until we can
   // data_seg.pinCount++;
@@ -60,9 +60,12 @@ DataMgr::DataMgr(const Config& config, const size_t numReaderThreads)
     , data_provider_(std::make_unique<DataMgrDataProvider>(this)) {
   populateDeviceMgrs(config);
   populateMgrs(config, numReaderThreads);
+  metrics_collector_id_ = metrics::registry().addCollector(
+      [this](metrics::Registry& registry) { collectMetrics(registry); });
 }
 
 DataMgr::~DataMgr() {
+  metrics::registry().removeCollector(metrics_collector_id_);
   for (auto& [p, ctx] : device_contexts_) {
     for (size_t device = 0; device < ctx->buffer_mgrs.size(); device++) {
       delete ctx->buffer_mgrs[device];
@@ -354,6 +357,40 @@ std::vector<Buffer_Namespace::MemoryInfo> DataMgr::getMemoryInfo(
   return mem_info;
 }
 
+void DataMgr::collectMetrics(metrics::Registry& registry) {
+  for (auto level : {MemoryLevel::CPU_LEVEL, MemoryLevel::GPU_LEVEL}) {
+    auto mem_info = getMemoryInfo(level);
+    for (size_t device = 0; device < mem_info.size(); ++device) {
+      auto& info = mem_info[device];
+      size_t used_pages = 0;
+      size_t buffers = 0;
+      for (auto& data : info.nodeMemoryData) {
+        if (data.memStatus == Buffer_Namespace::USED) {
+          used_pages += data.numPages;
+          ++buffers;
+        }
+      }
+      const metrics::Labels labels{{"level", level == CPU_LEVEL ? "CPU" : "GPU"},
+                                   {"device", std::to_string(device)}};
+      registry.gauge("hdk_buffer_pool_max_bytes", "Buffer pool size limit.", labels)
+          .set(info.maxNumPages * info.pageSize);
+      registry
+          .gauge("hdk_buffer_pool_allocated_bytes",
+                 "Memory allocated for buffer pool slabs.",
+                 labels)
+          .set(info.numPageAllocated * info.pageSize);
+      registry
+          .gauge("hdk_buffer_pool_used_bytes",
+                 "Buffer pool memory used by buffers.",
+                 labels)
+          .set(used_pages * info.pageSize);
+      registry
+          .gauge("hdk_buffer_pool_buffers", "Buffers resident in buffer pool.", labels)
+          .set(buffers);
+    }
+  }
+}
+
 std::string DataMgr::dumpLevel(const MemoryLevel memLevel) {
   // if gpu we need to iterate through all the buffermanagers for each card
   if (memLevel == MemoryLevel::GPU_LEVEL) {
@@ -34,6 +34,7 @@
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
 #include "SchemaMgr/ColumnInfo.h"
 #include "Shared/Config.h"
+#include "Shared/Metrics.h"
 #include "Shared/mapd_shared_mutex.h"
 
 #include <fstream>
@@ -231,6 +232,8 @@ class DataMgr {
                             size_t maxCpuSlabSize,
                             size_t page_size,
                             const std::vector<size_t>& cpu_tier_sizes);
+  // Update buffer pool residency gauges.
+  void collectMetrics(metrics::Registry& registry);
 
   std::vector<int> levelSizes_;
   std::vector<std::vector<AbstractBufferMgr*>> bufferMgrs_;
@@ -241,6 +244,7 @@ class DataMgr {
   size_t reservedGpuMem_;
   std::unique_ptr<DataMgrBufferProvider> buffer_provider_;
   std::unique_ptr<DataMgrDataProvider> data_provider_;
+  metrics::Registry::CollectorId metrics_collector_id_;
 };
 
 std::ostream& operator<<(std::ostream& os, const DataMgr::SystemMemoryUsage&);
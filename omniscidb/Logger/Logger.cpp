@@ -540,6 +540,12 @@ class Duration {
       , line_(line)
       , name_(name) {}
   bool stop();
+  bool stopped() const { return stop_ != Clock::time_point(); }
+  // Start time relative to the given time point.
+  template <typename Units = std::chrono::milliseconds>
+  typename Units::rep start_time_since(Clock::time_point time_point) const {
+    return std::chrono::duration_cast<Units>(start_ - time_point).count();
+  }
   // Start time relative to parent DurationTree::start_.
   template <typename Units = std::chrono::milliseconds>
   typename Units::rep relative_start_time() const;
@@ -559,12 +565,14 @@ class DurationTree {
   int const depth_;  //< Depth of tree within parent tree, 0 for root tree.
   Clock::time_point const start_;
   ThreadId const thread_id_;
-  DurationTree(ThreadId thread_id, int start_depth)
+  bool const forced_;  //< Root tree created by a forced DebugTimer.
+  DurationTree(ThreadId thread_id, int start_depth, bool forced = false)
       // Add +1 to current_depth_ for non-root DurationTrees for extra indentation.
       : current_depth_(start_depth + bool(start_depth))
       , depth_(start_depth)
       , start_(Clock::now())
-      , thread_id_(thread_id) {}
+      , thread_id_(thread_id)
+      , forced_(forced) {}
   void pushDurationTree(DurationTree& duration_tree) {
     durations_.emplace_back(duration_tree);
   }
@@ -611,16 +619,29 @@ std::mutex g_duration_tree_map_mutex;
 DurationTreeMap g_duration_tree_map;
 std::atomic<ThreadId> g_next_thread_id{0};
 thread_local ThreadId g_thread_id = g_next_thread_id++;
+// Number of live root DurationTrees created by forced DebugTimers.
+std::atomic<int> g_forced_duration_trees{0};
 
+// With g_enable_debug_timer off, only forced timers and timers of threads which
+// already belong to a forced DurationTree are recorded.
 template <typename... Ts>
-Duration* newDuration(Severity severity, Ts&&... args) {
-  if (g_enable_debug_timer) {
+Duration* newDuration(bool force, Severity severity, Ts&&... args) {
+  if (g_enable_debug_timer || force || g_forced_duration_trees.load()) {
     std::lock_guard<std::mutex> lock_guard(g_duration_tree_map_mutex);
-    auto& duration_tree_ptr = g_duration_tree_map[g_thread_id];
-    if (!duration_tree_ptr) {
-      duration_tree_ptr = std::make_unique<DurationTree>(g_thread_id, 0);
+    auto itr = g_duration_tree_map.find(g_thread_id);
+    if (itr == g_duration_tree_map.end()) {
+      if (!g_enable_debug_timer && !force) {
+        return nullptr;
+      }
+      itr = g_duration_tree_map
+                .emplace(g_thread_id,
+                         std::make_unique<DurationTree>(g_thread_id, 0, force))
+                .first;
+      if (force) {
+        ++g_forced_duration_trees;
+      }
     }
-    return duration_tree_ptr->newDuration(severity, std::forward<Ts>(args)...);
+    return itr->second->newDuration(severity, std::forward<Ts>(args)...);
   }
   return nullptr;  // Inactive - don't measure or report timing.
 }
@@ -741,6 +762,81 @@ class JsonEncoder : boost::static_visitor<rapidjson::Value> {
   }
 };
 
+// Encode DurationTree into the Chrome trace event format which can be loaded into
+// chrome://tracing or ui.perfetto.dev. Every stopped Duration becomes a complete
+// ("X") event on the timeline of its thread. Timestamps are in microseconds
+// relative to the start of the root DurationTree.
+class ChromeTraceEncoder : boost::static_visitor<> {
+  rapidjson::Document doc_;
+  rapidjson::Document::AllocatorType& alloc_;
+  rapidjson::Value events_;
+  Clock::time_point start_;
+  ThreadId thread_id_;
+
+  void addThread(ThreadId thread_id) {
+    rapidjson::Value args(rapidjson::kObjectType);
+    args.AddMember("name", "thread " + std::to_string(thread_id), alloc_);
+    rapidjson::Value event(rapidjson::kObjectType);
+    event.AddMember("name", "thread_name", alloc_);
+    event.AddMember("ph", "M", alloc_);
+    event.AddMember("pid", rapidjson::Value(1), alloc_);
+    event.AddMember("tid", rapidjson::Value(thread_id), alloc_);
+    event.AddMember("args", args, alloc_);
+    events_.PushBack(event, alloc_);
+  }
+
+ public:
+  ChromeTraceEncoder()
+      : doc_(rapidjson::kObjectType)
+      , alloc_(doc_.GetAllocator())
+      , events_(rapidjson::kArrayType) {}
+  void operator()(Duration const& duration) {
+    // Timers which are still running, e.g. ones of detached threads, are skipped.
+    if (!duration.stopped()) {
+      return;
+    }
+    rapidjson::Value args(rapidjson::kObjectType);
+    args.AddMember("location",
+                   filename(duration.file_) + ':' + std::to_string(duration.line_),
+                   alloc_);
+    rapidjson::Value event(rapidjson::kObjectType);
+    event.AddMember("name", rapidjson::StringRef(duration.name_), alloc_);
+    event.AddMember("cat", "query", alloc_);
+    event.AddMember("ph", "X", alloc_);
+    event.AddMember(
+        "ts",
+        rapidjson::Value(duration.start_time_since<std::chrono::microseconds>(start_)),
+        alloc_);
+    event.AddMember(
+        "dur", rapidjson::Value(duration.value<std::chrono::microseconds>()), alloc_);
+    event.AddMember("pid", rapidjson::Value(1), alloc_);
+    event.AddMember("tid", rapidjson::Value(thread_id_), alloc_);
+    event.AddMember("args", args, alloc_);
+    events_.PushBack(event, alloc_);
+  }
+  void operator()(DurationTree const& duration_tree) {
+    auto const parent_thread_id = thread_id_;
+    thread_id_ = duration_tree.thread_id_;
+    addThread(thread_id_);
+    for (auto const& duration_tree_node : duration_tree.durations()) {
+      apply_visitor(*this, duration_tree_node);
+    }
+    thread_id_ = parent_thread_id;
+  }
+  // Assumes no events were added yet.
+  std::string str(DurationTreeMap::const_reference kv_pair) {
+    start_ = kv_pair.second->start_;
+    thread_id_ = kv_pair.first;
+    (*this)(*kv_pair.second);
+    doc_.AddMember("traceEvents", events_, alloc_);
+    doc_.AddMember("displayTimeUnit", "ms", alloc_);
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc_.Accept(writer);
+    return {buffer.GetString(), buffer.GetSize()};
+  }
+};
+
 /// Depth-first search and erase all DurationTrees. Not thread-safe.
 struct EraseDurationTrees : boost::static_visitor<> {
   void operator()(DurationTreeMap::const_iterator const& itr) const {
@@ -758,24 +854,41 @@ struct EraseDurationTrees : boost::static_visitor<> {
   }
 };
 
-void logAndEraseDurationTree(std::string* json_str) {
+void logAndEraseDurationTree(std::string* json_str, std::string* trace_str) {
   std::lock_guard<std::mutex> lock_guard(g_duration_tree_map_mutex);
   DurationTreeMap::const_iterator const itr = g_duration_tree_map.find(g_thread_id);
   CHECK(itr != g_duration_tree_map.cend());
   auto const& root_duration = itr->second->rootDuration();
-  if (auto log = Logger(root_duration.severity_)) {
-    log.stream(root_duration.file_, root_duration.line_) << *itr;
+  // Trees recorded only because of a forced timer are not logged.
+  if (g_enable_debug_timer) {
+    if (auto log = Logger(root_duration.severity_)) {
+      log.stream(root_duration.file_, root_duration.line_) << *itr;
+    }
   }
   if (json_str) {
     JsonEncoder json_encoder;
     *json_str = json_encoder.str(*itr);
   }
+  if (trace_str) {
+    ChromeTraceEncoder trace_encoder;
+    *trace_str = trace_encoder.str(*itr);
+  }
+  if (itr->second->forced_) {
+    --g_forced_duration_trees;
+  }
   EraseDurationTrees erase_duration_trees;
   erase_duration_trees(itr);
 }
 
 DebugTimer::DebugTimer(Severity severity, char const* file, int line, char const* name)
-    : duration_(newDuration(severity, file, line, name)) {
+    : DebugTimer(severity, file, line, name, false) {}
+
+DebugTimer::DebugTimer(Severity severity,
+                       char const* file,
+                       int line,
+                       char const* name,
+                       bool force)
+    : duration_(newDuration(force, severity, file, line, name)) {
   nvtx_helpers::omnisci_range_push(nvtx_helpers::Category::kDebugTimer, name, file);
 }
 
@@ -787,7 +900,7 @@ DebugTimer::~DebugTimer() {
 void DebugTimer::stop() {
   if (duration_) {
     if (duration_->stop()) {
-      logAndEraseDurationTree(nullptr);
+      logAndEraseDurationTree(nullptr, nullptr);
     }
     duration_ = nullptr;
   }
@@ -797,18 +910,37 @@ std::string DebugTimer::stopAndGetJson() {
   std::string json_str;
   if (duration_) {
     if (duration_->stop()) {
-      logAndEraseDurationTree(&json_str);
+      logAndEraseDurationTree(&json_str, nullptr);
     }
     duration_ = nullptr;
   }
   return json_str;
 }
 
+std::string DebugTimer::stopAndGetChromeTrace() {
+  std::string trace_str;
+  if (duration_) {
+    if (duration_->stop()) {
+      logAndEraseDurationTree(nullptr, &trace_str);
+    }
+    duration_ = nullptr;
+  }
+  return trace_str;
+}
+
+bool forced_debug_timers_active() {
+  return g_forced_duration_trees.load() > 0;
+}
+
 /// Call this when a new thread is spawned that will have timers that need to be
 /// associated with timers on the parent thread.
 void debug_timer_new_thread(ThreadId parent_thread_id) {
   std::lock_guard<std::mutex> lock_guard(g_duration_tree_map_mutex);
   auto parent_itr = g_duration_tree_map.find(parent_thread_id);
+  if (parent_itr == g_duration_tree_map.end() && !g_enable_debug_timer) {
+    // Called because some other query is traced, the parent thread is not.
+    return;
+  }
   CHECK(parent_itr != g_duration_tree_map.end()) << parent_thread_id;
   auto const current_depth = parent_itr->second->currentDepth();
   auto& duration_tree_ptr = g_duration_tree_map[g_thread_id];
@@ -326,12 +326,21 @@ class DebugTimer {
 
  public:
   DebugTimer(Severity, char const* file, int line, char const* name);
+  // A forced timer is recorded even if g_enable_debug_timer is off. So are all timers
+  // nested into it, including the ones of threads registered by
+  // DEBUG_TIMER_NEW_THREAD. Such trees are not logged, use stopAndGet*() to get them.
+  DebugTimer(Severity, char const* file, int line, char const* name, bool force);
   ~DebugTimer();
   void stop();
   // json is returned only when called on the root DurationTree.
   std::string stopAndGetJson();
+  // Chrome trace event json is returned only when called on the root DurationTree.
+  std::string stopAndGetChromeTrace();
 };
 
+// True iff there is a running root forced DebugTimer.
+bool forced_debug_timers_active();
+
 using QueryId = uint64_t;
 QueryId query_id();
 
@@ -371,10 +380,10 @@ ThreadId thread_id();
 // This MUST NOT be called more than once per thread, otherwise a failed CHECK() occurs.
 // Best practice is to call it from the point where the new thread is spawned.
 // Beware of threads that are re-used.
-#define DEBUG_TIMER_NEW_THREAD(parent_thread_id)        \
-  do {                                                  \
-    if (g_enable_debug_timer)                           \
-      logger::debug_timer_new_thread(parent_thread_id); \
+#define DEBUG_TIMER_NEW_THREAD(parent_thread_id)                      \
+  do {                                                                \
+    if (g_enable_debug_timer || logger::forced_debug_timers_active()) \
+      logger::debug_timer_new_thread(parent_thread_id);               \
   } while (false)
 
 }  // namespace logger
@@ -28,6 +28,16 @@ int get_page_size() {
   return getpagesize();
 }
 
+void* checked_mmap(const int fd, const size_t sz) {
+  auto ptr = mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+  CHECK(ptr != MAP_FAILED);
+  return ptr;
+}
+
+void checked_munmap(void* addr, size_t length) {
+  CHECK_EQ(munmap(addr, length), 0);
+}
+
 ::FILE* popen(const char* command, const char* type) {
   return ::popen(command, type);
 }
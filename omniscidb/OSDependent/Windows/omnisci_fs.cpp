@@ -38,6 +38,21 @@ int32_t pclose(::FILE* fh) {
   return _pclose(fh);
 }
 
+void* checked_mmap(const int fd, const size_t sz) {
+  auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+  auto mapping = CreateFileMapping(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CHECK(mapping);
+  auto ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sz);
+  CHECK(ptr);
+  // The view keeps the mapping alive.
+  CloseHandle(mapping);
+  return ptr;
+}
+
+void checked_munmap(void* addr, size_t length) {
+  CHECK(UnmapViewOfFile(addr));
+}
+
 int get_page_size() {
   return 4096;  // TODO: reasonable guess for now
 }
@@ -28,4 +28,10 @@ int32_t pclose(::FILE* fh);
 
 int get_page_size();
 
+// Maps sz bytes of the file read-only. Pages are shared with other processes
+// mapping the same file.
+void* checked_mmap(const int fd, const size_t sz);
+
+void checked_munmap(void* addr, size_t length);
+
 }  // namespace omnisci
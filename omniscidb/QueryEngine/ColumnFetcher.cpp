@@ -204,6 +204,9 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
         memory_level == Data_Namespace::CPU_LEVEL ? 0 : device_id,
         chunk_meta_it->second->numBytes(),
         chunk_meta_it->second->numElements());
+    if (auto profiler = executor_->getStepProfiler()) {
+      profiler->addFetchedBytes(memory_level, chunk_meta_it->second->numBytes());
+    }
     std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
     chunk_holder.push_back(chunk);
   }
@@ -335,6 +338,10 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
                                                0,
                                                chunk_meta_it->second->numBytes(),
                                                chunk_meta_it->second->numElements());
+              if (auto profiler = executor_->getStepProfiler()) {
+                profiler->addFetchedBytes(Data_Namespace::CPU_LEVEL,
+                                          chunk_meta_it->second->numBytes());
+              }
               std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
               chunk_holder.push_back(chunk);
             }
@@ -434,6 +441,10 @@ const int8_t* ColumnFetcher::linearizeColumnFragments(
                                         0,
                                         chunk_meta_it->second->numBytes(),
                                         chunk_meta_it->second->numElements());
+      if (auto profiler = executor_->getStepProfiler()) {
+        profiler->addFetchedBytes(Data_Namespace::CPU_LEVEL,
+                                  chunk_meta_it->second->numBytes());
+      }
       local_chunk_holder.push_back(chunk);
       auto chunk_iter = chunk->begin_iterator(chunk_meta_it->second);
       local_chunk_iter_holder.push_back(chunk_iter);
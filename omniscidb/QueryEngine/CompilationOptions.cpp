@@ -22,6 +22,7 @@ std::ostream& operator<<(std::ostream& os, const ExecutionOptions& eo) {
   os << "output_columnar_hint=" << eo.output_columnar_hint << "\n"
      << "allow_multifrag=" << eo.allow_multifrag << "\n"
      << "just_explain=" << eo.just_explain << "\n"
+     << "explain_analyze=" << eo.explain_analyze << "\n"
      << "allow_loop_joins=" << eo.allow_loop_joins << "\n"
      << "with_watchdog=" << eo.with_watchdog << "\n"
      << "jit_debug=" << eo.jit_debug << "\n"
@@ -34,7 +35,8 @@ std::ostream& operator<<(std::ostream& os, const ExecutionOptions& eo) {
      << "running_query_interrupt_freq=" << eo.running_query_interrupt_freq << "\n"
      << "pending_query_interrupt_freq=" << eo.pending_query_interrupt_freq << "\n"
      << "multifrag_result=" << eo.multifrag_result << "\n"
-     << "preserve_order=" << eo.preserve_order << "\n";
+     << "preserve_order=" << eo.preserve_order << "\n"
+     << "query_trace=" << eo.query_trace << "\n";
   return os;
 }
 
@@ -119,7 +119,8 @@ enum class ExecutorType { Native, Extern };
 struct ExecutionOptions {
   bool output_columnar_hint;
   bool allow_multifrag;
-  bool just_explain;  // return the generated IR for the first step
+  bool just_explain;     // return the generated IR for the first step
+  bool explain_analyze;  // execute the query and return its runtime profile
   bool allow_loop_joins;
   bool with_watchdog;  // Per work unit, not global.
   bool jit_debug;
@@ -138,12 +139,14 @@ struct ExecutionOptions {
   std::vector<size_t> outer_fragment_indices{};
   bool multifrag_result = false;
   bool preserve_order = false;
+  bool query_trace = false;  // write the query timeline in the Chrome trace format
 
   static ExecutionOptions fromConfig(const Config& config) {
     auto eo = ExecutionOptions();
     eo.output_columnar_hint = config.rs.enable_columnar_output;
     eo.allow_multifrag = true;
     eo.just_explain = false;
+    eo.explain_analyze = false;
     eo.allow_loop_joins = config.exec.join.allow_loop_joins;
     eo.with_watchdog = config.exec.watchdog.enable;
     eo.jit_debug = false;
@@ -160,6 +163,7 @@ struct ExecutionOptions {
 
     eo.multifrag_result = config.exec.enable_multifrag_rs;
     eo.preserve_order = false;
+    eo.query_trace = config.debug.enable_query_trace;
     eo.forced_gpu_proportion = config.exec.heterogeneous.forced_gpu_proportion;
     eo.forced_cpu_proportion = config.exec.heterogeneous.forced_cpu_proportion;
 
@@ -184,6 +188,18 @@ struct ExecutionOptions {
     return eo;
   }
 
+  ExecutionOptions with_explain_analyze(bool enable = true) const {
+    ExecutionOptions eo = *this;
+    eo.explain_analyze = enable;
+    return eo;
+  }
+
+  ExecutionOptions with_query_trace(bool enable = true) const {
+    ExecutionOptions eo = *this;
+    eo.query_trace = enable;
+    return eo;
+  }
+
   ExecutionOptions with_columnar_output(bool enable = true) const {
     ExecutionOptions eo = *this;
     eo.output_columnar_hint = enable;
@@ -23,6 +23,7 @@
 #include "QueryEngine/RelAlgExecutionUnit.h"
 #include "ResultSet/ResultSet.h"
 #include "ResultSetRegistry/ColumnarResults.h"
+#include "Shared/Metrics.h"
 #include "Shared/mapd_shared_mutex.h"
 #include "Shared/misc.h"
 
@@ -125,6 +126,27 @@ class DataRecyclerUtil {
     return cache_item_type_str[item_type];
   }
 
+  // item_type label values of data recycler metrics
+  static constexpr auto cache_item_type_label =
+      shared::string_view_array("perfect_ht",
+                                "baseline_ht",
+                                "ht_hashing_scheme",
+                                "baseline_ht_approx_card");
+  static metrics::Labels metricLabels(CacheItemType item_type) {
+    static_assert(cache_item_type_label.size() == NUM_CACHE_ITEM_TYPE);
+    return {{"item_type", std::string(cache_item_type_label[item_type])}};
+  }
+
+  static void countCacheLookup(CacheItemType item_type, bool hit) {
+    auto labels = metricLabels(item_type);
+    labels.emplace_back("result", hit ? "hit" : "miss");
+    metrics::registry()
+        .counter("hdk_data_recycler_lookups_total",
+                 "Lookups of cached items in data recyclers.",
+                 labels)
+        .inc();
+  }
+
   static constexpr DeviceIdentifier CPU_DEVICE_IDENTIFIER = 0;
 
   static std::string getDeviceIdentifierString(DeviceIdentifier device_identifier) {
@@ -303,12 +325,18 @@ class CacheMetricTracker {
                               size_t size) {
     auto current_cache_size = getCurrentCacheSize(device_identifier);
     CHECK(current_cache_size.has_value());
+    auto& cached_bytes =
+        metrics::registry().gauge("hdk_data_recycler_bytes",
+                                  "Size of items cached by data recyclers.",
+                                  DataRecyclerUtil::metricLabels(item_type_));
     if (action == CacheUpdateAction::ADD) {
       setCurrentCacheSize(device_identifier, current_cache_size.value() + size);
+      cached_bytes.add(size);
     } else {
       CHECK_EQ(action, CacheUpdateAction::REMOVE);
       CHECK_LE(size, *current_cache_size);
       setCurrentCacheSize(device_identifier, current_cache_size.value() - size);
+      cached_bytes.sub(size);
     }
   }
 
@@ -30,6 +30,7 @@ std::optional<HashType> HashingSchemeRecycler::getItemFromCache(
   std::lock_guard<std::mutex> lock(getCacheLock());
   auto layout_cache = getCachedItemContainer(item_type, device_identifier);
   auto candidate_layout = getCachedItem(key, *layout_cache);
+  DataRecyclerUtil::countCacheLookup(item_type, candidate_layout.has_value());
   if (candidate_layout) {
     VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
             << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
@@ -52,6 +52,7 @@ std::shared_ptr<HashTable> HashtableRecycler::getItemFromCache(
   std::lock_guard<std::mutex> lock(getCacheLock());
   auto hashtable_cache = getCachedItemContainer(item_type, device_identifier);
   auto candidate_ht = getCachedItem(key, *hashtable_cache);
+  DataRecyclerUtil::countCacheLookup(item_type, candidate_ht.has_value());
   if (candidate_ht) {
     candidate_ht->item_metric->incRefCount();
     VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
@@ -171,6 +172,12 @@ void HashtableRecycler::cleanupCacheForInsertion(
     }
   }
 
+  metrics::registry()
+      .counter("hdk_data_recycler_evictions_total",
+               "Items evicted from data recyclers to free space.",
+               DataRecyclerUtil::metricLabels(item_type))
+      .inc(elimination_target_offset);
+
   // eliminate targets in 1) cache container and 2) their metrics
   removeCachedItemFromBeginning(item_type, device_identifier, elimination_target_offset);
   metric_tracker.removeMetricFromBeginning(device_identifier, elimination_target_offset);
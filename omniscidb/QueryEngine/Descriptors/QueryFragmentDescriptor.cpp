@@ -121,8 +121,11 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
           table_desc, ra_exe_unit, fragment, frag_offsets, frag_id, cgen_traits_desc);
     }
     if (skip_frag.first) {
+      ++skipped_fragments_;
       continue;
     }
+    ++scanned_fragments_;
+    scanned_rows_ += fragment.getNumTuples();
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
 
     const auto [device_type, device_id] =
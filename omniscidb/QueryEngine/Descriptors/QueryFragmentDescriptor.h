@@ -139,10 +139,18 @@ class QueryFragmentDescriptor {
     return rowid_lookup_key_ < 0 && !execution_kernels_per_device_.empty();
   }
 
+  size_t getScannedFragmentCount() const { return scanned_fragments_; }
+  size_t getSkippedFragmentCount() const { return skipped_fragments_; }
+  size_t getScannedRowCount() const { return scanned_rows_; }
+
  protected:
   std::vector<size_t> allowed_outer_fragment_indices_;
   size_t outer_fragments_size_ = 0;
   int64_t rowid_lookup_key_ = -1;
+  // Outer fragments statistics reported to the query profile.
+  size_t scanned_fragments_ = 0;
+  size_t skipped_fragments_ = 0;
+  size_t scanned_rows_ = 0;
 
   std::map<TableRef, const TableFragments*> selected_tables_fragments_;
 
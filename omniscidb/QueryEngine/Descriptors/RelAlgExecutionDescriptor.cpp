@@ -21,6 +21,7 @@ ExecutionResult::ExecutionResult()
     : filter_push_down_enabled_(false)
     , success_(true)
     , execution_time_ms_(0)
+    , reduction_time_ms_(0)
     , type_(QueryResult) {}
 
 ExecutionResult::ExecutionResult(hdk::ResultSetTableTokenPtr token,
@@ -30,6 +31,7 @@ ExecutionResult::ExecutionResult(hdk::ResultSetTableTokenPtr token,
     , filter_push_down_enabled_(false)
     , success_(true)
     , execution_time_ms_(0)
+    , reduction_time_ms_(0)
     , type_(QueryResult) {}
 
 ExecutionResult::ExecutionResult(const ExecutionResult& that)
@@ -38,7 +40,9 @@ ExecutionResult::ExecutionResult(const ExecutionResult& that)
     , filter_push_down_enabled_(that.filter_push_down_enabled_)
     , success_(true)
     , execution_time_ms_(0)
-    , type_(QueryResult) {
+    , reduction_time_ms_(that.reduction_time_ms_)
+    , type_(QueryResult)
+    , profile_(that.profile_) {
   if (!pushed_down_filter_info_.empty() ||
       (filter_push_down_enabled_ && pushed_down_filter_info_.empty())) {
     return;
@@ -52,7 +56,9 @@ ExecutionResult::ExecutionResult(ExecutionResult&& that)
     , filter_push_down_enabled_(std::move(that.filter_push_down_enabled_))
     , success_(true)
     , execution_time_ms_(0)
-    , type_(QueryResult) {
+    , reduction_time_ms_(that.reduction_time_ms_)
+    , type_(QueryResult)
+    , profile_(std::move(that.profile_)) {
   if (!pushed_down_filter_info_.empty() ||
       (filter_push_down_enabled_ && pushed_down_filter_info_.empty())) {
     return;
@@ -67,6 +73,7 @@ ExecutionResult::ExecutionResult(
     , filter_push_down_enabled_(filter_push_down_enabled)
     , success_(true)
     , execution_time_ms_(0)
+    , reduction_time_ms_(0)
     , type_(QueryResult) {}
 
 ExecutionResult& ExecutionResult::operator=(const ExecutionResult& that) {
@@ -80,7 +87,9 @@ ExecutionResult& ExecutionResult::operator=(const ExecutionResult& that) {
   targets_meta_ = that.targets_meta_;
   success_ = that.success_;
   execution_time_ms_ = that.execution_time_ms_;
+  reduction_time_ms_ = that.reduction_time_ms_;
   type_ = that.type_;
+  profile_ = that.profile_;
   return *this;
 }
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "QueryEngine/JoinFilterPushDown.h"
+#include "QueryEngine/QueryProfile.h"
 #include "ResultSet/QueryMemoryDescriptor.h"
 #include "ResultSet/ResultSet.h"
 #include "ResultSetRegistry/ResultSetRegistry.h"
@@ -97,6 +98,14 @@ class ExecutionResult {
   void addExecutionTime(int64_t execution_time_ms) {
     execution_time_ms_ += execution_time_ms;
   }
+  // Time spent in reduction of partial results of all query steps.
+  int64_t getReductionTime() const { return reduction_time_ms_; }
+  void setReductionTime(int64_t reduction_time_ms) {
+    reduction_time_ms_ = reduction_time_ms;
+  }
+  // Runtime profile of the query, available in the EXPLAIN ANALYZE mode only.
+  QueryProfilePtr getProfile() const { return profile_; }
+  void setProfile(QueryProfilePtr profile) { profile_ = std::move(profile); }
 
  private:
   hdk::ResultSetTableTokenPtr result_token_;
@@ -108,7 +117,9 @@ class ExecutionResult {
 
   bool success_;
   uint64_t execution_time_ms_;
+  int64_t reduction_time_ms_;
   RType type_;
+  QueryProfilePtr profile_;
 };
 
 namespace hdk::ir {
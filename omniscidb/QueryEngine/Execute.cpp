@@ -23,10 +23,12 @@
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/locale/conversion.hpp>
 
 #ifdef HAVE_CUDA
 #include <cuda.h>
 #endif  // HAVE_CUDA
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_reduce.h>
 #include <chrono>
 #include <ctime>
@@ -67,6 +69,7 @@
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "QueryEngine/ResultSetReduction.h"
 #include "QueryEngine/ResultSetReductionJIT.h"
+#include "QueryEngine/ResultSetSort.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/SpeculativeTopN.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
@@ -75,6 +78,7 @@
 #include "ResultSet/ColRangeInfo.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
+#include "Shared/Metrics.h"
 #include "Shared/measure.h"
 #include "Shared/misc.h"
 #include "Shared/scope.h"
@@ -335,6 +339,17 @@ void Executor::update_extension_modules(bool update_runtime_modules_only) {
 #endif
 }
 
+void Executor::CgenStateManager::observeCompilationQueueTime() {
+  const auto queue_time =
+      timer_stop<std::chrono::steady_clock::time_point, std::chrono::microseconds>(
+          lock_queue_clock_);
+  executor_.compilation_queue_time_ms_ += queue_time / 1000;
+  static auto& compilation_queue_seconds = metrics::registry().histogram(
+      "hdk_compilation_queue_seconds",
+      "Time queries wait for the executor compilation lock.");
+  compilation_queue_seconds.observe(queue_time / 1e6);
+}
+
 // Used by StubGenerator::generateStub
 Executor::CgenStateManager::CgenStateManager(Executor& executor)
     : executor_(executor)
@@ -342,7 +357,7 @@ Executor::CgenStateManager::CgenStateManager(Executor& executor)
     , lock_(executor_.compilation_mutex_)
     , cgen_state_(std::move(executor_.cgen_state_))  // store old CgenState instance
 {
-  executor_.compilation_queue_time_ms_ += timer_stop(lock_queue_clock_);
+  observeCompilationQueueTime();
   executor_.cgen_state_.reset(
       new CgenState(0,
                     false,
@@ -361,7 +376,7 @@ Executor::CgenStateManager::CgenStateManager(
     , lock_(executor_.compilation_mutex_)
     , cgen_state_(std::move(executor_.cgen_state_))  // store old CgenState instance
 {
-  executor_.compilation_queue_time_ms_ += timer_stop(lock_queue_clock_);
+  observeCompilationQueueTime();
   // nukeOldState creates new CgenState and PlanState instances for
   // the subsequent code generation.  It also resets
   // kernel_queue_time_ms_ and compilation_queue_time_ms_ that we do
@@ -474,6 +489,28 @@ const std::vector<int32_t>* Executor::getStringProxyTranslationMap(
       source_dict_id, source_generation, dest_dict_id, dest_generation, translation_type);
 }
 
+const std::vector<int32_t>* Executor::getStringProxyTransformTranslationMap(
+    const int dict_id,
+    const StringTransformType transform_type,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+    const bool with_generation) const {
+  CHECK(row_set_mem_owner);
+  std::lock_guard<std::mutex> lock(
+      str_dict_mutex_);  // TODO: can we use RowSetMemOwner state mutex here?
+  const int64_t generation =
+      with_generation ? string_dictionary_generations_.getGeneration(dict_id) : -1;
+  auto proxy = row_set_mem_owner->getOrAddStringDictProxy(dict_id, generation);
+  switch (transform_type) {
+    case StringTransformType::kLower:
+      return row_set_mem_owner->addStringProxyTransformTranslationMap(
+          proxy, "LOWER", [](const std::string& str) {
+            return boost::locale::to_lower(str);
+          });
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
 const std::vector<int32_t>* Executor::getIntersectionStringProxyTranslationMap(
     const StringDictionary* source_proxy,
     const StringDictionary* dest_proxy,
@@ -1206,6 +1243,21 @@ ReductionCode get_reduction_code(
   return reduction_jit.codegen();
 };
 
+size_t count_non_empty_entries(const ResultSetStorage& storage) {
+  return tbb::parallel_reduce(
+      tbb::blocked_range<size_t>(0, storage.getQueryMemDesc().getEntryCount()),
+      size_t(0),
+      [&storage](const tbb::blocked_range<size_t>& r, size_t count) {
+        for (size_t entry_idx = r.begin(); entry_idx != r.end(); ++entry_idx) {
+          if (!storage.isEmptyEntry(entry_idx)) {
+            ++count;
+          }
+        }
+        return count;
+      },
+      std::plus<size_t>());
+}
+
 }  // namespace
 
 bool couldUseParallelReduce(const QueryMemoryDescriptor& desc) {
@@ -1227,7 +1279,13 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
     const QueryMemoryDescriptor& query_mem_desc,
     const CompilationOptions& co) {
   auto timer = DEBUG_TIMER(__func__);
+  auto clock_begin = timer_start();
   std::shared_ptr<ResultSet> reduced_results;
+  ScopeGuard profile_reduction = [this, clock_begin] {
+    if (step_profiler_) {
+      step_profiler_->addReduction(QueryStepProfiler::elapsed(clock_begin));
+    }
+  };
 
   const auto& first = results_per_device.front().first;
 
@@ -1235,11 +1293,20 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
     // This finalization is optional but done here to have finalization time
     // to be a part of reduction.
     first->finalizeAggregates();
+    first->addReductionTime(timer_stop(clock_begin));
     return first;
   }
 
-  if (query_mem_desc.getQueryDescriptionType() ==
-      QueryDescriptionType::GroupByBaselineHash) {
+  const bool use_tree_reduction =
+      query_mem_desc.getQueryDescriptionType() ==
+          QueryDescriptionType::GroupByBaselineHash &&
+      getConfig().exec.group_by.enable_tree_reduction &&
+      results_per_device.size() >= getConfig().exec.group_by.tree_reduction_threshold;
+
+  if (use_tree_reduction) {
+    // Result set to reduce into is chosen by the tree reduction.
+  } else if (query_mem_desc.getQueryDescriptionType() ==
+             QueryDescriptionType::GroupByBaselineHash) {
     const auto total_entry_count = std::accumulate(
         results_per_device.begin(),
         results_per_device.end(),
@@ -1249,35 +1316,8 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
           return init + r->getQueryMemDesc().getEntryCount();
         });
     CHECK(total_entry_count);
-    auto query_mem_desc = first->getQueryMemDesc();
-    query_mem_desc.setEntryCount(total_entry_count);
-    reduced_results = std::make_shared<ResultSet>(first->getTargetInfos(),
-                                                  ExecutorDeviceType::CPU,
-                                                  query_mem_desc,
-                                                  row_set_mem_owner,
-                                                  data_mgr_,
-                                                  blockSize(),
-                                                  gridSize());
-    auto result_storage = reduced_results->allocateStorage(plan_state_->init_agg_vals_);
-    reduced_results->initializeStorage();
-    switch (query_mem_desc.getEffectiveKeyWidth()) {
-      case 4:
-        ResultSetReduction::moveEntriesToBuffer<int32_t>(
-            first->getStorage()->getQueryMemDesc(),
-            first->getStorage()->getUnderlyingBuffer(),
-            result_storage->getUnderlyingBuffer(),
-            query_mem_desc.getEntryCount());
-        break;
-      case 8:
-        ResultSetReduction::moveEntriesToBuffer<int64_t>(
-            first->getStorage()->getQueryMemDesc(),
-            first->getStorage()->getUnderlyingBuffer(),
-            result_storage->getUnderlyingBuffer(),
-            query_mem_desc.getEntryCount());
-        break;
-      default:
-        CHECK(false);
-    }
+    reduced_results =
+        makeBaselineReductionTarget(first, total_entry_count, row_set_mem_owner);
   } else {
     reduced_results = first;
     reduced_results->invalidateCachedRowCount();
@@ -1287,7 +1327,10 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
   const auto reduction_code = get_reduction_code(
       getConfig(), results_per_device, &compilation_queue_time, this, co);
 
-  if (couldUseParallelReduce(query_mem_desc)) {
+  if (use_tree_reduction) {
+    reduced_results = reduceBaselineResultSetsTree(
+        results_per_device, row_set_mem_owner, reduction_code);
+  } else if (couldUseParallelReduce(query_mem_desc)) {
     std::vector<ResultSetStorage*> storages;
     for (auto& rs : results_per_device) {
       storages.push_back(const_cast<ResultSetStorage*>(rs.first->getStorage()));
@@ -1332,9 +1375,118 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
   // so that we can safely destroy original ResultSets.
   reduced_results->finalizeAggregates();
   reduced_results->addCompilationQueueTime(compilation_queue_time);
+  reduced_results->addReductionTime(timer_stop(clock_begin));
+  VLOG(1) << "Reduced " << results_per_device.size() << " result sets in "
+          << reduced_results->getReductionTime() << " ms";
   return reduced_results;
 }
 
+ResultSetPtr Executor::makeBaselineReductionTarget(
+    const ResultSetPtr& src,
+    const size_t entry_count,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner) {
+  auto query_mem_desc = src->getQueryMemDesc();
+  CHECK(query_mem_desc.getQueryDescriptionType() ==
+        QueryDescriptionType::GroupByBaselineHash);
+  query_mem_desc.setEntryCount(entry_count);
+  auto res = std::make_shared<ResultSet>(src->getTargetInfos(),
+                                         ExecutorDeviceType::CPU,
+                                         query_mem_desc,
+                                         row_set_mem_owner,
+                                         data_mgr_,
+                                         blockSize(),
+                                         gridSize());
+  auto result_storage = res->allocateStorage(plan_state_->init_agg_vals_);
+  res->initializeStorage();
+  switch (query_mem_desc.getEffectiveKeyWidth()) {
+    case 4:
+      ResultSetReduction::moveEntriesToBuffer<int32_t>(
+          src->getStorage()->getQueryMemDesc(),
+          src->getStorage()->getUnderlyingBuffer(),
+          result_storage->getUnderlyingBuffer(),
+          query_mem_desc.getEntryCount());
+      break;
+    case 8:
+      ResultSetReduction::moveEntriesToBuffer<int64_t>(
+          src->getStorage()->getQueryMemDesc(),
+          src->getStorage()->getUnderlyingBuffer(),
+          result_storage->getUnderlyingBuffer(),
+          query_mem_desc.getEntryCount());
+      break;
+    default:
+      CHECK(false);
+  }
+  return res;
+}
+
+// Reduce baseline hash tables pairwise. All pairs of the same tree level are reduced
+// in parallel, so we have log2(N) sequential steps instead of N - 1 reductions into
+// a single table. Reduction target of each pair is re-used if it has enough room for
+// both tables. Otherwise, a new table big enough to hold all entries of the pair is
+// allocated.
+ResultSetPtr Executor::reduceBaselineResultSetsTree(
+    std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+    const ReductionCode& reduction_code) {
+  auto timer = DEBUG_TIMER(__func__);
+  std::vector<ResultSetPtr> results;
+  results.reserve(results_per_device.size());
+  for (auto& rs : results_per_device) {
+    results.push_back(rs.first);
+  }
+  std::vector<size_t> non_empty_entries(results.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, results.size()), [&](auto r) {
+    for (size_t i = r.begin(); i != r.end(); ++i) {
+      non_empty_entries[i] = count_non_empty_entries(*results[i]->getStorage());
+    }
+  });
+
+  for (size_t stride = 1; stride < results.size(); stride *= 2) {
+    const size_t pairs = (results.size() + stride * 2 - 1) / (stride * 2);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pairs), [&](auto r) {
+      for (size_t pair_idx = r.begin(); pair_idx != r.end(); ++pair_idx) {
+        const auto lhs_idx = pair_idx * stride * 2;
+        const auto rhs_idx = lhs_idx + stride;
+        if (rhs_idx >= results.size()) {
+          continue;
+        }
+        auto lhs_entry_count = results[lhs_idx]->getQueryMemDesc().getEntryCount();
+        auto rhs_entry_count = results[rhs_idx]->getQueryMemDesc().getEntryCount();
+        // Baseline reduction requires the target to be at least as big as the source.
+        if (lhs_entry_count < rhs_entry_count) {
+          std::swap(results[lhs_idx], results[rhs_idx]);
+          std::swap(non_empty_entries[lhs_idx], non_empty_entries[rhs_idx]);
+          std::swap(lhs_entry_count, rhs_entry_count);
+        }
+        // Keep load factor of the target table under 50% to avoid running out of
+        // slots and long probing sequences.
+        const auto max_non_empty =
+            non_empty_entries[lhs_idx] + non_empty_entries[rhs_idx];
+        if (max_non_empty * 2 > lhs_entry_count) {
+          results[lhs_idx] =
+              makeBaselineReductionTarget(results[lhs_idx],
+                                          std::max(lhs_entry_count + rhs_entry_count,
+                                                   max_non_empty * 2),
+                                          row_set_mem_owner);
+        } else {
+          results[lhs_idx]->invalidateCachedRowCount();
+        }
+        // Reduction reports the number of keys missing in the target, so the count of
+        // non-empty entries is kept up to date without re-scanning the table.
+        non_empty_entries[lhs_idx] +=
+            ResultSetReduction::reduce(*results[lhs_idx]->getStorage(),
+                                       *results[rhs_idx]->getStorage(),
+                                       {},
+                                       reduction_code,
+                                       getConfig(),
+                                       this);
+      }
+    });
+  }
+
+  return results.front();
+}
+
 ResultSetPtr Executor::reduceSpeculativeTopN(
     const RelAlgExecutionUnit& ra_exe_unit,
     std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
@@ -1754,6 +1906,10 @@ hdk::ResultSetTable Executor::executeWorkUnit(
     }
   };
 
+  if (step_profiler_) {
+    step_profiler_->addWorkUnit();
+  }
+
   bool has_proj_unnest =
       !UnnestedVarsCollector::collect(ra_exe_unit_in.target_exprs).empty();
   try {
@@ -2208,6 +2364,7 @@ hdk::ResultSetTable Executor::executeWorkUnitImpl(
       if (eo.executor_type == ExecutorType::Native) {
         try {
           INJECT_TIMER(query_step_compilation);
+          auto compilation_start = QueryStepProfiler::Clock::now();
           query_mem_desc_owned =
               query_comp_desc_owned->compile(max_groups_buffer_entry_guess,
                                              crt_min_byte_width,
@@ -2227,6 +2384,18 @@ hdk::ResultSetTable Executor::executeWorkUnitImpl(
                                              this);
           CHECK(query_mem_desc_owned);
           crt_min_byte_width = query_comp_desc_owned->getMinByteWidth();
+          const auto compilation_time = QueryStepProfiler::elapsed(compilation_start);
+          metrics::registry()
+              .histogram("hdk_compilation_seconds",
+                         "Time of query code generation and compilation.",
+                         {{"device", deviceToString(dt)}})
+              .observe(compilation_time / 1e6);
+          if (step_profiler_) {
+            step_profiler_->addCompilation(compilation_time, deviceToString(dt));
+            step_profiler_->setMemoryLayout(
+                query_mem_desc_owned->queryDescTypeToString(),
+                query_mem_desc_owned->didOutputColumnar());
+          }
         } catch (CompilationRetryNoCompaction&) {
           crt_min_byte_width = MAX_BYTE_WIDTH_SUPPORTED;
           continue;
@@ -2601,8 +2770,78 @@ ResultSetPtr build_row_for_empty_input(
   return rs;
 }
 
+// Partitioned aggregation produces complete groups in each partition because
+// rows are shuffled by group-by keys. Therefore, rows which don't make it into
+// the top-n of their partition cannot appear in the top-n of the final result
+// and can be dropped before partitions are merged.
+bool can_prune_partitioned_top_n(const RelAlgExecutionUnit& ra_exe_unit,
+                                 const QueryMemoryDescriptor& query_mem_desc,
+                                 const Config& config) {
+  if (!config.exec.group_by.enable_partitioned_top_n ||
+      !ra_exe_unit.partitioned_aggregation ||
+      ra_exe_unit.sort_info.order_entries.empty() || !ra_exe_unit.sort_info.limit ||
+      query_mem_desc.getQueryDescriptionType() !=
+          QueryDescriptionType::GroupByBaselineHash ||
+      query_mem_desc.hasKeylessHash()) {
+    return false;
+  }
+  // Exact quantiles are finalized after reduction and would be computed twice.
+  return std::none_of(
+      ra_exe_unit.target_exprs.begin(),
+      ra_exe_unit.target_exprs.end(),
+      [](const hdk::ir::Expr* expr) {
+        auto agg_expr = dynamic_cast<const hdk::ir::AggExpr*>(expr);
+        return agg_expr && agg_expr->aggType() == hdk::ir::AggType::kQuantile;
+      });
+}
+
 }  // namespace
 
+void Executor::prunePartitionedTopN(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device) {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto& sort_info = ra_exe_unit.sort_info;
+  const size_t top_n = sort_info.limit + sort_info.offset;
+  std::atomic<size_t> pruned_entries{0};
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, results_per_device.size()),
+      [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+          auto& rs = results_per_device[i].first;
+          if (!rs || !rs->getStorage() || rs->getStorageCount() != 1) {
+            continue;
+          }
+          const auto entry_count = rs->entryCount();
+          Permutation permutation(entry_count);
+          PermutationView pv(permutation.data(), 0, permutation.size());
+          pv = rs->initPermutationBuffer(pv, 0, permutation.size());
+          if (pv.size() <= top_n) {
+            continue;
+          }
+          const auto compare =
+              createComparator(rs.get(), sort_info.order_entries, pv, this, true);
+          pv = topPermutation(pv, top_n, compare, true);
+          std::vector<bool> keep(entry_count, false);
+          for (auto entry_idx : pv) {
+            keep[entry_idx] = true;
+          }
+          auto storage = const_cast<ResultSetStorage*>(rs->getStorage());
+          size_t erased = 0;
+          for (size_t entry_idx = 0; entry_idx < entry_count; ++entry_idx) {
+            if (!keep[entry_idx] && !storage->isEmptyEntry(entry_idx)) {
+              storage->eraseEntry(entry_idx);
+              ++erased;
+            }
+          }
+          rs->invalidateCachedRowCount();
+          pruned_entries += erased;
+        }
+      });
+  VLOG(1) << "Pruned " << pruned_entries << " rows not fitting top " << top_n
+          << " rows of their partitions.";
+}
+
 hdk::ResultSetTable Executor::collectAllDeviceResults(
     SharedKernelContext& shared_context,
     const RelAlgExecutionUnit& ra_exe_unit,
@@ -2628,6 +2867,11 @@ hdk::ResultSetTable Executor::collectAllDeviceResults(
   if (ra_exe_unit.partitioned_aggregation && eo.multifrag_result) {
     return get_separate_results(result_per_device);
   }
+  if (result_per_device.size() > 1 &&
+      !use_speculative_top_n(ra_exe_unit, query_mem_desc) &&
+      can_prune_partitioned_top_n(ra_exe_unit, query_mem_desc, getConfig())) {
+    prunePartitionedTopN(ra_exe_unit, result_per_device);
+  }
   if (use_speculative_top_n(ra_exe_unit, query_mem_desc)) {
     try {
       return reduceSpeculativeTopN(
@@ -2679,6 +2923,11 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
 
   fragment_descriptor.buildFragmentKernelMap(
       ra_exe_unit, shared_context.getFragOffsets(), policy, this, co.codegen_traits_desc);
+  if (step_profiler_) {
+    step_profiler_->addFragments(fragment_descriptor.getScannedFragmentCount(),
+                                 fragment_descriptor.getSkippedFragmentCount(),
+                                 fragment_descriptor.getScannedRowCount());
+  }
 
   if (!config_->exec.heterogeneous.enable_heterogeneous_execution && eo.with_watchdog &&
       fragment_descriptor.shouldCheckWorkUnitWatchdog()) {
@@ -2756,7 +3005,13 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
                              const CompilationOptions& co) {
   auto clock_begin = timer_start();
   std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
-  kernel_queue_time_ms_ += timer_stop(clock_begin);
+  const auto kernel_queue_time =
+      timer_stop<std::chrono::steady_clock::time_point, std::chrono::microseconds>(
+          clock_begin);
+  kernel_queue_time_ms_ += kernel_queue_time / 1000;
+  static auto& kernel_queue_seconds = metrics::registry().histogram(
+      "hdk_kernel_queue_seconds", "Time queries wait for the executor kernel lock.");
+  kernel_queue_seconds.observe(kernel_queue_time / 1e6);
 
   tbb::task_group tg;
   // A hack to have unused unit for results collection.
@@ -2783,7 +3038,23 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
             crt_kernel_idx = kernel_idx++] {
       DEBUG_TIMER_NEW_THREAD(parent_thread_id);
       const size_t thread_i = crt_kernel_idx % cpu_threads();
+      static auto& running_kernels = metrics::registry().gauge(
+          "hdk_running_kernels", "Number of currently running execution kernels.");
+      static auto& kernels_total = metrics::registry().counter(
+          "hdk_kernels_total", "Number of executed execution kernels.");
+      running_kernels.add(1);
+      kernels_total.inc();
+      ScopeGuard kernel_finished = [] { running_kernels.sub(1); };
+      auto kernel_start = QueryStepProfiler::Clock::now();
+      std::optional<PerfEventCounters> hw_counters;
+      if (step_profiler_ && step_profiler_->collectHwCounters()) {
+        hw_counters.emplace();
+      }
       kernel->run(this, thread_i, shared_context);
+      if (step_profiler_) {
+        step_profiler_->addKernel(QueryStepProfiler::elapsed(kernel_start),
+                                  hw_counters ? hw_counters->read() : HwCounters{});
+      }
     });
   }
   tg.wait();
@@ -3703,6 +3974,11 @@ Executor::JoinHashTableOrError Executor::buildHashTableForQualifier(
     throw QueryExecutionError(ERR_INTERRUPTED);
   }
   try {
+    auto build_start = QueryStepProfiler::Clock::now();
+    std::optional<PerfEventCounters> hw_counters;
+    if (step_profiler_ && step_profiler_->collectHwCounters()) {
+      hw_counters.emplace();
+    }
     auto tbl = HashJoin::getInstance(qual_bin_oper,
                                      query_infos,
                                      memory_level,
@@ -3714,6 +3990,18 @@ Executor::JoinHashTableOrError Executor::buildHashTableForQualifier(
                                      this,
                                      hashtable_build_dag_map,
                                      table_id_to_node_map);
+    if (step_profiler_) {
+      const auto device_type = memory_level == Data_Namespace::GPU_LEVEL
+                                   ? ExecutorDeviceType::GPU
+                                   : ExecutorDeviceType::CPU;
+      size_t bytes = 0;
+      for (int device_id = 0; device_id < tbl->getDeviceCount(); ++device_id) {
+        bytes += tbl->getJoinHashBufferSize(device_type, device_id);
+      }
+      step_profiler_->addHashTable(QueryStepProfiler::elapsed(build_start),
+                                   bytes,
+                                   hw_counters ? hw_counters->read() : HwCounters{});
+    }
     return {tbl, ""};
   } catch (const HashJoinFail& e) {
     return {nullptr, e.what()};
@@ -57,6 +57,7 @@
 #include "QueryEngine/LoopControlFlow/JoinLoop.h"
 #include "QueryEngine/PlanState.h"
 #include "QueryEngine/QueryPlanDagCache.h"
+#include "QueryEngine/QueryProfile.h"
 #include "QueryEngine/RelAlgExecutionUnit.h"
 #include "QueryEngine/RelAlgTranslator.h"
 #include "QueryEngine/RowFuncBuilder.h"
@@ -85,6 +86,7 @@ class QueryMemoryDescriptor;
 using QueryMemoryDescriptorOwned = std::unique_ptr<QueryMemoryDescriptor>;
 
 class ColumnFetcher;
+struct ReductionCode;
 
 class WatchdogException : public std::runtime_error {
  public:
@@ -309,6 +311,12 @@ class Executor : public StringDictionaryProvider {
       std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
       const bool with_generation) const;
 
+  const std::vector<int32_t>* getStringProxyTransformTranslationMap(
+      const int dict_id,
+      const StringTransformType transform_type,
+      std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+      const bool with_generation) const;
+
   const std::vector<int32_t>* getIntersectionStringProxyTranslationMap(
       const StringDictionary* source_proxy,
       const StringDictionary* dest_proxy,
@@ -348,6 +356,10 @@ class Executor : public StringDictionaryProvider {
 
   const std::shared_ptr<RowSetMemoryOwner> getRowSetMemoryOwner() const;
 
+  // Profiler of the currently executed query step, null unless the query runs in the
+  // EXPLAIN ANALYZE mode.
+  QueryStepProfiler* getStepProfiler() const { return step_profiler_; }
+
   std::shared_ptr<const TableFragmentsInfo> getTableInfo(const int db_id,
                                                          const int table_id) const;
 
@@ -645,6 +657,17 @@ class Executor : public StringDictionaryProvider {
       std::shared_ptr<RowSetMemoryOwner>,
       const QueryMemoryDescriptor&,
       const CompilationOptions&);
+  ResultSetPtr makeBaselineReductionTarget(
+      const ResultSetPtr& src,
+      const size_t entry_count,
+      std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner);
+  ResultSetPtr reduceBaselineResultSetsTree(
+      std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
+      std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+      const ReductionCode& reduction_code);
+  void prunePartitionedTopN(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device);
   ResultSetPtr reduceSpeculativeTopN(
       const RelAlgExecutionUnit&,
       std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& all_fragment_results,
@@ -917,6 +940,8 @@ class Executor : public StringDictionaryProvider {
     ~CgenStateManager();
 
    private:
+    void observeCompilationQueueTime();
+
     Executor& executor_;
     std::chrono::steady_clock::time_point lock_queue_clock_;
     std::lock_guard<std::mutex> lock_;
@@ -994,6 +1019,8 @@ class Executor : public StringDictionaryProvider {
   int64_t kernel_queue_time_ms_ = 0;
   int64_t compilation_queue_time_ms_ = 0;
 
+  QueryStepProfiler* step_profiler_{nullptr};
+
   std::shared_ptr<costmodel::CostModel> cost_model;
 
   // Singleton instance used for an execution unit which is a project with window
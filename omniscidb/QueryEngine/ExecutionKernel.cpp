@@ -123,7 +123,7 @@ SharedKernelContext::getFragmentResults() {
 void ExecutionKernel::run(Executor* executor,
                           const size_t thread_idx,
                           SharedKernelContext& shared_context) {
-  DEBUG_TIMER("ExecutionKernel::run");
+  auto timer = DEBUG_TIMER("ExecutionKernel::run");
   INJECT_TIMER(kernel_run);
   std::optional<logger::QidScopeGuard> qid_scope_guard;
   try {
@@ -36,6 +36,17 @@ FORCE_INLINE uint8_t get_rank(uint64_t x, uint32_t b) {
   return std::min(b, static_cast<uint32_t>(x ? __builtin_clzl(x) : 64)) + 1;
 #endif
 }
+
+struct HllRegisterUpdate {
+  uint32_t index;
+  uint8_t rank;
+};
+
+// Register to update and its new rank for a value with the given hash in a sketch
+// with 2^b registers. Dense and sparse sketches must agree on it to be mergeable.
+FORCE_INLINE HllRegisterUpdate get_hll_register_update(uint64_t hash, uint32_t b) {
+  return {static_cast<uint32_t>(hash >> (64 - b)), get_rank(hash << b, 64 - b)};
+}
 #endif
 
 #endif  // QUERYENGINE_HYPERLOGLOGRT_H
@@ -22,6 +22,7 @@
 #include "QueryEngine/OutputBufferInitialization.h"
 #include "QueryEngine/UsedColumnsCollector.h"
 #include "ResultSet/HyperLogLog.h"
+#include "ResultSet/RoaringSet.h"
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 
@@ -415,6 +416,81 @@ KeylessInfo get_keyless_info(const RelAlgExecutionUnit& ra_exe_unit,
   };
 }
 
+// Roaring sets are compared against the alternatives using the expected number of
+// values per 2^16-wide container, assuming the values of each set are spread over
+// the whole argument range.
+double get_count_distinct_sets_count(const RelAlgExecutionUnit& ra_exe_unit,
+                                     const size_t group_by_slots_count) {
+  if (ra_exe_unit.groupby_exprs.empty() || !ra_exe_unit.groupby_exprs.front()) {
+    return 1.0;
+  }
+  return std::max(static_cast<double>(group_by_slots_count), 1.0);
+}
+
+double get_roaring_container_density(const ColRangeInfo& arg_range_info,
+                                     const std::vector<InputTableInfo>& query_infos,
+                                     const RelAlgExecutionUnit& ra_exe_unit,
+                                     const size_t group_by_slots_count) {
+  size_t max_rows = 0;
+  for (const auto& query_info : query_infos) {
+    max_rows = std::max(max_rows, query_info.info->getNumTuplesUpperBound());
+  }
+  const double sets_count =
+      get_count_distinct_sets_count(ra_exe_unit, group_by_slots_count);
+  const double range = static_cast<double>(arg_range_info.max) -
+                       static_cast<double>(arg_range_info.min) + 1.0;
+  const double values_per_set = std::min(max_rows / sets_count, range);
+  const double containers_per_set = std::max(range / 65536.0, 1.0);
+  return values_per_set / containers_per_set;
+}
+
+CountDistinctImplType choose_roaring_count_distinct_impl(
+    const CountDistinctImplType impl_type,
+    const ColRangeInfo& arg_range_info,
+    const std::vector<InputTableInfo>& query_infos,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const ExecutorDeviceType device_type,
+    const size_t group_by_slots_count,
+    const int64_t bitmap_sz_bits,
+    const GroupByConfig& config) {
+  if (!config.enable_roaring_count_distinct ||
+      arg_range_info.hash_type_ != QueryDescriptionType::GroupByPerfectHash) {
+    return impl_type;
+  }
+  const auto density = get_roaring_container_density(
+      arg_range_info, query_infos, ra_exe_unit, group_by_slots_count);
+  if (impl_type == CountDistinctImplType::HashSet) {
+    return density >= config.roaring_count_distinct_min_density
+               ? CountDistinctImplType::Roaring
+               : impl_type;
+  }
+  // Wide bitmaps are replaced only for CPU execution, switching to a roaring set
+  // would force GPU queries to be retried on CPU. A bitmap costs a bit per value
+  // in the range while an array container costs 16 bits per value actually seen,
+  // so roaring sets are smaller as long as containers are expected to stay arrays.
+  CHECK(impl_type == CountDistinctImplType::Bitmap);
+  const double total_bitmap_bytes =
+      bitmap_bits_to_bytes(bitmap_sz_bits) *
+      get_count_distinct_sets_count(ra_exe_unit, group_by_slots_count);
+  if (device_type == ExecutorDeviceType::CPU &&
+      total_bitmap_bytes >= config.roaring_count_distinct_bitmap_threshold &&
+      density < RoaringSet::kMaxArrayContainerSize) {
+    return CountDistinctImplType::Roaring;
+  }
+  return impl_type;
+}
+
+// Dense HyperLogLog registers are allocated for every group slot upfront, which
+// dominates the memory footprint of group-by queries with many small groups.
+bool use_sparse_hll(const RelAlgExecutionUnit& ra_exe_unit,
+                    const ExecutorDeviceType device_type,
+                    const size_t group_by_slots_count,
+                    const GroupByConfig& config) {
+  return config.enable_sparse_hll && device_type == ExecutorDeviceType::CPU &&
+         !ra_exe_unit.groupby_exprs.empty() && ra_exe_unit.groupby_exprs.front() &&
+         group_by_slots_count >= config.sparse_hll_groups_threshold;
+}
+
 CountDistinctDescriptors init_count_distinct_descriptors(
     const RelAlgExecutionUnit& ra_exe_unit,
     const std::vector<InputTableInfo>& query_infos,
@@ -495,11 +571,33 @@ CountDistinctDescriptors init_count_distinct_descriptors(
           !arg_type->isArray()) {
         count_distinct_impl_type = CountDistinctImplType::Bitmap;
       }
-
+      if (agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct &&
+          count_distinct_impl_type == CountDistinctImplType::Bitmap &&
+          use_sparse_hll(ra_exe_unit,
+                         device_type,
+                         group_by_slots_count,
+                         executor->getConfig().exec.group_by)) {
+        count_distinct_impl_type = CountDistinctImplType::SparseHll;
+      }
+      // The watchdog check goes before the roaring sets selection. Roaring sets
+      // replacing bitmaps are never bigger than the bitmaps, but roaring sets
+      // replacing hash sets are bounded only by the (too wide) values range.
       if (executor->getConfig().exec.watchdog.enable && !(arg_range_info.isEmpty()) &&
           count_distinct_impl_type == CountDistinctImplType::HashSet) {
         throw WatchdogException("Cannot use a fast path for COUNT distinct");
       }
+      if (agg_info.agg_kind == hdk::ir::AggType::kCount && !arg_type->isBuffer()) {
+        count_distinct_impl_type =
+            choose_roaring_count_distinct_impl(count_distinct_impl_type,
+                                               arg_range_info,
+                                               query_infos,
+                                               ra_exe_unit,
+                                               device_type,
+                                               group_by_slots_count,
+                                               bitmap_sz_bits,
+                                               executor->getConfig().exec.group_by);
+      }
+
       const auto sub_bitmap_count =
           get_count_distinct_sub_bitmap_count(bitmap_sz_bits, ra_exe_unit, device_type);
       count_distinct_descriptors.emplace_back(CountDistinctDescriptor{
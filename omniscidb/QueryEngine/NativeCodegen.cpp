@@ -66,6 +66,7 @@ static_assert(false, "LLVM Version >= 15 is required.");
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
+#include "Shared/Metrics.h"
 #include "StreamingTopN.h"
 
 #include <boost/filesystem.hpp>
@@ -198,6 +199,14 @@ CodeCacheKey get_code_cache_key(llvm::Function* query_func, CgenState* cgen_stat
   return key;
 }
 
+void count_code_cache_lookup(const char* device, bool hit) {
+  metrics::registry()
+      .counter("hdk_code_cache_lookups_total",
+               "Lookups of compiled query code in the code cache.",
+               {{"device", device}, {"result", hit ? "hit" : "miss"}})
+      .inc();
+}
+
 }  // namespace
 
 std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
@@ -208,6 +217,10 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
     const CompilationOptions& co) {
   auto key = get_code_cache_key(query_func, cgen_state_.get());
   auto cached_code = cpu_code_accessor->get_value(key);
+  count_code_cache_lookup("CPU", cached_code != nullptr);
+  if (step_profiler_) {
+    step_profiler_->addCodeCacheLookup(cached_code != nullptr);
+  }
   if (cached_code) {
     return cached_code;
   }
@@ -381,7 +394,13 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenGPU(
 
   auto key = get_code_cache_key(query_func, cgen_state_.get());
   auto cached_code = Executor::gpu_code_accessor->get_value(key);
-  if (config_->debug.enable_gpu_code_compilation_cache && cached_code) {
+  const bool use_cached_code =
+      config_->debug.enable_gpu_code_compilation_cache && cached_code;
+  count_code_cache_lookup("GPU", use_cached_code);
+  if (step_profiler_) {
+    step_profiler_->addCodeCacheLookup(use_cached_code);
+  }
+  if (use_cached_code) {
     return cached_code;
   }
 
@@ -1488,6 +1507,8 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
       const auto& count_distinct_descriptor =
           query_mem_desc->getCountDistinctDescriptor(i);
       if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::HashSet ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::Roaring ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::SparseHll ||
           (count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid &&
            !co.hoist_literals)) {
         throw QueryMustRunOnCpu();
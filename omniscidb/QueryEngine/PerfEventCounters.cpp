@@ -0,0 +1,145 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "PerfEventCounters.h"
+
+#include "Logger/Logger.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+
+// Cache misses are mapped to the last level cache misses by the kernel for most CPUs.
+constexpr std::array<uint64_t, 4> kHwEvents = {PERF_COUNT_HW_CPU_CYCLES,
+                                               PERF_COUNT_HW_INSTRUCTIONS,
+                                               PERF_COUNT_HW_CACHE_MISSES,
+                                               PERF_COUNT_HW_BRANCH_MISSES};
+
+int open_hw_event(uint64_t event) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = event;
+  attr.inherit = 1;
+  // User space only counting is allowed with perf_event_paranoid up to 2.
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+uint64_t read_hw_event(int fd) {
+  struct {
+    uint64_t value;
+    uint64_t time_enabled;
+    uint64_t time_running;
+  } data;
+  if (fd < 0 || ::read(fd, &data, sizeof(data)) != sizeof(data) || !data.time_running) {
+    return 0;
+  }
+  // Scale the value if the counter was multiplexed with other events.
+  if (data.time_running < data.time_enabled) {
+    return static_cast<uint64_t>(static_cast<double>(data.value) * data.time_enabled /
+                                 data.time_running);
+  }
+  return data.value;
+}
+
+bool check_availability() {
+  int fd = open_hw_event(PERF_COUNT_HW_CPU_CYCLES);
+  if (fd < 0) {
+    LOG(WARNING) << "Hardware performance counters are not available: "
+                 << strerror(errno)
+                 << ". Check /proc/sys/kernel/perf_event_paranoid setting.";
+    return false;
+  }
+  close(fd);
+  return true;
+}
+
+#else
+
+bool check_availability() {
+  LOG(WARNING) << "Hardware performance counters are not supported on this platform.";
+  return false;
+}
+
+#endif
+
+}  // namespace
+
+HwCounters& HwCounters::operator+=(const HwCounters& other) {
+  measurements += other.measurements;
+  cycles += other.cycles;
+  instructions += other.instructions;
+  llc_misses += other.llc_misses;
+  branch_misses += other.branch_misses;
+  return *this;
+}
+
+std::string HwCounters::toString() const {
+  std::stringstream ss;
+  ss << "cycles: " << cycles << ", instructions: " << instructions;
+  if (cycles) {
+    ss << " (IPC " << static_cast<double>(instructions) / cycles << ")";
+  }
+  ss << ", LLC misses: " << llc_misses << ", branch misses: " << branch_misses;
+  return ss.str();
+}
+
+PerfEventCounters::PerfEventCounters() {
+  fds_.fill(-1);
+#ifdef __linux__
+  if (isAvailable()) {
+    for (size_t i = 0; i < fds_.size(); ++i) {
+      // Some events might be missing, e.g. in virtual machines.
+      fds_[i] = open_hw_event(kHwEvents[i]);
+    }
+  }
+#endif
+}
+
+PerfEventCounters::~PerfEventCounters() {
+#ifdef __linux__
+  for (auto fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+HwCounters PerfEventCounters::read() const {
+  HwCounters res;
+#ifdef __linux__
+  if (fds_[0] < 0) {
+    return res;
+  }
+  res.measurements = 1;
+  res.cycles = read_hw_event(fds_[0]);
+  res.instructions = read_hw_event(fds_[1]);
+  res.llc_misses = read_hw_event(fds_[2]);
+  res.branch_misses = read_hw_event(fds_[3]);
+#endif
+  return res;
+}
+
+bool PerfEventCounters::isAvailable() {
+  static const bool available = check_availability();
+  return available;
+}
@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/**
+ * Values of hardware performance counters summed over a number of measured
+ * regions. Counters not supported by the system stay zero.
+ */
+struct HwCounters {
+  size_t measurements{0};
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t llc_misses{0};
+  uint64_t branch_misses{0};
+
+  HwCounters& operator+=(const HwCounters& other);
+  std::string toString() const;
+};
+
+/**
+ * Counts hardware events of the calling thread (and threads it creates afterwards)
+ * using perf_event_open from the construction until read() is called. Counters are
+ * not opened when perf events are not available, e.g. forbidden by
+ * perf_event_paranoid or not supported by the platform, and read() returns an empty
+ * result then.
+ */
+class PerfEventCounters {
+ public:
+  PerfEventCounters();
+  ~PerfEventCounters();
+
+  PerfEventCounters(const PerfEventCounters&) = delete;
+  PerfEventCounters& operator=(const PerfEventCounters&) = delete;
+
+  HwCounters read() const;
+
+  // Availability is checked once per process, the reason is logged on failure.
+  static bool isAvailable();
+
+ private:
+  std::array<int, 4> fds_;
+};
@@ -43,6 +43,12 @@ int64_t g_bitmap_memory_limit{8LL * 1000 * 1000 * 1000};
 
 namespace {
 
+// Deferred count distinct buffer sizes use negative values to mark sets which are
+// allocated on the heap rather than carved out of the bitmap memory.
+constexpr int64_t kHashSetMarker = -1;
+constexpr int64_t kRoaringSetMarker = -2;
+constexpr int64_t kSparseHllMarker = -3;
+
 inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc) {
   const int32_t groups_buffer_entry_count = query_mem_desc.getEntryCount();
   checked_int64_t total_bytes_per_group = 0;
@@ -704,8 +710,15 @@ void QueryMemoryInitializer::initColumnsPerRow(
       // COUNT DISTINCT / APPROX_COUNT_DISTINCT
       CHECK_EQ(static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(col_idx)),
                sizeof(int64_t));
-      init_val =
-          bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz) : allocateCountDistinctSet();
+      if (bm_sz > 0) {
+        init_val = allocateCountDistinctBitmap(bm_sz);
+      } else if (bm_sz == kRoaringSetMarker) {
+        init_val = allocateCountDistinctRoaringSet();
+      } else if (bm_sz == kSparseHllMarker) {
+        init_val = allocateCountDistinctSparseHll();
+      } else {
+        init_val = allocateCountDistinctSet();
+      }
       ++init_vec_idx;
     } else if (query_mem_desc.isGroupBy() && quantile_params[col_idx]) {
       auto agg_type = quantile_params[col_idx]->first;
@@ -816,10 +829,22 @@ std::vector<int64_t> QueryMemoryInitializer::allocateCountDistinctBuffers(
         } else {
           init_agg_vals_[agg_col_idx] = allocateCountDistinctBitmap(bitmap_byte_sz);
         }
+      } else if (count_distinct_desc.impl_type_ == CountDistinctImplType::Roaring) {
+        if (deferred) {
+          agg_bitmap_size[agg_col_idx] = kRoaringSetMarker;
+        } else {
+          init_agg_vals_[agg_col_idx] = allocateCountDistinctRoaringSet();
+        }
+      } else if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll) {
+        if (deferred) {
+          agg_bitmap_size[agg_col_idx] = kSparseHllMarker;
+        } else {
+          init_agg_vals_[agg_col_idx] = allocateCountDistinctSparseHll();
+        }
       } else {
         CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet);
         if (deferred) {
-          agg_bitmap_size[agg_col_idx] = -1;
+          agg_bitmap_size[agg_col_idx] = kHashSetMarker;
         } else {
           init_agg_vals_[agg_col_idx] = allocateCountDistinctSet();
         }
@@ -849,6 +874,18 @@ int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
+int64_t QueryMemoryInitializer::allocateCountDistinctRoaringSet() {
+  auto count_distinct_set = new RoaringSet();
+  row_set_mem_owner_->addCountDistinctRoaringSet(count_distinct_set);
+  return reinterpret_cast<int64_t>(count_distinct_set);
+}
+
+int64_t QueryMemoryInitializer::allocateCountDistinctSparseHll() {
+  auto count_distinct_sketch = new SparseHll();
+  row_set_mem_owner_->addCountDistinctSparseHll(count_distinct_sketch);
+  return reinterpret_cast<int64_t>(count_distinct_sketch);
+}
+
 std::vector<QueryMemoryInitializer::QuantileParam>
 QueryMemoryInitializer::allocateQuantiles(const QueryMemoryDescriptor& query_mem_desc,
                                           const bool deferred,
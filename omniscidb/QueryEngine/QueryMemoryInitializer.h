@@ -142,6 +142,10 @@ class QueryMemoryInitializer {
 
   int64_t allocateCountDistinctSet();
 
+  int64_t allocateCountDistinctRoaringSet();
+
+  int64_t allocateCountDistinctSparseHll();
+
   std::vector<QuantileParam> allocateQuantiles(
       const QueryMemoryDescriptor& query_mem_desc,
       const bool deferred,
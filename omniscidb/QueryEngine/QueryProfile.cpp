@@ -0,0 +1,193 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "QueryProfile.h"
+
+#include "IR/Node.h"
+
+#include <boost/core/demangle.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+
+namespace {
+
+std::string node_kind(const hdk::ir::Node* node) {
+  auto name = boost::core::demangle(typeid(*node).name());
+  auto pos = name.rfind("::");
+  return pos == std::string::npos ? name : name.substr(pos + 2);
+}
+
+struct FormatTime {
+  int64_t time;
+};
+
+std::ostream& operator<<(std::ostream& os, const FormatTime& t) {
+  return os << std::fixed << std::setprecision(3) << t.time / 1000.0 << " ms";
+}
+
+}  // namespace
+
+std::string QueryStepProfile::toString() const {
+  std::stringstream ss;
+  ss << node_kind << " #" << node_id;
+  if (!device_type.empty()) {
+    ss << " [" << device_type << "]";
+  }
+  ss << ": " << FormatTime{total_time} << "\n";
+  if (!work_units) {
+    return ss.str();
+  }
+  ss << "  work units: " << work_units << ", kernels: " << kernels << " (total "
+     << FormatTime{kernel_time} << ", max " << FormatTime{max_kernel_time} << ")\n";
+  ss << "  compilation: " << FormatTime{compilation_time}
+     << ", code cache hits: " << code_cache_hits << ", misses: " << code_cache_misses
+     << "\n";
+  ss << "  fragments: " << fragments_scanned << " scanned, " << fragments_skipped
+     << " skipped, rows in: " << input_rows << ", rows out: " << output_rows << "\n";
+  if (hash_tables) {
+    ss << "  hash tables: " << hash_tables << " built in "
+       << FormatTime{hash_table_build_time} << ", " << hash_table_bytes << " bytes\n";
+  }
+  if (groupby_buffer_entries) {
+    ss << "  group-by buffer: " << groupby_buffer_entries << " entries";
+    if (groupby_buffer_retries) {
+      ss << ", retried " << groupby_buffer_retries << " times";
+    }
+    ss << "\n";
+  }
+  if (groupby_partitions) {
+    ss << "  partitioned aggregation: " << groupby_partitions << " partitions"
+       << (groupby_skewed_partitions ? ", skewed" : "") << "\n";
+  }
+  if (!query_desc_type.empty()) {
+    ss << "  layout: " << query_desc_type << " ("
+       << (output_columnar ? "columnar" : "row-wise") << ")\n";
+  }
+  if (reduction_time) {
+    ss << "  reduction: " << FormatTime{reduction_time} << "\n";
+  }
+  if (sort_time) {
+    ss << "  sort: " << FormatTime{sort_time} << "\n";
+  }
+  ss << "  fetched: CPU " << fetched_bytes[Data_Namespace::CPU_LEVEL] << " bytes, GPU "
+     << fetched_bytes[Data_Namespace::GPU_LEVEL] << " bytes\n";
+  if (kernel_hw_counters.measurements) {
+    ss << "  kernels hw: " << kernel_hw_counters.toString() << "\n";
+  }
+  if (hash_table_hw_counters.measurements) {
+    ss << "  hash tables hw: " << hash_table_hw_counters.toString() << "\n";
+  }
+  return ss.str();
+}
+
+int64_t QueryProfile::totalTime() const {
+  int64_t res = 0;
+  for (auto& step : steps) {
+    res += step.total_time;
+  }
+  return res;
+}
+
+std::string QueryProfile::toString() const {
+  std::stringstream ss;
+  for (size_t i = 0; i < steps.size(); ++i) {
+    ss << "Step " << (i + 1) << ": " << steps[i].toString();
+  }
+  ss << "Total: " << FormatTime{totalTime()} << "\n";
+  return ss.str();
+}
+
+QueryStepProfiler::QueryStepProfiler(const hdk::ir::Node* node, bool collect_hw_counters)
+    : collect_hw_counters_(collect_hw_counters), start_(Clock::now()) {
+  profile_.node_id = node->getId();
+  profile_.node_kind = node_kind(node);
+}
+
+void QueryStepProfiler::addWorkUnit() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++profile_.work_units;
+}
+
+void QueryStepProfiler::addCompilation(int64_t time, const std::string& device_type) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.compilation_time += time;
+  profile_.device_type = device_type;
+}
+
+void QueryStepProfiler::addCodeCacheLookup(bool hit) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++(hit ? profile_.code_cache_hits : profile_.code_cache_misses);
+}
+
+void QueryStepProfiler::setMemoryLayout(const std::string& query_desc_type,
+                                        bool output_columnar) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.query_desc_type = query_desc_type;
+  profile_.output_columnar = output_columnar;
+}
+
+void QueryStepProfiler::addFragments(size_t scanned, size_t skipped, size_t rows) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.fragments_scanned += scanned;
+  profile_.fragments_skipped += skipped;
+  profile_.input_rows += rows;
+}
+
+void QueryStepProfiler::addKernel(int64_t time, const HwCounters& hw_counters) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++profile_.kernels;
+  profile_.kernel_time += time;
+  profile_.max_kernel_time = std::max(profile_.max_kernel_time, time);
+  profile_.kernel_hw_counters += hw_counters;
+}
+
+void QueryStepProfiler::addHashTable(int64_t time,
+                                     size_t bytes,
+                                     const HwCounters& hw_counters) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++profile_.hash_tables;
+  profile_.hash_table_build_time += time;
+  profile_.hash_table_bytes += bytes;
+  profile_.hash_table_hw_counters += hw_counters;
+}
+
+void QueryStepProfiler::setGroupByBuffer(size_t entries, size_t retries) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.groupby_buffer_entries = entries;
+  profile_.groupby_buffer_retries += retries;
+}
+
+void QueryStepProfiler::setGroupByPartitions(size_t partitions, bool skewed) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.groupby_partitions = partitions;
+  profile_.groupby_skewed_partitions = skewed;
+}
+
+void QueryStepProfiler::addReduction(int64_t time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.reduction_time += time;
+}
+
+void QueryStepProfiler::addSort(int64_t time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.sort_time += time;
+}
+
+void QueryStepProfiler::addFetchedBytes(Data_Namespace::MemoryLevel memory_level,
+                                        size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.fetched_bytes[memory_level] += bytes;
+}
+
+QueryStepProfile QueryStepProfiler::finish(size_t output_rows) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.output_rows = output_rows;
+  profile_.total_time = elapsed(start_);
+  return profile_;
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "DataMgr/MemoryLevel.h"
+#include "QueryEngine/PerfEventCounters.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hdk::ir {
+class Node;
+}
+
+/**
+ * Runtime statistics of a single query step collected in the EXPLAIN ANALYZE mode.
+ * Counters are summed over all work units executed for the step, which includes
+ * pre-passes such as the filtered count or the cardinality estimation. All times
+ * are in microseconds.
+ */
+struct QueryStepProfile {
+  unsigned node_id{0};
+  std::string node_kind;
+  std::string device_type;
+  size_t work_units{0};
+  int64_t total_time{0};
+  int64_t compilation_time{0};
+  size_t code_cache_hits{0};
+  size_t code_cache_misses{0};
+  size_t fragments_scanned{0};
+  size_t fragments_skipped{0};
+  size_t input_rows{0};
+  size_t output_rows{0};
+  size_t kernels{0};
+  int64_t kernel_time{0};
+  int64_t max_kernel_time{0};
+  size_t hash_tables{0};
+  int64_t hash_table_build_time{0};
+  size_t hash_table_bytes{0};
+  // Entry count of the group-by buffer used by the last successful execution and
+  // the number of re-executions after running out of slots or memory.
+  size_t groupby_buffer_entries{0};
+  size_t groupby_buffer_retries{0};
+  // Number of partitions used by the partitioned aggregation and whether the
+  // skewed partitions were detected and their buffers sized by NDV estimation.
+  size_t groupby_partitions{0};
+  bool groupby_skewed_partitions{false};
+  std::string query_desc_type;
+  bool output_columnar{false};
+  int64_t reduction_time{0};
+  int64_t sort_time{0};
+  // Bytes of input chunks fetched for kernels per memory level.
+  std::array<size_t, 3> fetched_bytes{0, 0, 0};
+  // Hardware counters are collected only when enabled by configuration.
+  HwCounters kernel_hw_counters;
+  HwCounters hash_table_hw_counters;
+
+  std::string toString() const;
+};
+
+struct QueryProfile {
+  std::vector<QueryStepProfile> steps;
+
+  int64_t totalTime() const;
+  std::string toString() const;
+};
+
+using QueryProfilePtr = std::shared_ptr<QueryProfile>;
+
+/**
+ * Collects QueryStepProfile for the currently executed step. The executor holds
+ * a pointer to the active profiler and all the reporting methods can be called
+ * concurrently from kernel threads.
+ */
+class QueryStepProfiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  QueryStepProfiler(const hdk::ir::Node* node, bool collect_hw_counters = false);
+
+  static int64_t elapsed(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start)
+        .count();
+  }
+
+  bool collectHwCounters() const { return collect_hw_counters_; }
+
+  void addWorkUnit();
+  void addCompilation(int64_t time, const std::string& device_type);
+  void addCodeCacheLookup(bool hit);
+  void setMemoryLayout(const std::string& query_desc_type, bool output_columnar);
+  void addFragments(size_t scanned, size_t skipped, size_t rows);
+  void addKernel(int64_t time, const HwCounters& hw_counters = {});
+  void addHashTable(int64_t time, size_t bytes, const HwCounters& hw_counters = {});
+  void setGroupByBuffer(size_t entries, size_t retries);
+  void setGroupByPartitions(size_t partitions, bool skewed);
+  void addReduction(int64_t time);
+  void addSort(int64_t time);
+  void addFetchedBytes(Data_Namespace::MemoryLevel memory_level, size_t bytes);
+
+  QueryStepProfile finish(size_t output_rows);
+
+ private:
+  std::mutex mutex_;
+  const bool collect_hw_counters_;
+  Clock::time_point start_;
+  QueryStepProfile profile_;
+};
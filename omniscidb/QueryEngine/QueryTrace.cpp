@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "QueryTrace.h"
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+namespace {
+
+// Failure to write a trace is reported but doesn't fail the query.
+void write_query_trace(const std::string& trace, const Config& config) {
+  static std::atomic<size_t> trace_counter{0};
+  const auto& dir = config.debug.query_trace_dir.empty() ? config.debug.log_dir
+                                                          : config.debug.query_trace_dir;
+  const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+  auto path = boost::filesystem::path(dir) /
+              ("query_trace_" + std::to_string(now_ms) + "_" +
+               std::to_string(trace_counter++) + ".json");
+  try {
+    boost::filesystem::create_directories(dir);
+  } catch (const boost::filesystem::filesystem_error& e) {
+    LOG(WARNING) << "Cannot create query trace directory: " << e.what();
+    return;
+  }
+  std::ofstream out(path.string());
+  out << trace;
+  out.close();
+  if (out.fail()) {
+    LOG(WARNING) << "Cannot write query trace to " << path.string();
+    return;
+  }
+  LOG(INFO) << "Query trace written to " << path.string();
+}
+
+}  // namespace
+
+QueryTrace::QueryTrace(const Config& config,
+                       bool enable,
+                       char const* file,
+                       int line,
+                       char const* name)
+    : config_(config), enable_(enable), timer_(logger::INFO, file, line, name, enable) {}
+
+QueryTrace::~QueryTrace() {
+  if (enable_) {
+    // The trace is empty if the region is nested into another timer.
+    auto trace = timer_.stopAndGetChromeTrace();
+    if (!trace.empty()) {
+      write_query_trace(trace, config_);
+    }
+  }
+}
@@ -0,0 +1,32 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "Logger/Logger.h"
+#include "Shared/Config.h"
+
+/**
+ * Root timer of a traced region. When enabled, the timer is forced, so it records all
+ * nested timers, and its tree is written in the Chrome trace event format to the
+ * query trace directory on destruction. A region nested into another running trace
+ * doesn't write anything, its timers become a part of the outer trace. It allows
+ * callers to extend the trace of a query, e.g. to the result conversion.
+ */
+class QueryTrace {
+ public:
+  QueryTrace(const Config& config,
+             bool enable,
+             char const* file,
+             int line,
+             char const* name);
+  ~QueryTrace();
+
+ private:
+  const Config& config_;
+  const bool enable_;
+  logger::DebugTimer timer_;
+};
@@ -30,6 +30,7 @@
 #include "QueryEngine/MemoryLayoutBuilder.h"
 #include "QueryEngine/QueryPhysicalInputsCollector.h"
 #include "QueryEngine/QueryPlanDagExtractor.h"
+#include "QueryEngine/QueryTrace.h"
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RelAlgDagBuilder.h"
 #include "QueryEngine/RelAlgTranslator.h"
@@ -104,7 +105,8 @@ RelAlgExecutor::RelAlgExecutor(Executor* executor, SchemaProviderPtr schema_prov
     , data_provider_(executor->getDataMgr()->getDataProvider())
     , config_(executor_->getConfig())
     , now_(0)
-    , queue_time_ms_(0) {
+    , queue_time_ms_(0)
+    , reduction_time_ms_(0) {
   rs_registry_ = hdk::ResultSetRegistry::getOrCreate(executor->getDataMgr(),
                                                      executor->getConfigPtr());
 }
@@ -118,7 +120,8 @@ RelAlgExecutor::RelAlgExecutor(Executor* executor,
     , data_provider_(executor->getDataMgr()->getDataProvider())
     , config_(executor_->getConfig())
     , now_(0)
-    , queue_time_ms_(0) {
+    , queue_time_ms_(0)
+    , reduction_time_ms_(0) {
   rs_registry_ = hdk::ResultSetRegistry::getOrCreate(executor->getDataMgr(),
                                                      executor->getConfigPtr());
 
@@ -159,11 +162,20 @@ ExecutionResult RelAlgExecutor::executeRelAlgQuery(const CompilationOptions& co,
                                                    const ExecutionOptions& eo,
                                                    const bool just_explain_plan) {
   CHECK(query_dag_);
-  auto timer = DEBUG_TIMER(__func__);
+  QueryTrace trace(config_, eo.query_trace, __FILE__, __LINE__, __func__);
   INJECT_TIMER(executeRelAlgQuery);
 
   auto run_query = [&](const CompilationOptions& co_in) {
+    reduction_time_ms_ = 0;
     auto execution_result = executeRelAlgQueryNoRetry(co_in, eo, just_explain_plan);
+    const auto reduction_time_ms = reduction_time_ms_;
+    if (eo.explain_analyze && profile_) {
+      // EXPLAIN ANALYZE returns the collected profile instead of the query result.
+      auto rs = std::make_shared<ResultSet>(profile_->toString());
+      execution_result = registerResultSetTable({rs}, {}, true);
+      execution_result.setProfile(profile_);
+    }
+    execution_result.setReductionTime(reduction_time_ms);
 
     constexpr bool vlog_result_set_summary{false};
     if constexpr (vlog_result_set_summary) {
@@ -220,6 +232,9 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
 
   query_dag_->resetQueryExecutionState();
   const auto ra = query_dag_->getRootNode();
+  profile_ = eo.explain_analyze && !just_explain_plan && !eo.just_explain
+                 ? std::make_shared<QueryProfile>()
+                 : nullptr;
 
   // capture the lock acquistion time
   auto clock_begin = timer_start();
@@ -282,8 +297,10 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
     }
 
     RelAlgExecutor ra_executor(executor_, schema_provider_);
+    ra_executor.profile_ = profile_;
     hdk::QueryExecutionSequence subquery_seq(subquery_ra, executor_->getConfigPtr());
     ra_executor.execute(subquery_seq, co, eo, 0);
+    reduction_time_ms_ += ra_executor.reduction_time_ms_;
   }
 
   auto shared_res = execute(query_seq, co, eo, queue_time_ms);
@@ -394,6 +411,9 @@ std::shared_ptr<const ExecutionResult> RelAlgExecutor::execute(
 
   time(&now_);
   CHECK(seq.size());
+  if (eo.explain_analyze && !eo.just_explain && !profile_) {
+    profile_ = std::make_shared<QueryProfile>();
+  }
 
   auto get_descriptor_count = [&seq, &eo]() -> size_t {
     if (eo.just_explain) {
@@ -429,6 +449,14 @@ std::shared_ptr<const ExecutionResult> RelAlgExecutor::execute(
       }
     }
     auto fixed_eo = eo.with_multifrag_result(multifrag_result);
+    std::unique_ptr<QueryStepProfiler> step_profiler;
+    if (profile_) {
+      step_profiler = std::make_unique<QueryStepProfiler>(
+          seq.step(i),
+          config_.debug.enable_perf_counters && PerfEventCounters::isAvailable());
+      executor_->step_profiler_ = step_profiler.get();
+    }
+    ScopeGuard reset_step_profiler = [this] { executor_->step_profiler_ = nullptr; };
     try {
       executeStep(seq.step(i), co, fixed_eo, queue_time_ms);
     } catch (const QueryMustRunOnCpu&) {
@@ -448,8 +476,17 @@ std::shared_ptr<const ExecutionResult> RelAlgExecutor::execute(
       eo_extern.executor_type = ::ExecutorType::Extern;
       executeStep(seq.step(i), co, eo_extern, queue_time_ms);
     } catch (const RequestPartitionedAggregation& e) {
-      executeStepWithPartitionedAggregation(
-          seq.step(i), co, eo, e.estimatedBufferSize(), queue_time_ms);
+      executeStepWithPartitionedAggregation(seq.step(i),
+                                            co,
+                                            eo,
+                                            e.estimatedBufferSize(),
+                                            e.estimatedBufferEntries(),
+                                            queue_time_ms);
+    }
+    if (step_profiler) {
+      auto step_res = seq.step(i)->getResult();
+      auto token = step_res ? step_res->getToken() : nullptr;
+      profile_->steps.push_back(step_profiler->finish(token ? token->rowCount() : 0));
     }
   }
 
@@ -688,11 +725,13 @@ hdk::ir::ExprPtr translate(const hdk::ir::Expr* expr,
   return res;
 }
 
-void RelAlgExecutor::executeStepWithPartitionedAggregation(const hdk::ir::Node* step_root,
-                                                           const CompilationOptions& co,
-                                                           const ExecutionOptions& eo,
-                                                           size_t estimated_buffer_size,
-                                                           const int64_t queue_time_ms) {
+void RelAlgExecutor::executeStepWithPartitionedAggregation(
+    const hdk::ir::Node* step_root,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    size_t estimated_buffer_size,
+    size_t estimated_buffer_entries,
+    const int64_t queue_time_ms) {
   auto sort = step_root->as<hdk::ir::Sort>();
   auto agg = sort ? sort->getInput(0)->as<hdk::ir::Aggregate>()
                   : step_root->as<hdk::ir::Aggregate>();
@@ -813,7 +852,36 @@ void RelAlgExecutor::executeStepWithPartitionedAggregation(const hdk::ir::Node*
           ->getStorage()
           ->getUnderlyingBuffer());
   auto max_partition_size = *std::max_element(size_buf, size_buf + partitions);
-  part_agg->setBufferEntryCountHint(max_partition_size * 2);
+  size_t entry_count_hint = max_partition_size * 2;
+  bool skewed_partitions = false;
+  // Hash partitioning spreads distinct keys evenly across partitions even when rows
+  // are not, so with skewed data (few heavy-hitter keys holding most of the rows)
+  // the biggest partition size is a poor estimation of its groups count. Use NDV
+  // estimation in this case to avoid allocation of huge mostly empty buffers.
+  // NDV estimation might be too low, so the smaller buffer is used only when the step
+  // can be retried with a grown buffer after running out of slots.
+  if (config_.exec.group_by.enable_skew_aware_partitioning &&
+      config_.exec.group_by.enable_adaptive_groupby && estimated_buffer_entries) {
+    auto total_rows = std::accumulate(size_buf, size_buf + partitions, uint64_t(0));
+    auto avg_partition_size = std::max(total_rows / partitions, uint64_t(1));
+    if (max_partition_size >
+        avg_partition_size * config_.exec.group_by.partitioning_skew_threshold) {
+      // Leave 2x room for uneven distribution of keys by the hash function.
+      auto ndv_hint =
+          std::max(estimated_buffer_entries * 2 / partitions,
+                   config_.exec.group_by.default_max_groups_buffer_entry_guess);
+      VLOG(1) << "Detected skewed partitions (max partition size is "
+              << max_partition_size << " rows, average partition size is "
+              << avg_partition_size << " rows). Use NDV-based entry count hint "
+              << ndv_hint;
+      entry_count_hint = std::min(entry_count_hint, ndv_hint);
+      skewed_partitions = true;
+    }
+  }
+  if (auto profiler = executor_->getStepProfiler()) {
+    profiler->setGroupByPartitions(partitions, skewed_partitions);
+  }
+  part_agg->setBufferEntryCountHint(entry_count_hint);
   VLOG(1) << "Using buffer entry count hint for partitioned aggregation: "
           << part_agg->bufferEntryCountHint();
   hdk::ir::NodePtr new_root = part_agg;
@@ -991,10 +1059,14 @@ ExecutionResult RelAlgExecutor::executeStep(const hdk::ir::Node* step_root,
     if (sort->collationCount() != 0 && !rows_to_sort->definitelyHasNoRows() &&
         !use_speculative_top_n(work_unit.exe_unit, rows_to_sort->getQueryMemDesc())) {
       const size_t top_n = limit == 0 ? 0 : limit + offset;
+      auto sort_start = QueryStepProfiler::Clock::now();
       sortResultSet(rows_to_sort.get(),
                     work_unit.exe_unit.sort_info.order_entries,
                     top_n,
                     executor_);
+      if (auto profiler = executor_->getStepProfiler()) {
+        profiler->addSort(QueryStepProfiler::elapsed(sort_start));
+      }
     }
     if (limit || offset) {
       rows_to_sort->dropFirstN(offset);
@@ -1382,11 +1454,24 @@ void maybeRequestPartitionedAggregation(const RelAlgExecutionUnit& ra_exe_unit,
       entry_size += expr->type()->canonicalSize();
     }
   }
-  if (estimated_buffer_entries * entry_size <
+  auto table_meta =
+      data_provider->getTableMetadata(ra_exe_unit.input_descs[0].getDatabaseId(),
+                                      ra_exe_unit.input_descs[0].getTableId());
+  // Kernel per fragment execution allocates an output buffer for each thread and then
+  // reduces them. Take all these copies into account because they might be much
+  // bigger than a single partitioned buffer.
+  size_t buffers_count = 1;
+  if (config.exec.group_by.enable_skew_aware_partitioning) {
+    buffers_count = std::min(table_meta->fragments.size(),
+                             static_cast<size_t>(std::max(cpu_threads(), 1)));
+    buffers_count = std::max(buffers_count, size_t(1));
+  }
+  if (estimated_buffer_entries * entry_size * buffers_count <
       config.exec.group_by.partitioning_buffer_size_threshold) {
     VLOG(1)
         << "Drop partitioned aggregation option due to the small output buffer size of "
-        << (estimated_buffer_entries * entry_size) << " bytes. Threshold value is "
+        << (estimated_buffer_entries * entry_size) << " bytes (" << buffers_count
+        << " buffer copies). Threshold value is "
         << config.exec.group_by.partitioning_buffer_size_threshold;
     return;
   }
@@ -1396,9 +1481,6 @@ void maybeRequestPartitionedAggregation(const RelAlgExecutionUnit& ra_exe_unit,
   // rows to be aggregated, so simply use the size of the outermost table.
   // Number entries is 2x of the estimated number of groups. Use partitioning if we
   // expect less than the configured threshold number of rows per each group in average.
-  auto table_meta =
-      data_provider->getTableMetadata(ra_exe_unit.input_descs[0].getDatabaseId(),
-                                      ra_exe_unit.input_descs[0].getTableId());
   if (table_meta->getNumTuples() * 2 <
       estimated_buffer_entries * config.exec.group_by.partitioning_group_size_threshold) {
     LOG(INFO) << "Requesting partitioned aggregation (entries="
@@ -1486,6 +1568,7 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   }
 
   ExecutionResult result;
+  auto cache_key = ra_exec_unit_desc_for_caching(ra_exe_unit);
   auto execute_and_handle_errors = [&](const auto max_groups_buffer_entry_guess_in,
                                        const bool has_cardinality_estimation,
                                        const bool has_ndv_estimation) -> ExecutionResult {
@@ -1504,12 +1587,17 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
                                                  data_provider_,
                                                  column_cache);
       rs_table.setQueueTime(queue_time_ms);
+      setGroupByBufferProfile(ra_exe_unit, local_groups_buffer_entry_guess, 0);
       return registerResultSetTable(rs_table, targets_meta, eo.just_explain);
     } catch (const QueryExecutionError& e) {
       if (!has_ndv_estimation && e.getErrorCode() < 0) {
         throw CardinalityEstimationRequired(/*range=*/0);
       }
-      handlePersistentError(e.getErrorCode());
+      // The estimation turned out to be too low. Instead of failing the query, let
+      // the retry path grow the buffer.
+      if (!canGrowGroupByBuffer(e.getErrorCode(), is_agg, co)) {
+        handlePersistentError(e.getErrorCode());
+      }
       return handleOutOfMemoryRetry(
           {ra_exe_unit, work_unit.body, local_groups_buffer_entry_guess},
           targets_meta,
@@ -1517,11 +1605,11 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
           co,
           eo,
           e.wasMultifragKernelLaunch(),
-          queue_time_ms);
+          queue_time_ms,
+          cache_key);
     }
   };
 
-  auto cache_key = ra_exec_unit_desc_for_caching(ra_exe_unit);
   try {
     auto cached_cardinality = executor_->getCachedCardinality(cache_key);
     auto card = cached_cardinality.second;
@@ -1559,7 +1647,9 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
           ra_exe_unit, estimated_groups_buffer_entry_guess, co, data_provider_, config_);
       result = execute_and_handle_errors(
           estimated_groups_buffer_entry_guess, true, /*has_ndv_estimation=*/true);
-      if (!(eo.just_validate || eo.just_explain)) {
+      // Don't override the observed cardinality put into the cache by the execution.
+      if (!(eo.just_validate || eo.just_explain) &&
+          !executor_->getCachedCardinality(cache_key).first) {
         executor_->addToCardinalityCache(cache_key, estimated_groups_buffer_entry_guess);
       }
     }
@@ -1659,7 +1749,8 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
     const CompilationOptions& co,
     const ExecutionOptions& eo,
     const bool was_multifrag_kernel_launch,
-    const int64_t queue_time_ms) {
+    const int64_t queue_time_ms,
+    const std::string& cache_key) {
   // Disable the bump allocator
   // Note that this will have basically the same affect as using the bump allocator
   // for the kernel per fragment path. Need to unify the max_groups_buffer_entry_guess
@@ -1669,6 +1760,7 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   hdk::ResultSetTable result;
   const auto table_infos = get_table_infos(ra_exe_unit_in, executor_);
   auto max_groups_buffer_entry_guess = work_unit.max_groups_buffer_entry_guess;
+  size_t retries = 0;
   const ExecutionOptions eo_no_multifrag = [&]() {
     ExecutionOptions copy = eo;
     copy.allow_multifrag = false;
@@ -1687,6 +1779,7 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
       const auto ra_exe_unit = decide_approx_count_distinct_implementation(
           ra_exe_unit_in, table_infos, executor_, co.device_type, target_exprs_owned_);
       ColumnCacheMap column_cache;
+      ++retries;
       result = executor_->executeWorkUnit(max_groups_buffer_entry_guess,
                                           is_agg,
                                           table_infos,
@@ -1712,11 +1805,12 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   max_groups_buffer_entry_guess = 0;
 
   int iteration_ctr = -1;
-  while (!result.empty()) {
+  while (result.empty()) {
     iteration_ctr++;
     auto ra_exe_unit = decide_approx_count_distinct_implementation(
         ra_exe_unit_in, table_infos, executor_, co_cpu.device_type, target_exprs_owned_);
     ColumnCacheMap column_cache;
+    ++retries;
     try {
       result = executor_->executeWorkUnit(max_groups_buffer_entry_guess,
                                           is_agg,
@@ -1750,6 +1844,9 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
     }
   }
   result.setQueueTime(queue_time_ms);
+  setGroupByBufferProfile(ra_exe_unit_in, max_groups_buffer_entry_guess, retries);
+  maybeUpdateCardinalityCache(
+      ra_exe_unit_in, result, max_groups_buffer_entry_guess, cache_key, eo);
   return registerResultSetTable(result, targets_meta, eo.just_explain);
 }
 
@@ -1786,6 +1883,7 @@ ExecutionResult RelAlgExecutor::registerResultSetTable(
 
   CHECK(!table.empty());
   table[0]->setColNames(std::move(col_names));
+  reduction_time_ms_ += table.getReductionTime();
   auto token = rs_registry_->put(std::move(table));
   return {token, targets_meta};
 }
@@ -1834,6 +1932,52 @@ ErrorInfo getErrorDescription(const int32_t error_code) {
 
 }  // namespace
 
+bool RelAlgExecutor::canGrowGroupByBuffer(const int32_t error_code,
+                                          const bool is_agg,
+                                          const CompilationOptions& co) const {
+  if (!config_.exec.group_by.enable_adaptive_groupby || !is_agg) {
+    return false;
+  }
+  if (error_code >= 0 && error_code != Executor::ERR_OUT_OF_SLOTS) {
+    return false;
+  }
+  // GPU buffers are limited by the device memory, so keep the existing CPU retry
+  // logic for them.
+  return co.device_type == ExecutorDeviceType::CPU;
+}
+
+void RelAlgExecutor::setGroupByBufferProfile(const RelAlgExecutionUnit& ra_exe_unit,
+                                             const size_t groups_buffer_entry_guess,
+                                             const size_t retries) {
+  if (auto profiler = executor_->getStepProfiler();
+      profiler && !ra_exe_unit.groupby_exprs.empty() &&
+      ra_exe_unit.groupby_exprs.front()) {
+    profiler->setGroupByBuffer(groups_buffer_entry_guess, retries);
+  }
+}
+
+void RelAlgExecutor::maybeUpdateCardinalityCache(const RelAlgExecutionUnit& ra_exe_unit,
+                                                 const hdk::ResultSetTable& rs_table,
+                                                 const size_t groups_buffer_entry_guess,
+                                                 const std::string& cache_key,
+                                                 const ExecutionOptions& eo) {
+  if (!config_.exec.group_by.enable_adaptive_groupby || eo.just_explain ||
+      eo.just_validate || ra_exe_unit.groupby_exprs.empty() ||
+      !ra_exe_unit.groupby_exprs.front() || ra_exe_unit.partitioned_aggregation ||
+      ra_exe_unit.estimator || ra_exe_unit.sort_info.limit || rs_table.empty()) {
+    return;
+  }
+  size_t groups = 0;
+  for (auto& rs : rs_table.results()) {
+    groups += rs->rowCount();
+  }
+  // Entry count is expected to be 2x of the groups count.
+  auto observed_guess = std::max(groups * 2, size_t(1));
+  VLOG(1) << "Observed " << groups << " groups with retried buffer entry guess "
+          << groups_buffer_entry_guess << ", updating cardinality cache";
+  executor_->addToCardinalityCache(cache_key, observed_guess);
+}
+
 std::string RelAlgExecutor::getErrorMessageFromCode(const int32_t error_code) {
   if (error_code < 0) {
     return "Ran out of slots in the query output buffer";
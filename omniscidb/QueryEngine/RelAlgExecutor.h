@@ -129,6 +129,7 @@ class RelAlgExecutor {
                                              const CompilationOptions& co,
                                              const ExecutionOptions& eo,
                                              size_t estimated_buffer_size,
+                                             size_t estimated_buffer_entries,
                                              const int64_t queue_time_ms);
   void maybeCopyTableStatsFromInput(const hdk::ir::Node* node);
   ExecutionResult executeStep(const hdk::ir::Node* step_root,
@@ -207,12 +208,34 @@ class RelAlgExecutor {
       const CompilationOptions& co,
       const ExecutionOptions& eo,
       const bool was_multifrag_kernel_launch,
-      const int64_t queue_time_ms);
+      const int64_t queue_time_ms,
+      const std::string& cache_key);
 
   // Allows an out of memory error through if CPU retry is enabled. Otherwise, throws an
   // appropriate exception corresponding to the query error code.
   void handlePersistentError(const int32_t error_code);
 
+  // Checks if a group-by step which ran out of slots can be passed to
+  // handleOutOfMemoryRetry to be re-executed with a grown output buffer instead of
+  // failing.
+  bool canGrowGroupByBuffer(const int32_t error_code,
+                            const bool is_agg,
+                            const CompilationOptions& co) const;
+
+  // Reports the group-by buffer size of a step to its profile, if any.
+  void setGroupByBufferProfile(const RelAlgExecutionUnit& ra_exe_unit,
+                               const size_t groups_buffer_entry_guess,
+                               const size_t retries);
+
+  // Feeds the observed number of groups of a retried step back into the cardinality
+  // cache, so the next execution of the same step starts with the buffer size and
+  // layout matching the actual data.
+  void maybeUpdateCardinalityCache(const RelAlgExecutionUnit& ra_exe_unit,
+                                   const hdk::ResultSetTable& rs_table,
+                                   const size_t groups_buffer_entry_guess,
+                                   const std::string& cache_key,
+                                   const ExecutionOptions& eo);
+
   WorkUnit createWorkUnit(const hdk::ir::Node*,
                           const SortInfo&,
                           const ExecutionOptions& eo);
@@ -250,12 +273,17 @@ class RelAlgExecutor {
   std::unordered_map<unsigned, JoinQualsPerNestingLevel> left_deep_join_info_;
   std::vector<hdk::ir::ExprPtr> target_exprs_owned_;  // TODO(alex): remove
   int64_t queue_time_ms_;
+  // Time spent in reduction of results of all steps executed by this executor.
+  int64_t reduction_time_ms_;
   static SpeculativeTopNBlacklist speculative_topn_blacklist_;
 
   std::optional<std::function<void()>> post_execution_callback_;
 
   std::shared_ptr<StreamExecutionContext> stream_execution_context_;
 
+  // Runtime profile collected in the EXPLAIN ANALYZE mode.
+  QueryProfilePtr profile_;
+
   friend class PendingExecutionClosure;
 };
 
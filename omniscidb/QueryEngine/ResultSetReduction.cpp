@@ -39,11 +39,16 @@
 
 #include <tbb/parallel_for.h>
 #include <algorithm>
+#include <atomic>
 #include <future>
 #include <numeric>
 
 namespace {
 
+// Number of new entries inserted into baseline hash tables by the reductions run on
+// the current thread.
+thread_local size_t reduction_inserted_entries = 0;
+
 bool use_multithreaded_reduction(const size_t entry_count) {
   return entry_count > 100000;
 }
@@ -171,12 +176,13 @@ void run_reduction_code(const ReductionCode& reduction_code,
 
 // Driver method for various buffer layouts, actual work is done by reduceOne* methods.
 // Reduces the entries of `this_` into the buffer of `that` ResultSetStorage object.
-void ResultSetReduction::reduce(const ResultSetStorage& this_,
-                                const ResultSetStorage& that,
-                                const std::vector<std::string>& serialized_varlen_buffer,
-                                const ReductionCode& reduction_code,
-                                const Config& config,
-                                const Executor* executor) {
+size_t ResultSetReduction::reduce(
+    const ResultSetStorage& this_,
+    const ResultSetStorage& that,
+    const std::vector<std::string>& serialized_varlen_buffer,
+    const ReductionCode& reduction_code,
+    const Config& config,
+    const Executor* executor) {
   auto this_query_mem_desc = this_.getQueryMemDesc();
   auto that_query_mem_desc = that.getQueryMemDesc();
   auto entry_count = this_query_mem_desc.getEntryCount();
@@ -209,61 +215,38 @@ void ResultSetReduction::reduce(const ResultSetStorage& this_,
           "Projection of variable length targets with baseline hash group by is not yet "
           "supported in Distributed mode");
     }
-    if (use_multithreaded_reduction(that_entry_count)) {
-      if (reduction_code.ir_reduce_loop) {
-        tbb::parallel_for(tbb::blocked_range<size_t>(0, that_entry_count),
-                          [&this_query_mem_desc,
-                           this_buff,
-                           that_buff,
-                           that_entry_count,
-                           &reduction_code,
-                           &that_query_mem_desc,
-                           executor](auto r) {
-                            run_reduction_code(reduction_code,
-                                               this_buff,
-                                               that_buff,
-                                               r.begin(),
-                                               r.end(),
-                                               that_entry_count,
-                                               &this_query_mem_desc,
-                                               &that_query_mem_desc,
-                                               nullptr,
-                                               executor);
-                          });
-      } else {
-        tbb::parallel_for(tbb::blocked_range<size_t>(0, that_entry_count),
-                          [&this_, &that, this_buff, that_buff, &config](auto r) {
-                            for (size_t entry_idx = r.begin(); entry_idx < r.end();
-                                 ++entry_idx) {
-                              reduceOneEntryBaseline(this_,
-                                                     that,
-                                                     this_buff,
-                                                     that_buff,
-                                                     entry_idx,
-                                                     config.exec.watchdog.enable_dynamic);
-                            }
-                          });
-      }
-    } else {
+    // Ranges are reduced without nested parallelism, so the thread local counter
+    // gives the exact number of entries inserted by the range.
+    std::atomic<size_t> inserted_entries{0};
+    auto reduce_range = [&](size_t start_entry_idx, size_t end_entry_idx) {
+      const auto inserted_before = reduction_inserted_entries;
       if (reduction_code.ir_reduce_loop) {
         run_reduction_code(reduction_code,
                            this_buff,
                            that_buff,
-                           0,
-                           that_entry_count,
+                           start_entry_idx,
+                           end_entry_idx,
                            that_entry_count,
                            &this_query_mem_desc,
                            &that_query_mem_desc,
                            nullptr,
                            executor);
       } else {
-        for (size_t i = 0; i < that_entry_count; ++i) {
+        for (size_t i = start_entry_idx; i < end_entry_idx; ++i) {
           reduceOneEntryBaseline(
               this_, that, this_buff, that_buff, i, config.exec.watchdog.enable_dynamic);
         }
       }
+      inserted_entries += reduction_inserted_entries - inserted_before;
+    };
+    if (use_multithreaded_reduction(that_entry_count)) {
+      tbb::parallel_for(
+          tbb::blocked_range<size_t>(0, that_entry_count),
+          [&reduce_range](auto r) { reduce_range(r.begin(), r.end()); });
+    } else {
+      reduce_range(0, that_entry_count);
     }
-    return;
+    return inserted_entries;
   }
   if (use_multithreaded_reduction(entry_count)) {
     if (this_query_mem_desc.didOutputColumnar()) {
@@ -327,6 +310,7 @@ void ResultSetReduction::reduce(const ResultSetStorage& this_,
                          executor);
     }
   }
+  return 0;
 }
 
 namespace {
@@ -667,6 +651,7 @@ GroupValueInfo result_set::get_group_value_reduction(
                                                          that_entry_count,
                                                          row_size_quad);
   if (matching_gvi.first) {
+    reduction_inserted_entries += matching_gvi.second;
     return matching_gvi;
   }
   uint32_t h_probe = (h + 1) % groups_buffer_entry_count;
@@ -682,6 +667,7 @@ GroupValueInfo result_set::get_group_value_reduction(
                                                       that_entry_count,
                                                       row_size_quad);
     if (matching_gvi.first) {
+      reduction_inserted_entries += matching_gvi.second;
       return matching_gvi;
     }
     h_probe = (h_probe + 1) % groups_buffer_entry_count;
@@ -720,6 +706,7 @@ void ResultSetReduction::reduceOneEntryBaseline(const ResultSetStorage& this_,
       this_buff_i64, this_query_mem_desc.getEntryCount(), &key[0], key_count);
   CHECK(this_entry_slots);
   if (empty_entry) {
+    ++reduction_inserted_entries;
     fill_slots(this_entry_slots,
                this_query_mem_desc.getEntryCount(),
                that_buff_i64,
@@ -13,12 +13,14 @@ struct ReductionCode;
 
 class ResultSetReduction {
  public:
-  static void reduce(const ResultSetStorage& this_,
-                     const ResultSetStorage& that,
-                     const std::vector<std::string>& serialized_varlen_buffer,
-                     const ReductionCode& reduction_code,
-                     const Config& config,
-                     const Executor* executor);
+  // Returns the number of new entries inserted into `this_` for the baseline hash
+  // layout and zero for other layouts.
+  static size_t reduce(const ResultSetStorage& this_,
+                       const ResultSetStorage& that,
+                       const std::vector<std::string>& serialized_varlen_buffer,
+                       const ReductionCode& reduction_code,
+                       const Config& config,
+                       const Executor* executor);
 
   // Reduces results for a single row when using interleaved bin layouts
   static bool reduceSingleRow(const int8_t* row_ptr,
@@ -34,10 +34,12 @@
 #include "ResultSet/ResultSet.h"
 #include "Shared/Intervals.h"
 #include "Shared/likely.h"
+#include "Shared/parallel_radix_sort.h"
 #include "Shared/parallel_sort.h"
 #include "Shared/thread_count.h"
 
 #include <future>
+#include <numeric>
 
 #ifdef HAVE_CUDA
 std::unique_ptr<CudaMgr_Namespace::CudaMgr> g_cuda_mgr;  // for unit tests only
@@ -429,12 +431,15 @@ bool ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
             entry_type->as<hdk::ir::ExtDictionaryType>()->dictId(),
             result_set_->getRowSetMemOwner(),
             false);
-        auto lhs_str = string_dict_proxy->getString(lhs_v.i1);
-        auto rhs_str = string_dict_proxy->getString(rhs_v.i1);
-        if (lhs_str == rhs_str) {
-          continue;
+        // Sorted ids are compared as integers below.
+        if (!string_dict_proxy->hasSortedIds()) {
+          auto lhs_str = string_dict_proxy->getString(lhs_v.i1);
+          auto rhs_str = string_dict_proxy->getString(rhs_v.i1);
+          if (lhs_str == rhs_str) {
+            continue;
+          }
+          return (lhs_str < rhs_str) != order_entry.is_desc;
         }
-        return (lhs_str < rhs_str) != order_entry.is_desc;
       }
 
       if (lhs_v.i1 == rhs_v.i1) {
@@ -661,7 +666,8 @@ void parallelTop(ResultSet* rs,
 template <typename T>
 void sort_on_cpu(T* val_buff,
                  PermutationView pv,
-                 const hdk::ir::OrderEntry& order_entry) {
+                 const hdk::ir::OrderEntry& order_entry,
+                 const bool use_radix_sort) {
   int64_t begin = 0;
   int64_t end = pv.size() - 1;
 
@@ -697,7 +703,12 @@ void sort_on_cpu(T* val_buff,
     begin = 0;
   }
 
-  if (order_entry.is_desc) {
+  if (use_radix_sort) {
+    parallel_radix_sort_by_key(val_buff + begin,
+                               pv.begin() + begin,
+                               (size_t)(end - begin + 1),
+                               order_entry.is_desc);
+  } else if (order_entry.is_desc) {
     parallel_sort_by_key(val_buff + begin,
                          pv.begin() + begin,
                          (size_t)(end - begin + 1),
@@ -708,24 +719,77 @@ void sort_on_cpu(T* val_buff,
   }
 }
 
+// Replace dictionary ids of entries selected by the permutation with ranks of their
+// strings in the lexicographical order, so the column can be sorted as an integer one.
+// Other entries might be uninitialized and are not touched. Nulls are kept as is.
+void dict_ids_to_string_ranks(int32_t* ids,
+                              const PermutationView pv,
+                              StringDictionary* dict) {
+  auto timer = DEBUG_TIMER(__func__);
+  if (dict->hasSortedIds()) {
+    // Ids already are ranks of their strings.
+    return;
+  }
+  std::vector<int32_t> unique_ids;
+  unique_ids.reserve(pv.size());
+  for (auto idx : pv) {
+    if (ids[idx] != inline_null_value<int32_t>()) {
+      unique_ids.push_back(ids[idx]);
+    }
+  }
+  tbb::parallel_sort(unique_ids.begin(), unique_ids.end());
+  unique_ids.erase(std::unique(unique_ids.begin(), unique_ids.end()), unique_ids.end());
+
+  const auto strings = dict->getStrings(unique_ids);
+  std::vector<int32_t> order(unique_ids.size());
+  std::iota(order.begin(), order.end(), 0);
+  tbb::parallel_sort(order.begin(), order.end(), [&strings](int32_t lhs, int32_t rhs) {
+    return strings[lhs] < strings[rhs];
+  });
+  std::vector<int32_t> ranks(unique_ids.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    // Equal strings get equal ranks to keep the order of ties unspecified.
+    ranks[order[i]] =
+        (i && strings[order[i]] == strings[order[i - 1]]) ? ranks[order[i - 1]] : i;
+  }
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, pv.size()),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                      for (size_t i = r.begin(); i != r.end(); ++i) {
+                        auto& id = ids[pv[i]];
+                        if (id == inline_null_value<int32_t>()) {
+                          continue;
+                        }
+                        auto it =
+                            std::lower_bound(unique_ids.begin(), unique_ids.end(), id);
+                        id = ranks[it - unique_ids.begin()];
+                      }
+                    });
+}
+
 void sort_onecol_cpu(int8_t* val_buff,
                      PermutationView pv,
                      const hdk::ir::Type* type,
                      const size_t slot_width,
-                     const hdk::ir::OrderEntry& order_entry) {
-  if (type->isInteger() || type->isDecimal()) {
+                     const hdk::ir::OrderEntry& order_entry,
+                     const bool use_radix_sort) {
+  // Dictionary encoded columns are expected to be converted to string ranks.
+  if (type->isInteger() || type->isDecimal() || type->isExtDictionary()) {
     switch (slot_width) {
       case 1:
-        sort_on_cpu(reinterpret_cast<int8_t*>(val_buff), pv, order_entry);
+        sort_on_cpu(reinterpret_cast<int8_t*>(val_buff), pv, order_entry, use_radix_sort);
         break;
       case 2:
-        sort_on_cpu(reinterpret_cast<int16_t*>(val_buff), pv, order_entry);
+        sort_on_cpu(
+            reinterpret_cast<int16_t*>(val_buff), pv, order_entry, use_radix_sort);
         break;
       case 4:
-        sort_on_cpu(reinterpret_cast<int32_t*>(val_buff), pv, order_entry);
+        sort_on_cpu(
+            reinterpret_cast<int32_t*>(val_buff), pv, order_entry, use_radix_sort);
         break;
       case 8:
-        sort_on_cpu(reinterpret_cast<int64_t*>(val_buff), pv, order_entry);
+        sort_on_cpu(
+            reinterpret_cast<int64_t*>(val_buff), pv, order_entry, use_radix_sort);
         break;
       default:
         CHECK(false);
@@ -733,10 +797,11 @@ void sort_onecol_cpu(int8_t* val_buff,
   } else if (type->isFloatingPoint()) {
     switch (slot_width) {
       case 4:
-        sort_on_cpu(reinterpret_cast<float*>(val_buff), pv, order_entry);
+        sort_on_cpu(reinterpret_cast<float*>(val_buff), pv, order_entry, use_radix_sort);
         break;
       case 8:
-        sort_on_cpu(reinterpret_cast<double*>(val_buff), pv, order_entry);
+        sort_on_cpu(
+            reinterpret_cast<double*>(val_buff), pv, order_entry, use_radix_sort);
         break;
       default:
         CHECK(false);
@@ -811,7 +876,11 @@ void sortResultSet(ResultSet* rs,
           lazy_fetch_info.empty() || !lazy_fetch_info[target_idx].is_lazily_fetched;
       const auto entry_type = get_compact_type(rs->getTargetInfos()[target_idx]);
       const auto slot_width = query_mem_desc.getPaddedSlotWidthBytes(target_idx);
-      if (is_not_lazy && slot_width > 0 && entry_type->isNumber()) {
+      // Dictionary ids are sorted as string ranks together with radix sort.
+      const bool is_dict_sort = entry_type->isExtDictionary() && executor &&
+                                executor->getConfig().exec.enable_radix_sort &&
+                                slot_width == 4 && entry_type->size() == 4;
+      if (is_not_lazy && slot_width > 0 && (entry_type->isNumber() || is_dict_sort)) {
         const size_t buf_size = query_mem_desc.getEntryCount() * slot_width;
         // std::vector<int8_t> sortkey_val_buff(buf_size);
         std::unique_ptr<int8_t[]> sortkey_val_buff(new int8_t[buf_size]);
@@ -820,11 +889,24 @@ void sortResultSet(ResultSet* rs,
         permutation.resize(query_mem_desc.getEntryCount());
         PermutationView pv(permutation.data(), 0, permutation.size());
         pv = rs->initPermutationBuffer(pv, 0, permutation.size());
+        if (is_dict_sort) {
+          dict_ids_to_string_ranks(
+              reinterpret_cast<int32_t*>(&sortkey_val_buff[0]),
+              pv,
+              executor->getStringDictionaryProxy(
+                  entry_type->as<hdk::ir::ExtDictionaryType>()->dictId(),
+                  rs->getRowSetMemOwner(),
+                  false));
+        }
+        const bool use_radix_sort =
+            executor && executor->getConfig().exec.enable_radix_sort &&
+            pv.size() >= executor->getConfig().exec.radix_sort_min;
         sort_onecol_cpu(reinterpret_cast<int8_t*>(&sortkey_val_buff[0]),
                         pv,
                         entry_type,
                         slot_width,
-                        order_entry);
+                        order_entry,
+                        use_radix_sort);
         if (pv.size() < permutation.size()) {
           permutation.resize(pv.size());
           permutation.shrink_to_fit();
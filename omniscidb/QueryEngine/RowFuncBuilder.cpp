@@ -34,9 +34,11 @@
 #include "QueryEngine/ExpressionRewrite.h"
 #include "QueryEngine/GpuInitGroups.h"
 #include "QueryEngine/GpuMemUtils.h"
+#include "QueryEngine/HyperLogLogRank.h"
 #include "QueryEngine/InPlaceSort.h"
 #include "QueryEngine/LLVMFunctionAttributesUtil.h"
 #include "QueryEngine/MaxwellCodegenPatch.h"
+#include "QueryEngine/MurmurHash1Inl.h"
 #include "QueryEngine/OutputBufferInitialization.h"
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "QueryEngine/RuntimeFunctions.h"
@@ -46,6 +48,8 @@
 #include "QueryEngine/UnnestedVarsCollector.h"
 #include "QueryEngine/WindowContext.h"
 #include "ResultSet/QueryMemoryDescriptor.h"
+#include "ResultSet/RoaringSet.h"
+#include "ResultSet/SparseHyperLogLog.h"
 #include "Shared/MathUtils.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
@@ -1211,6 +1215,27 @@ extern "C" RUNTIME_EXPORT void agg_count_distinct_skip_val(int64_t* agg,
   }
 }
 
+extern "C" RUNTIME_EXPORT void agg_count_distinct_roaring(int64_t* agg,
+                                                          const int64_t val) {
+  reinterpret_cast<RoaringSet*>(*agg)->insert(val);
+}
+
+extern "C" RUNTIME_EXPORT void agg_count_distinct_roaring_skip_val(
+    int64_t* agg,
+    const int64_t val,
+    const int64_t skip_val) {
+  if (val != skip_val) {
+    agg_count_distinct_roaring(agg, val);
+  }
+}
+
+extern "C" RUNTIME_EXPORT void agg_approximate_count_distinct_sparse(int64_t* agg,
+                                                                    const int64_t key,
+                                                                    const uint32_t b) {
+  const auto reg = get_hll_register_update(MurmurHash64AImpl(&key, sizeof(key), 0), b);
+  reinterpret_cast<SparseHll*>(*agg)->update(reg.index, reg.rank, b);
+}
+
 extern "C" RUNTIME_EXPORT void agg_approx_quantile(int64_t* agg, const double val) {
   auto* t_digest = reinterpret_cast<quantile::TDigest*>(*agg);
   t_digest->allocate();
@@ -1233,9 +1258,15 @@ void RowFuncBuilder::codegenCountDistinct(const size_t target_idx,
       query_mem_desc.getCountDistinctDescriptor(target_idx);
   CHECK(count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid);
   if (agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct) {
-    CHECK(count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap);
+    CHECK(count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::SparseHll);
     agg_args.push_back(LL_INT(int32_t(count_distinct_descriptor.bitmap_sz_bits)));
-    if (device_type == ExecutorDeviceType::GPU) {
+    if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::SparseHll) {
+      CHECK(device_type == ExecutorDeviceType::CPU);
+      executor_->cgen_state_->emitExternalCall("agg_approximate_count_distinct_sparse",
+                                               llvm::Type::getVoidTy(LL_CONTEXT),
+                                               agg_args);
+    } else if (device_type == ExecutorDeviceType::GPU) {
       const auto base_dev_addr = getAdditionalLiteral(-1);
       const auto base_host_addr = getAdditionalLiteral(-2);
       agg_args.push_back(base_dev_addr);
@@ -1250,6 +1281,8 @@ void RowFuncBuilder::codegenCountDistinct(const size_t target_idx,
   if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap) {
     agg_fname += "_bitmap";
     agg_args.push_back(LL_INT(static_cast<int64_t>(count_distinct_descriptor.min_val)));
+  } else if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::Roaring) {
+    agg_fname += "_roaring";
   }
   if (agg_info.skip_null_val) {
     auto null_lv = executor_->cgen_state_->castToTypeIn(
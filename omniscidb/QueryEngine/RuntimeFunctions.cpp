@@ -417,11 +417,9 @@ extern "C" RUNTIME_EXPORT NEVER_INLINE void agg_approximate_count_distinct(
     GENERIC_ADDR_SPACE int64_t* agg,
     const int64_t key,
     const uint32_t b) {
-  const uint64_t hash = MurmurHash64A(&key, sizeof(key), 0);
-  const uint32_t index = hash >> (64 - b);
-  const uint8_t rank = get_rank(hash << b, 64 - b);
+  const auto reg = get_hll_register_update(MurmurHash64A(&key, sizeof(key), 0), b);
   GENERIC_ADDR_SPACE uint8_t* M = reinterpret_cast<GENERIC_ADDR_SPACE uint8_t*>(*agg);
-  M[index] = std::max(static_cast<uint8_t>(M[index]), rank);
+  M[reg.index] = std::max(static_cast<uint8_t>(M[reg.index]), reg.rank);
 }
 
 extern "C" GPU_RT_STUB void agg_approximate_count_distinct_gpu(
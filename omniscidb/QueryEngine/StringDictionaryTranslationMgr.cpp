@@ -59,6 +59,29 @@ StringDictionaryTranslationMgr::StringDictionaryTranslationMgr(
 #endif  // HAVE_CUDA
 }
 
+StringDictionaryTranslationMgr::StringDictionaryTranslationMgr(
+    const int32_t string_dict_id,
+    const StringTransformType transform_type,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_count,
+    Executor* executor,
+    Data_Namespace::DataMgr* data_mgr)
+    : source_string_dict_id_(string_dict_id)
+    , dest_string_dict_id_(string_dict_id)
+    , translate_intersection_only_(false)
+    , transform_type_(transform_type)
+    , memory_level_(memory_level)
+    , device_count_(device_count)
+    , executor_(executor)
+    , data_mgr_(data_mgr) {
+#ifdef HAVE_CUDA
+  CHECK(memory_level_ == Data_Namespace::CPU_LEVEL ||
+        memory_level == Data_Namespace::GPU_LEVEL);
+#else
+  CHECK_EQ(Data_Namespace::CPU_LEVEL, memory_level_);
+#endif  // HAVE_CUDA
+}
+
 StringDictionaryTranslationMgr::~StringDictionaryTranslationMgr() {
   CHECK(data_mgr_);
   for (auto& device_buffer : device_buffers_) {
@@ -67,6 +90,14 @@ StringDictionaryTranslationMgr::~StringDictionaryTranslationMgr() {
 }
 
 void StringDictionaryTranslationMgr::buildTranslationMap() {
+  if (transform_type_) {
+    host_translation_map_ = executor_->getStringProxyTransformTranslationMap(
+        source_string_dict_id_,
+        *transform_type_,
+        executor_->getRowSetMemoryOwner(),
+        true);
+    return;
+  }
   host_translation_map_ = executor_->getStringProxyTranslationMap(
       source_string_dict_id_,
       dest_string_dict_id_,
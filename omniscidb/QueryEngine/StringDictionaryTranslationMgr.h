@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 #include "../DataMgr/MemoryLevel.h"
 #include "Compiler/CodegenTraitsDescriptor.h"
@@ -47,6 +48,9 @@ struct CodegenTraitsDesc;
 namespace StringFunctors {
 enum StringFunctorType : unsigned int;
 }
+// String functions evaluated once per dictionary entry.
+enum class StringTransformType { kLower };
+
 class StringDictionaryTranslationMgr {
  public:
   StringDictionaryTranslationMgr(const int32_t source_string_dict_id,
@@ -56,6 +60,14 @@ class StringDictionaryTranslationMgr {
                                  const int device_count,
                                  Executor* executor,
                                  Data_Namespace::DataMgr* data_mgr);
+  // Translates ids of a dictionary to ids of transformed strings in the same
+  // dictionary.
+  StringDictionaryTranslationMgr(const int32_t string_dict_id,
+                                 const StringTransformType transform_type,
+                                 const Data_Namespace::MemoryLevel memory_level,
+                                 const int device_count,
+                                 Executor* executor,
+                                 Data_Namespace::DataMgr* data_mgr);
 
   ~StringDictionaryTranslationMgr();
   void buildTranslationMap();
@@ -71,6 +83,7 @@ class StringDictionaryTranslationMgr {
   const int32_t source_string_dict_id_;
   const int32_t dest_string_dict_id_;
   const bool translate_intersection_only_;
+  const std::optional<StringTransformType> transform_type_;
   const Data_Namespace::MemoryLevel memory_level_;
   const int device_count_;
   Executor* executor_;
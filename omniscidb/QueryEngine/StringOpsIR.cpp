@@ -16,6 +16,7 @@
 
 #include "CodeGenerator.h"
 #include "Execute.h"
+#include "StringDictionaryTranslationMgr.h"
 
 #include "../Shared/funcannotations.h"
 #include "../Shared/sqldefs.h"
@@ -104,20 +105,41 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::KeyForStringExpr* expr,
 llvm::Value* CodeGenerator::codegen(const hdk::ir::LowerExpr* expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
-  if (co.device_type == ExecutorDeviceType::GPU) {
-    throw QueryMustRunOnCpu();
-  }
-
   auto str_id_lv = codegen(expr->arg(), true, co);
   CHECK_EQ(size_t(1), str_id_lv.size());
 
   CHECK(expr->type()->isExtDictionary());
+  const auto dict_id = expr->type()->as<hdk::ir::ExtDictionaryType>()->dictId();
   const auto string_dictionary_proxy = executor()->getStringDictionaryProxy(
-      expr->type()->as<hdk::ir::ExtDictionaryType>()->dictId(),
-      executor()->getRowSetMemoryOwner(),
-      true);
+      dict_id, executor()->getRowSetMemoryOwner(), true);
   CHECK(string_dictionary_proxy);
 
+  // Column values are ids of the dictionary generation used by the query, so all
+  // of them are covered by a translation map built once per dictionary entry.
+  // Other expressions might produce ids added to the proxy later.
+  if (dynamic_cast<const hdk::ir::ColumnVar*>(expr->arg()) &&
+      string_dictionary_proxy->entryCount() <= 200000000) {
+    auto string_dictionary_translation_mgr =
+        std::make_unique<StringDictionaryTranslationMgr>(
+            dict_id,
+            StringTransformType::kLower,
+            co.device_type == ExecutorDeviceType::GPU ? Data_Namespace::GPU_LEVEL
+                                                      : Data_Namespace::CPU_LEVEL,
+            executor()->deviceCount(co.device_type),
+            executor(),
+            executor()->getDataMgr());
+    string_dictionary_translation_mgr->buildTranslationMap();
+    string_dictionary_translation_mgr->createKernelBuffers();
+
+    return cgen_state_
+        ->moveStringDictionaryTranslationMgr(std::move(string_dictionary_translation_mgr))
+        ->codegenCast(str_id_lv[0], expr->arg()->type(), true, co.codegen_traits_desc);
+  }
+
+  if (co.device_type == ExecutorDeviceType::GPU) {
+    throw QueryMustRunOnCpu();
+  }
+
   std::vector<llvm::Value*> args{
       str_id_lv[0],
       cgen_state_->llInt(reinterpret_cast<int64_t>(string_dictionary_proxy))};
@@ -222,35 +244,26 @@ llvm::Value* CodeGenerator::codegenDictLike(const hdk::ir::ExprPtr like_arg,
 
 namespace {
 
-std::vector<int32_t> get_compared_ids(const StringDictionary* dict,
-                                      hdk::ir::OpType compare_operator,
-                                      const std::string& pattern) {
-  std::vector<int> ret;
+std::string get_compare_operator_name(hdk::ir::OpType compare_operator) {
   switch (compare_operator) {
     case hdk::ir::OpType::kLt:
-      ret = dict->getCompare(pattern, "<");
-      break;
+      return "<";
     case hdk::ir::OpType::kLe:
-      ret = dict->getCompare(pattern, "<=");
-      break;
+      return "<=";
     case hdk::ir::OpType::kEq:
     case hdk::ir::OpType::kBwEq:
-      ret = dict->getCompare(pattern, "=");
-      break;
+      return "=";
     case hdk::ir::OpType::kGt:
-      ret = dict->getCompare(pattern, ">");
-      break;
+      return ">";
     case hdk::ir::OpType::kGe:
-      ret = dict->getCompare(pattern, ">=");
-      break;
+      return ">=";
     case hdk::ir::OpType::kNe:
-      ret = dict->getCompare(pattern, "<>");
-      break;
+      return "<>";
     default:
-      std::runtime_error("unsuported operator for string comparision");
+      throw std::runtime_error("unsuported operator for string comparision");
   }
-  return ret;
 }
+
 }  // namespace
 
 llvm::Value* CodeGenerator::codegenDictStrCmp(const hdk::ir::ExprPtr lhs,
@@ -328,7 +341,27 @@ llvm::Value* CodeGenerator::codegenDictStrCmp(const hdk::ir::ExprPtr lhs,
   }
 
   const auto& pattern_str = *const_val.stringval;
-  const auto matching_ids = get_compared_ids(sdp, compare_opr, pattern_str);
+  const auto comp_operator = get_compare_operator_name(compare_opr);
+  if (compare_opr != hdk::ir::OpType::kEq && compare_opr != hdk::ir::OpType::kBwEq) {
+    if (const auto id_range = sdp->getSortedIdRange(pattern_str, comp_operator)) {
+      // Ids follow the order of strings, so the comparison with the literal becomes
+      // a comparison with the boundary of the matching id range.
+      const bool is_less =
+          compare_opr == hdk::ir::OpType::kLt || compare_opr == hdk::ir::OpType::kLe;
+      Datum bound;
+      bound.intval = is_less ? id_range->second : id_range->first;
+      auto id_type = col_type->ctx().int32(col_type->nullable());
+      const auto bound_expr = hdk::ir::makeExpr<hdk::ir::Constant>(
+          id_type->withNullable(false), false, bound);
+      return codegenCmp(is_less ? hdk::ir::OpType::kLt : hdk::ir::OpType::kGe,
+                        hdk::ir::Qualifier::kOne,
+                        codegen(col_var.get(), true, co),
+                        id_type,
+                        bound_expr.get(),
+                        co);
+    }
+  }
+  const auto matching_ids = sdp->getCompare(pattern_str, comp_operator);
 
   // InIntegerSet requires 64-bit values
   std::vector<int64_t> matching_ids_64(matching_ids.size());
@@ -254,6 +254,9 @@ class ArrowResultSetConverter {
     const hdk::ir::Type* physical_type;
     ArrowStringRemapMode string_remap_mode{ArrowStringRemapMode::INVALID};
     std::unordered_map<StrId, ArrowStrId> string_remapping;
+    // All dictionary strings indexed by string id. Set for bulk fetched
+    // dictionaries only, where string ids can be used as Arrow indices as is.
+    std::shared_ptr<arrow::Array> dictionary;
   };
 
   ArrowResultSetConverter(const std::shared_ptr<ResultSet>& results,
@@ -37,12 +37,14 @@
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <functional>
 #include <future>
 #include <string>
 #include <tuple>
 
 //  TBB headers
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
 
 //  OS-specific headers
 #ifndef _MSC_VER
@@ -427,6 +429,50 @@ void convert_column(ResultSetPtr result,
   out = std::make_shared<arrow::ChunkedArray>(std::move(fragments));
 }
 
+// Checks all non-null string ids of a columnar dictionary encoded column refer
+// to the first dict_size dictionary entries.
+bool dictionary_ids_in_range(ResultSetPtr result, size_t col, int32_t dict_size) {
+  auto chunks = result->getChunkedColumnarBuffer(col);
+  return tbb::parallel_reduce(
+      tbb::blocked_range<size_t>(0, chunks.size()),
+      true,
+      [&](const tbb::blocked_range<size_t>& r, bool in_range) {
+        const int32_t null_val = inline_null_value<int32_t>();
+        for (size_t idx = r.begin(); idx != r.end() && in_range; ++idx) {
+          auto vals = reinterpret_cast<const int32_t*>(chunks[idx].first);
+          for (size_t i = 0; i < chunks[idx].second; ++i) {
+            if (vals[i] != null_val && (vals[i] < 0 || vals[i] >= dict_size)) {
+              in_range = false;
+              break;
+            }
+          }
+        }
+        return in_range;
+      },
+      std::logical_and<bool>());
+}
+
+// Dictionary encoded column is exported as chunks of dictionary arrays sharing
+// the same dictionary. String ids are used as indices, so indices buffers refer
+// to the ResultSet memory as numeric columns do.
+void convert_dictionary_column(ResultSetPtr result,
+                               size_t col,
+                               size_t entry_count,
+                               const std::shared_ptr<arrow::DataType>& type,
+                               const std::shared_ptr<arrow::Array>& dictionary,
+                               std::shared_ptr<arrow::ChunkedArray>& out) {
+  std::shared_ptr<arrow::ChunkedArray> indices;
+  convert_column<int32_t>(result, col, entry_count, indices);
+
+  std::vector<std::shared_ptr<arrow::Array>> fragments;
+  fragments.reserve(indices->num_chunks());
+  for (auto& chunk : indices->chunks()) {
+    fragments.emplace_back(
+        std::make_shared<arrow::DictionaryArray>(type, chunk, dictionary));
+  }
+  out = std::make_shared<arrow::ChunkedArray>(std::move(fragments), type);
+}
+
 template <typename ArrowArrayType>
 void convert_column(const hdk::ir::Type* physical_type,
                     ResultSetPtr results,
@@ -1400,9 +1446,14 @@ std::shared_ptr<arrow::Table> ArrowResultSetConverter::getArrowTable(
           break;
       }
 
-      // Dictionaries are not supported by columnar converter.
+      // Only dictionaries fetched in bulk are supported by columnar converter.
+      // String ids out of the fetched dictionary range would require remapping.
       if (builders[col_idx].field->type()->id() == arrow::Type::DICTIONARY) {
-        use_columnar_conversion = false;
+        use_columnar_conversion =
+            use_columnar_conversion && builders[col_idx].dictionary &&
+            builders[col_idx].physical_type->size() == 4 &&
+            dictionary_ids_in_range(
+                results_, col_idx, builders[col_idx].dictionary->length());
       }
 
       columnar_conversion_flags[col_idx] = use_columnar_conversion;
@@ -1414,7 +1465,15 @@ std::shared_ptr<arrow::Table> ArrowResultSetConverter::getArrowTable(
     tbb::parallel_for(tbb::blocked_range<size_t>(0, col_count),
                       [&](tbb::blocked_range<size_t> br) {
                         for (size_t col_idx = br.begin(); col_idx < br.end(); ++col_idx) {
-                          if (columnar_conversion_flags[col_idx]) {
+                          if (columnar_conversion_flags[col_idx] &&
+                              builders[col_idx].dictionary) {
+                            convert_dictionary_column(results_,
+                                                      col_idx,
+                                                      entry_count,
+                                                      builders[col_idx].field->type(),
+                                                      builders[col_idx].dictionary,
+                                                      result_columns[col_idx]);
+                          } else if (columnar_conversion_flags[col_idx]) {
                             convert_column(builders[col_idx].physical_type,
                                            results_,
                                            col_idx,
@@ -1788,6 +1847,9 @@ void ArrowResultSetConverter::initializeColumnBuilder(
 
     std::shared_ptr<arrow::StringArray> string_array;
     ARROW_THROW_NOT_OK(str_array_builder.Finish(&string_array));
+    if (do_dictionary_bulk_fetch) {
+      column_builder.dictionary = string_array;
+    }
 
     auto dict_builder =
         dynamic_cast<arrow::StringDictionary32Builder*>(column_builder.builder.get());
@@ -27,6 +27,8 @@
 
 #include "CountDistinctDescriptor.h"
 #include "HyperLogLog.h"
+#include "RoaringSet.h"
+#include "SparseHyperLogLog.h"
 
 #include "ThirdParty/robin_hood.h"
 
@@ -91,6 +93,14 @@ inline int64_t count_distinct_set_size(
     }
     return bitmap_set_size(set_vals, count_distinct_desc.bitmapSizeBytes());
   }
+  if (count_distinct_desc.impl_type_ == CountDistinctImplType::Roaring) {
+    return reinterpret_cast<RoaringSet*>(set_handle)->size();
+  }
+  if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll) {
+    CHECK_GT(count_distinct_desc.bitmap_sz_bits, 0);
+    return reinterpret_cast<SparseHll*>(set_handle)->size(
+        count_distinct_desc.bitmap_sz_bits);
+  }
   CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet);
   return reinterpret_cast<robin_hood::unordered_set<int64_t>*>(set_handle)->size();
 }
@@ -139,6 +149,18 @@ inline void count_distinct_set_union(
                                       : old_count_distinct_desc.bitmapPaddedSizeBytes();
       bitmap_set_union(new_set, old_set, bitmap_byte_sz);
     }
+  } else if (new_count_distinct_desc.impl_type_ == CountDistinctImplType::Roaring) {
+    CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::Roaring);
+    auto old_set = reinterpret_cast<RoaringSet*>(old_set_handle);
+    auto new_set = reinterpret_cast<RoaringSet*>(new_set_handle);
+    new_set->unionWith(*old_set);
+  } else if (new_count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll) {
+    CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll);
+    CHECK_EQ(new_count_distinct_desc.bitmap_sz_bits,
+             old_count_distinct_desc.bitmap_sz_bits);
+    auto old_set = reinterpret_cast<SparseHll*>(old_set_handle);
+    auto new_set = reinterpret_cast<SparseHll*>(new_set_handle);
+    new_set->unionWith(*old_set, new_count_distinct_desc.bitmap_sz_bits);
   } else {
     CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet);
     auto old_set = reinterpret_cast<robin_hood::unordered_set<int64_t>*>(old_set_handle);
@@ -745,11 +745,19 @@ void ResultSet::addCompilationQueueTime(const int64_t compilation_queue_time) {
   timings_.compilation_queue_time += compilation_queue_time;
 }
 
+void ResultSet::addReductionTime(const int64_t reduction_time) {
+  timings_.reduction_time += reduction_time;
+}
+
 int64_t ResultSet::getQueueTime() const {
   return timings_.executor_queue_time + timings_.kernel_queue_time +
          timings_.compilation_queue_time;
 }
 
+int64_t ResultSet::getReductionTime() const {
+  return timings_.reduction_time;
+}
+
 void ResultSet::moveToBegin() const {
   crt_row_buff_idx_ = 0;
   fetched_so_far_ = 0;
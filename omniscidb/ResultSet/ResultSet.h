@@ -393,13 +393,16 @@ class ResultSet {
     int64_t executor_queue_time{0};
     int64_t compilation_queue_time{0};
     int64_t kernel_queue_time{0};
+    int64_t reduction_time{0};
   };
 
   void setQueueTime(const int64_t queue_time);
   void setKernelQueueTime(const int64_t kernel_queue_time);
   void addCompilationQueueTime(const int64_t compilation_queue_time);
+  void addReductionTime(const int64_t reduction_time);
 
   int64_t getQueueTime() const;
+  int64_t getReductionTime() const;
 
   void moveToBegin() const;
 
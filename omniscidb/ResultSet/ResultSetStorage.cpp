@@ -547,3 +547,34 @@ size_t ResultSetStorage::binSearchRowCount() const {
 bool ResultSetStorage::isEmptyEntry(const size_t entry_idx) const {
   return isEmptyEntry(entry_idx, buff_);
 }
+
+void ResultSetStorage::eraseEntry(const size_t entry_idx) {
+  CHECK(query_mem_desc_.getQueryDescriptionType() ==
+        QueryDescriptionType::GroupByBaselineHash);
+  CHECK(!query_mem_desc_.hasKeylessHash());
+  CHECK_LT(entry_idx, query_mem_desc_.getEntryCount());
+  if (query_mem_desc_.didOutputColumnar()) {
+    // Emptiness of columnar entries is checked by the first key only.
+    auto key_ptr = buff_ + query_mem_desc_.getPrependedGroupColOffInBytes(0);
+    switch (query_mem_desc_.groupColWidth(0)) {
+      case 8:
+        reinterpret_cast<int64_t*>(key_ptr)[entry_idx] = EMPTY_KEY_64;
+        break;
+      case 4:
+        reinterpret_cast<int32_t*>(key_ptr)[entry_idx] = EMPTY_KEY_32;
+        break;
+      case 2:
+        reinterpret_cast<int16_t*>(key_ptr)[entry_idx] = EMPTY_KEY_16;
+        break;
+      case 1:
+        reinterpret_cast<int8_t*>(key_ptr)[entry_idx] = EMPTY_KEY_8;
+        break;
+      default:
+        CHECK(false);
+    }
+  } else {
+    result_set::fill_empty_key(row_ptr_rowwise(buff_, query_mem_desc_, entry_idx),
+                               query_mem_desc_.getGroupbyColCount(),
+                               query_mem_desc_.getEffectiveKeyWidth());
+  }
+}
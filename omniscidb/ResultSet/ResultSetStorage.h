@@ -134,6 +134,11 @@ class ResultSetStorage {
   bool isEmptyEntry(const size_t entry_idx) const;
   bool isEmptyEntryColumnar(const size_t entry_idx, const int8_t* buff) const;
 
+  // Marks a baseline hash entry as empty. Erasing breaks probing sequences, so the
+  // buffer shouldn't be used for lookups of its own keys afterwards. Inserting keys
+  // which are not present in the buffer is still safe.
+  void eraseEntry(const size_t entry_idx);
+
  private:
   void fillOneEntryRowWise(const std::vector<int64_t>& entry);
 
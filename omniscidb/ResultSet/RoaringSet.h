@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file    RoaringSet.h
+ * @brief   Compressed set of 64-bit integers used for exact COUNT(DISTINCT).
+ *
+ * Values are split into a 48-bit high part, which selects a container, and a
+ * 16-bit low part stored in it. Sparse containers keep a sorted array of low
+ * parts, dense ones switch to a fixed 8KB bitmap. This keeps memory close to
+ * the number of distinct values for sparse wide-range inputs and allows unions
+ * to be computed container by container with word-wide ORs.
+ **/
+
+#pragma once
+
+#include "ThirdParty/robin_hood.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+class RoaringSet {
+ public:
+  // An array container is converted into a bitmap when it grows past this size,
+  // which is the point where the array takes the same 8KB as the bitmap.
+  static constexpr size_t kMaxArrayContainerSize = 4096;
+  static constexpr size_t kBitmapContainerWords = (1 << 16) / 64;
+
+  void insert(const int64_t val) {
+    const auto uval = static_cast<uint64_t>(val);
+    auto& container = containers_[uval >> 16];
+    if (container.add(static_cast<uint16_t>(uval & 0xFFFF))) {
+      ++size_;
+    }
+  }
+
+  size_t size() const { return size_; }
+
+  size_t containerCount() const { return containers_.size(); }
+
+  void unionWith(const RoaringSet& other) {
+    for (const auto& kv : other.containers_) {
+      auto it = containers_.find(kv.first);
+      if (it == containers_.end()) {
+        containers_.emplace(kv.first, kv.second);
+        size_ += kv.second.cardinality;
+        continue;
+      }
+      size_ -= it->second.cardinality;
+      it->second.unionWith(kv.second);
+      size_ += it->second.cardinality;
+    }
+  }
+
+ private:
+  struct Container {
+    // Sorted low parts, used while the bitmap is empty.
+    std::vector<uint16_t> array;
+    std::vector<uint64_t> bitmap;
+    size_t cardinality{0};
+
+    bool isBitmap() const { return !bitmap.empty(); }
+
+    bool add(const uint16_t low) {
+      if (isBitmap()) {
+        return setBit(low);
+      }
+      auto it = std::lower_bound(array.begin(), array.end(), low);
+      if (it != array.end() && *it == low) {
+        return false;
+      }
+      array.insert(it, low);
+      ++cardinality;
+      if (array.size() > kMaxArrayContainerSize) {
+        toBitmap();
+      }
+      return true;
+    }
+
+    bool setBit(const uint16_t low) {
+      auto& word = bitmap[low >> 6];
+      const uint64_t mask = uint64_t(1) << (low & 63);
+      if (word & mask) {
+        return false;
+      }
+      word |= mask;
+      ++cardinality;
+      return true;
+    }
+
+    void toBitmap() {
+      bitmap.assign(kBitmapContainerWords, 0);
+      for (const auto low : array) {
+        bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+      }
+      std::vector<uint16_t>().swap(array);
+    }
+
+    void unionWith(const Container& other) {
+      if (other.isBitmap()) {
+        if (!isBitmap()) {
+          toBitmap();
+        }
+        size_t new_cardinality = 0;
+        for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+          bitmap[i] |= other.bitmap[i];
+          new_cardinality += __builtin_popcountll(bitmap[i]);
+        }
+        cardinality = new_cardinality;
+        return;
+      }
+      if (isBitmap()) {
+        for (const auto low : other.array) {
+          setBit(low);
+        }
+        return;
+      }
+      std::vector<uint16_t> merged;
+      merged.reserve(array.size() + other.array.size());
+      std::set_union(array.begin(),
+                     array.end(),
+                     other.array.begin(),
+                     other.array.end(),
+                     std::back_inserter(merged));
+      array.swap(merged);
+      cardinality = array.size();
+      if (array.size() > kMaxArrayContainerSize) {
+        toBitmap();
+      }
+    }
+  };
+
+  robin_hood::unordered_map<uint64_t, Container> containers_;
+  size_t size_{0};
+};
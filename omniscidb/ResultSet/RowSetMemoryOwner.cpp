@@ -18,6 +18,12 @@ RowSetMemoryOwner::~RowSetMemoryOwner() {
   for (auto count_distinct_set : count_distinct_sets_) {
     delete count_distinct_set;
   }
+  for (auto count_distinct_set : count_distinct_roaring_sets_) {
+    delete count_distinct_set;
+  }
+  for (auto count_distinct_sketch : count_distinct_sparse_hlls_) {
+    delete count_distinct_sketch;
+  }
   for (auto group_by_buffer : group_by_buffers_) {
     free(group_by_buffer);
   }
@@ -17,10 +17,12 @@
 #pragma once
 
 #include <boost/noncopyable.hpp>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -29,6 +31,8 @@
 #include "DataMgr/DataMgr.h"
 #include "DataProvider/DataProvider.h"
 #include "Logger/Logger.h"
+#include "ResultSet/RoaringSet.h"
+#include "ResultSet/SparseHyperLogLog.h"
 #include "Shared/approx_quantile.h"
 #include "Shared/quantile.h"
 #include "Shared/thread_count.h"
@@ -132,6 +136,16 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     count_distinct_sets_.push_back(count_distinct_set);
   }
 
+  void addCountDistinctRoaringSet(RoaringSet* count_distinct_set) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    count_distinct_roaring_sets_.push_back(count_distinct_set);
+  }
+
+  void addCountDistinctSparseHll(SparseHll* count_distinct_sketch) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    count_distinct_sparse_hlls_.push_back(count_distinct_sketch);
+  }
+
   void addGroupByBuffer(int64_t* group_by_buffer) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     group_by_buffers_.push_back(group_by_buffer);
@@ -223,6 +237,26 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     return &it->second;
   }
 
+  // Maps ids of the proxy to ids of transformed strings added to the same proxy,
+  // so the transform is computed once per dictionary entry rather than per row.
+  // Maps are cached per dictionary generation and transform.
+  const std::vector<int32_t>* addStringProxyTransformTranslationMap(
+      StringDictionary* proxy,
+      const std::string& transform_name,
+      const std::function<std::string(const std::string&)>& transform) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    const auto map_key = std::make_tuple(proxy->getBaseDictionary()->getDictId(),
+                                         proxy->getBaseGeneration(),
+                                         transform_name);
+    auto it = str_proxy_transform_translation_maps_owned_.find(map_key);
+    if (it == str_proxy_transform_translation_maps_owned_.end()) {
+      it = str_proxy_transform_translation_maps_owned_
+               .emplace(map_key, proxy->buildTransformTranslationMap(transform))
+               .first;
+    }
+    return &it->second;
+  }
+
   StringDictionary* getStringDictProxy(const int dict_id) const {
     std::lock_guard<std::mutex> lock(state_mutex_);
     auto it = str_dict_proxy_owned_.find(dict_id);
@@ -285,6 +319,8 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
 
   std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
   std::vector<robin_hood::unordered_set<int64_t>*> count_distinct_sets_;
+  std::vector<RoaringSet*> count_distinct_roaring_sets_;
+  std::vector<SparseHll*> count_distinct_sparse_hlls_;
   std::vector<int64_t*> group_by_buffers_;
   std::vector<void*> varlen_buffers_;
   std::list<std::string> strings_;
@@ -294,6 +330,8 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
       str_proxy_intersection_translation_maps_owned_;
   std::map<std::pair<int, int>, std::vector<int32_t>>
       str_proxy_union_translation_maps_owned_;
+  std::map<std::tuple<int, int64_t, std::string>, std::vector<int32_t>>
+      str_proxy_transform_translation_maps_owned_;
   std::shared_ptr<StringDictionary> lit_str_dict_proxy_;
   std::vector<void*> col_buffers_;
   std::vector<Data_Namespace::AbstractBuffer*> varlen_input_buffers_;
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file    SparseHyperLogLog.h
+ * @brief   HyperLogLog sketch which starts in a sparse representation.
+ *
+ * Dense HyperLogLog records take 2^b registers regardless of the number of
+ * values seen. For group-by queries with many small groups most of those
+ * registers stay zero, so the sketch keeps a sorted list of non-zero registers
+ * and switches to dense registers once the list grows to half of the dense size.
+ * The estimate is always computed from the dense registers, which makes results
+ * identical to the dense implementation.
+ **/
+
+#pragma once
+
+#include "HyperLogLog.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class SparseHll {
+ public:
+  void update(const uint32_t index, const uint8_t rank, const uint32_t b) {
+    if (!isSparse()) {
+      dense_[index] = std::max(dense_[index], rank);
+      return;
+    }
+    const auto entry = pack(index, rank);
+    auto it = std::lower_bound(sparse_.begin(), sparse_.end(), pack(index, 0));
+    if (it != sparse_.end() && (*it >> 8) == index) {
+      *it = std::max(*it, entry);
+      return;
+    }
+    sparse_.insert(it, entry);
+    if (sparse_.size() > sparseLimit(b)) {
+      toDense(b);
+    }
+  }
+
+  size_t size(const uint32_t b) const {
+    if (!isSparse()) {
+      return hll_size(dense_.data(), b);
+    }
+    if (sparse_.empty()) {
+      return 0;
+    }
+    std::vector<uint8_t> registers(size_t(1) << b, 0);
+    for (const auto entry : sparse_) {
+      registers[entry >> 8] = static_cast<uint8_t>(entry & 0xFF);
+    }
+    return hll_size(registers.data(), b);
+  }
+
+  void unionWith(const SparseHll& other, const uint32_t b) {
+    if (other.isSparse()) {
+      for (const auto entry : other.sparse_) {
+        update(entry >> 8, static_cast<uint8_t>(entry & 0xFF), b);
+      }
+      return;
+    }
+    if (isSparse()) {
+      toDense(b);
+    }
+    for (size_t i = 0; i < dense_.size(); ++i) {
+      dense_[i] = std::max(dense_[i], other.dense_[i]);
+    }
+  }
+
+  bool isSparse() const { return dense_.empty(); }
+
+ private:
+  static uint32_t pack(const uint32_t index, const uint8_t rank) {
+    return (index << 8) | rank;
+  }
+
+  static size_t sparseLimit(const uint32_t b) {
+    return (size_t(1) << b) / (2 * sizeof(uint32_t));
+  }
+
+  void toDense(const uint32_t b) {
+    dense_.assign(size_t(1) << b, 0);
+    for (const auto entry : sparse_) {
+      dense_[entry >> 8] = static_cast<uint8_t>(entry & 0xFF);
+    }
+    std::vector<uint32_t>().swap(sparse_);
+  }
+
+  // Sorted non-zero registers packed as (index << 8) | rank.
+  std::vector<uint32_t> sparse_;
+  std::vector<uint8_t> dense_;
+};
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "IR/Type.h"
+#include "Logger/Logger.h"
+#include "StringDictionary/StringDictionary.h"
+
+#include <memory>
+#include <vector>
+
+namespace hdk {
+
+/**
+ * Values of a fixed-width column for a range of rows. Values are stored in
+ * the column's physical representation: dictionary encoded strings are kept
+ * as ids to be decoded with the attached dictionary, date and time values
+ * and decimals are kept as encoded integers. Null values hold the type's
+ * null sentinel and are also marked in the null mask.
+ */
+struct ColumnSpan {
+  const hdk::ir::Type* type = nullptr;
+  std::vector<int8_t> data;
+  std::vector<uint8_t> nulls;
+  std::shared_ptr<StringDictionary> dict;
+
+  template <typename T>
+  const T* values() const {
+    CHECK_EQ(sizeof(T), static_cast<size_t>(type->size()));
+    return reinterpret_cast<const T*>(data.data());
+  }
+
+  bool isNull(size_t row_idx) const { return nulls[row_idx]; }
+};
+
+struct ColumnBatch {
+  size_t row_count = 0;
+  std::vector<ColumnSpan> columns;
+};
+
+}  // namespace hdk
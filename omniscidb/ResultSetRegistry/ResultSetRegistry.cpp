@@ -59,6 +59,45 @@ size_t columnIndex(int col_id) {
   return ResultSetTableToken::columnIndex(col_id);
 }
 
+template <typename T>
+void fill_null_mask(const int8_t* data, size_t count, uint8_t* nulls) {
+  auto vals = reinterpret_cast<const T*>(data);
+  for (size_t i = 0; i < count; ++i) {
+    nulls[i] = vals[i] == inline_null_value<T>();
+  }
+}
+
+void fill_null_mask(const hdk::ir::Type* type,
+                    const int8_t* data,
+                    size_t count,
+                    uint8_t* nulls) {
+  if (type->isFloatingPoint()) {
+    if (type->size() == 4) {
+      fill_null_mask<float>(data, count, nulls);
+    } else {
+      CHECK_EQ(type->size(), 8);
+      fill_null_mask<double>(data, count, nulls);
+    }
+    return;
+  }
+  switch (type->size()) {
+    case 1:
+      fill_null_mask<int8_t>(data, count, nulls);
+      break;
+    case 2:
+      fill_null_mask<int16_t>(data, count, nulls);
+      break;
+    case 4:
+      fill_null_mask<int32_t>(data, count, nulls);
+      break;
+    case 8:
+      fill_null_mask<int64_t>(data, count, nulls);
+      break;
+    default:
+      CHECK(false) << "Unexpected type: " << type->toString();
+  }
+}
+
 }  // namespace
 
 ResultSetRegistry::ResultSetRegistry(ConfigPtr config)
@@ -459,34 +498,11 @@ ResultSetRegistry::getZeroCopyBufferMemory(const ChunkKey& key, size_t num_bytes
   // clean-up tokens we are not going to use in TemporaryTables of
   // RelAlgExecutor.
   if (table.use_columnar_res) {
-    mapd_shared_lock<mapd_shared_mutex> frag_read_lock(*frag.mutex);
-    if (frag.columnar_res) {
-      if (key.size() < 5 || key[CHUNK_KEY_VARLEN_IDX] == 1) {
-        buf = frag.columnar_res->getColumnBuffers()[col_idx];
-      } else {
-        buf = frag.columnar_res->getOffsetBuffers()[col_idx];
-      }
+    auto columnar_res = getColumnarResults(frag);
+    if (key.size() < 5 || key[CHUNK_KEY_VARLEN_IDX] == 1) {
+      buf = columnar_res->getColumnBuffers()[col_idx];
     } else {
-      frag_read_lock.unlock();
-      mapd_unique_lock<mapd_shared_mutex> frag_write_lock(*frag.mutex);
-      if (!frag.columnar_res) {
-        std::vector<const hdk::ir::Type*> col_types;
-        for (size_t i = 0; i < frag.rs->colCount(); ++i) {
-          col_types.push_back(frag.rs->colType(i)->canonicalize());
-        }
-        frag.columnar_res =
-            std::make_unique<ColumnarResults>(frag.rs->getRowSetMemOwner(),
-                                              *frag.rs,
-                                              frag.rs->colCount(),
-                                              col_types,
-                                              0,
-                                              *config_);
-      }
-      if (key.size() < 5 || key[CHUNK_KEY_VARLEN_IDX] == 1) {
-        buf = frag.columnar_res->getColumnBuffers()[col_idx];
-      } else {
-        buf = frag.columnar_res->getOffsetBuffers()[col_idx];
-      }
+      buf = columnar_res->getOffsetBuffers()[col_idx];
     }
   } else if (frag.rs->isZeroCopyColumnarConversionPossible(col_idx)) {
     CHECK_EQ(key.size(), (size_t)4);
@@ -498,6 +514,109 @@ ResultSetRegistry::getZeroCopyBufferMemory(const ChunkKey& key, size_t num_bytes
              : nullptr;
 }
 
+ColumnBatch ResultSetRegistry::fetchColumns(const ResultSetTableToken& token,
+                                            size_t row_offset,
+                                            size_t row_count) const {
+  auto timer = DEBUG_TIMER(__func__);
+  mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+  CHECK_EQ(tables_.count(token.tableId()), (size_t)1);
+  auto& table = *tables_.at(token.tableId());
+  mapd_shared_lock<mapd_shared_mutex> table_lock(table.mutex);
+
+  row_offset = std::min(row_offset, table.row_count);
+  row_count = std::min(row_count, table.row_count - row_offset);
+
+  ColumnBatch res;
+  res.row_count = row_count;
+  const size_t col_count = token.colCount();
+  for (size_t col_idx = 0; col_idx < col_count; ++col_idx) {
+    auto col_info = getColumnInfo(db_id_, token.tableId(), columnId(col_idx));
+    CHECK(col_info);
+    auto& col = res.columns.emplace_back();
+    // ColumnarResults hold canonicalized values.
+    col.type = table.use_columnar_res ? col_info->type->canonicalize() : col_info->type;
+    if (col.type->isVarLen() || col.type->isArray()) {
+      throw std::runtime_error("Batch fetch is not supported for column type " +
+                               col.type->toString());
+    }
+    col.data.resize(row_count * col.type->size());
+    if (auto dict_type = col.type->as<hdk::ir::ExtDictionaryType>()) {
+      CHECK(dicts_.count(dict_type->dictId()));
+      col.dict = dicts_.at(dict_type->dictId())->dict_descriptor->stringDict;
+    }
+  }
+  data_lock.unlock();
+
+  const size_t end_row = row_offset + row_count;
+  for (auto& frag : table.fragments) {
+    const size_t frag_end = frag.offset + frag.row_count;
+    if (frag_end <= row_offset || frag.row_count == 0) {
+      continue;
+    }
+    if (frag.offset >= end_row) {
+      break;
+    }
+    const size_t begin = std::max(row_offset, frag.offset);
+    const size_t end = std::min(end_row, frag_end);
+    for (size_t col_idx = 0; col_idx < col_count; ++col_idx) {
+      auto& col = res.columns[col_idx];
+      const size_t elem_size = col.type->size();
+      int8_t* dst = col.data.data() + (begin - row_offset) * elem_size;
+      if (table.use_columnar_res) {
+        auto src = getColumnarResults(frag)->getColumnBuffers()[col_idx];
+        std::memcpy(
+            dst, src + (begin - frag.offset) * elem_size, (end - begin) * elem_size);
+        continue;
+      }
+      CHECK_EQ(frag.rs->colType(col_idx)->size(), col.type->size());
+      // Copy the requested part of the fragment chunk by chunk.
+      size_t chunk_offset = frag.offset;
+      for (auto& chunk : frag.rs->getChunkedColumnarBuffer(col_idx)) {
+        const size_t chunk_begin = std::max(begin, chunk_offset);
+        const size_t chunk_end = std::min(end, chunk_offset + chunk.second);
+        if (chunk_begin < chunk_end) {
+          std::memcpy(dst + (chunk_begin - begin) * elem_size,
+                      chunk.first + (chunk_begin - chunk_offset) * elem_size,
+                      (chunk_end - chunk_begin) * elem_size);
+        }
+        chunk_offset += chunk.second;
+      }
+    }
+  }
+
+  for (auto& col : res.columns) {
+    col.nulls.resize(row_count, 0);
+    if (col.type->nullable()) {
+      fill_null_mask(col.type, col.data.data(), row_count, col.nulls.data());
+    }
+  }
+
+  return res;
+}
+
+const ColumnarResults* ResultSetRegistry::getColumnarResults(DataFragment& frag) const {
+  {
+    mapd_shared_lock<mapd_shared_mutex> frag_read_lock(*frag.mutex);
+    if (frag.columnar_res) {
+      return frag.columnar_res.get();
+    }
+  }
+  mapd_unique_lock<mapd_shared_mutex> frag_write_lock(*frag.mutex);
+  if (!frag.columnar_res) {
+    std::vector<const hdk::ir::Type*> col_types;
+    for (size_t i = 0; i < frag.rs->colCount(); ++i) {
+      col_types.push_back(frag.rs->colType(i)->canonicalize());
+    }
+    frag.columnar_res = std::make_unique<ColumnarResults>(frag.rs->getRowSetMemOwner(),
+                                                          *frag.rs,
+                                                          frag.rs->colCount(),
+                                                          col_types,
+                                                          0,
+                                                          *config_);
+  }
+  return frag.columnar_res.get();
+}
+
 std::shared_ptr<const TableFragmentsInfo> ResultSetRegistry::getTableMetadata(
     int db_id,
     int table_id) const {
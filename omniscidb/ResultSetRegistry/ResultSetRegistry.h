@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "ColumnBatch.h"
 #include "ColumnarResults.h"
 #include "ResultSetTableToken.h"
 
@@ -44,6 +45,10 @@ class ResultSetRegistry : public SimpleSchemaProvider,
   ResultSetTableTokenPtr head(const ResultSetTableToken& token, size_t n);
   ResultSetTableTokenPtr tail(const ResultSetTableToken& token, size_t n);
 
+  ColumnBatch fetchColumns(const ResultSetTableToken& token,
+                           size_t row_offset,
+                           size_t row_count) const;
+
   void fetchBuffer(const ChunkKey& key,
                    Data_Namespace::AbstractBuffer* dest,
                    const size_t num_bytes = 0) override;
@@ -73,6 +78,8 @@ class ResultSetRegistry : public SimpleSchemaProvider,
     ChunkMetadataMap meta;
   };
 
+  const ColumnarResults* getColumnarResults(DataFragment& frag) const;
+
   struct TableData {
     mapd_shared_mutex mutex;
     std::vector<DataFragment> fragments;
@@ -54,6 +54,14 @@ class ResultSetTable {
     }
   }
 
+  int64_t getReductionTime() const {
+    int64_t res = 0;
+    for (auto& rs : results_) {
+      res += rs->getReductionTime();
+    }
+    return res;
+  }
+
   void setValidationOnlyRes() {
     if (!empty()) {
       results_.front()->setValidationOnlyRes();
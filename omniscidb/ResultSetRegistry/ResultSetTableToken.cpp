@@ -84,6 +84,10 @@ std::vector<TargetValue> ResultSetTableToken::row(size_t row_idx,
   throw std::runtime_error("Out-of-bound row index.");
 }
 
+ColumnBatch ResultSetTableToken::fetchColumns(size_t row_offset, size_t row_count) const {
+  return registry_->fetchColumns(*this, row_offset, row_count);
+}
+
 std::string ResultSetTableToken::description() const {
   auto first_rs = resultSet(0);
   auto last_rs = resultSet(resultSetCount() - 1);
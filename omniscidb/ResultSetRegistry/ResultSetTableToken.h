@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "ColumnBatch.h"
 #include "ResultSetTable.h"
 
 #include "DataMgr/ChunkMetadata.h"
@@ -133,6 +134,10 @@ class ResultSetTableToken : public std::enable_shared_from_this<ResultSetTableTo
                                bool translate_strings,
                                bool decimal_to_double) const;
 
+  // Fetches fixed-width columns for up to row_count rows starting from
+  // row_offset. Avoids building a TargetValue for each cell.
+  ColumnBatch fetchColumns(size_t row_offset, size_t row_count) const;
+
   std::string toString() const {
     return "ResultSetTableToken(" + std::to_string(dbId()) + ":" +
            std::to_string(tableId()) + ")";
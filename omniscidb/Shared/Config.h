@@ -57,6 +57,17 @@ struct GroupByConfig {
   size_t min_partitions = 0;
   size_t max_partitions = 1024;
   size_t partitioning_buffer_target_size = 32 << 20;
+  bool enable_adaptive_groupby = false;
+  bool enable_skew_aware_partitioning = false;
+  double partitioning_skew_threshold = 4.0;
+  bool enable_tree_reduction = true;
+  size_t tree_reduction_threshold = 4;
+  bool enable_roaring_count_distinct = false;
+  double roaring_count_distinct_min_density = 8.0;
+  size_t roaring_count_distinct_bitmap_threshold = 256 << 20;
+  bool enable_sparse_hll = true;
+  size_t sparse_hll_groups_threshold = 4096;
+  bool enable_partitioned_top_n = false;
 };
 
 struct WindowFunctionsConfig {
@@ -103,6 +114,8 @@ struct ExecutionConfig {
 
   size_t streaming_topn_max = 100'000;
   size_t parallel_top_min = 100'000;
+  bool enable_radix_sort = false;
+  size_t radix_sort_min = 100'000;
   bool enable_experimental_string_functions = false;
   bool enable_interop = false;
   size_t parallel_linearization_threshold = 10'000;
@@ -181,11 +194,18 @@ struct DebugConfig {
   bool enable_gpu_code_compilation_cache = true;
   std::string log_dir = "hdk_log";
   short dump_llvm_ir_after_each_pass{0};
+  bool enable_query_trace = false;
+  // Directory for query trace files, log_dir is used when empty.
+  std::string query_trace_dir = "";
+  bool enable_perf_counters = false;
 };
 
 struct StorageConfig {
   bool enable_lazy_dict_materialization = false;
   bool enable_non_lazy_data_import = false;
+  bool share_dicts_by_column_name = false;
+  bool enable_sorted_dict_import = false;
+  size_t background_dict_materialization_threads = 0;
 };
 
 struct Config {
@@ -0,0 +1,335 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Shared/Metrics.h"
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace metrics {
+
+namespace {
+
+std::string labels_key(const Labels& labels) {
+  std::string res;
+  for (auto& [name, value] : labels) {
+    res += name;
+    res += '=';
+    res += value;
+    res += ',';
+  }
+  return res;
+}
+
+std::string escape_label_value(const std::string& value) {
+  std::string res;
+  for (auto c : value) {
+    if (c == '\\' || c == '"') {
+      res += '\\';
+      res += c;
+    } else if (c == '\n') {
+      res += "\\n";
+    } else {
+      res += c;
+    }
+  }
+  return res;
+}
+
+std::string format_value(double value) {
+  if (value == std::numeric_limits<double>::infinity()) {
+    return "+Inf";
+  }
+  std::ostringstream ss;
+  ss.precision(std::numeric_limits<double>::max_digits10);
+  ss << value;
+  return ss.str();
+}
+
+void write_labels(std::ostream& os, const Labels& labels, const std::string& le = "") {
+  if (labels.empty() && le.empty()) {
+    return;
+  }
+  os << '{';
+  bool first = true;
+  for (auto& [name, value] : labels) {
+    os << (first ? "" : ",") << name << "=\"" << escape_label_value(value) << '"';
+    first = false;
+  }
+  if (!le.empty()) {
+    os << (first ? "" : ",") << "le=\"" << le << '"';
+  }
+  os << '}';
+}
+
+std::string_view type_name(MetricType type) {
+  switch (type) {
+    case MetricType::kCounter:
+      return "counter";
+    case MetricType::kGauge:
+      return "gauge";
+    case MetricType::kHistogram:
+      return "histogram";
+  }
+  UNREACHABLE();
+  return "";
+}
+
+}  // namespace
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds))
+    , bucket_counts_(new std::atomic<uint64_t>[bounds_.size() + 1]) {
+  CHECK(std::is_sorted(bounds_.begin(), bounds_.end()));
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    bucket_counts_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::observe(double value) {
+  auto bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+  bucket_counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  auto sum = sum_.load(std::memory_order_relaxed);
+  while (!sum_.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<uint64_t> Histogram::bucketCounts() const {
+  std::vector<uint64_t> res(bounds_.size() + 1);
+  for (size_t i = 0; i < res.size(); ++i) {
+    res[i] = bucket_counts_[i].load(std::memory_order_relaxed);
+  }
+  return res;
+}
+
+void Histogram::reset() {
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    bucket_counts_[i].store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<double> time_buckets() {
+  return {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+          0.1,    0.25,    0.5,    1,     2.5,    5,     10,   25,    100};
+}
+
+Registry::Metric& Registry::getMetric(const std::string& name,
+                                      const std::string& help,
+                                      const Labels& labels,
+                                      MetricType type) {
+  auto& family = families_.try_emplace(name, Family{type, help, {}}).first->second;
+  CHECK(family.type == type) << "Metric " << name << " is registered as "
+                             << type_name(family.type);
+  auto& metric = family.metrics[labels_key(labels)];
+  if (metric.labels.empty()) {
+    metric.labels = labels;
+  }
+  return metric;
+}
+
+Counter& Registry::counter(const std::string& name,
+                           const std::string& help,
+                           const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric = getMetric(name, help, labels, MetricType::kCounter);
+  if (!metric.counter) {
+    metric.counter = std::make_unique<Counter>();
+  }
+  return *metric.counter;
+}
+
+Gauge& Registry::gauge(const std::string& name,
+                       const std::string& help,
+                       const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric = getMetric(name, help, labels, MetricType::kGauge);
+  if (!metric.gauge) {
+    metric.gauge = std::make_unique<Gauge>();
+  }
+  return *metric.gauge;
+}
+
+Histogram& Registry::histogram(const std::string& name,
+                               const std::string& help,
+                               const Labels& labels,
+                               const std::vector<double>& bounds) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric = getMetric(name, help, labels, MetricType::kHistogram);
+  if (!metric.histogram) {
+    metric.histogram = std::make_unique<Histogram>(bounds);
+  }
+  return *metric.histogram;
+}
+
+Registry::CollectorId Registry::addCollector(Collector collector) {
+  std::lock_guard<std::mutex> lock(collectors_mutex_);
+  auto id = next_collector_id_++;
+  collectors_.emplace(id, std::move(collector));
+  return id;
+}
+
+void Registry::removeCollector(CollectorId id) {
+  std::lock_guard<std::mutex> lock(collectors_mutex_);
+  collectors_.erase(id);
+}
+
+void Registry::collect() {
+  std::lock_guard<std::mutex> lock(collectors_mutex_);
+  for (auto& [id, collector] : collectors_) {
+    collector(*this);
+  }
+}
+
+Registry::Metric* Registry::findMetric(const std::string& name, const Labels& labels) {
+  auto family_it = families_.find(name);
+  if (family_it == families_.end()) {
+    return nullptr;
+  }
+  auto metric_it = family_it->second.metrics.find(labels_key(labels));
+  return metric_it == family_it->second.metrics.end() ? nullptr : &metric_it->second;
+}
+
+std::optional<double> Registry::value(const std::string& name, const Labels& labels) {
+  collect();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto metric = findMetric(name, labels);
+  if (metric && metric->counter) {
+    return static_cast<double>(metric->counter->value());
+  }
+  if (metric && metric->gauge) {
+    return static_cast<double>(metric->gauge->value());
+  }
+  return std::nullopt;
+}
+
+const Histogram* Registry::findHistogram(const std::string& name,
+                                         const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto metric = findMetric(name, labels);
+  return metric ? metric->histogram.get() : nullptr;
+}
+
+std::vector<Registry::Sample> Registry::snapshot() {
+  collect();
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Sample> res;
+  for (auto& [name, family] : families_) {
+    for (auto& [key, metric] : family.metrics) {
+      if (metric.counter) {
+        res.push_back({name, metric.labels, double(metric.counter->value())});
+      } else if (metric.gauge) {
+        res.push_back({name, metric.labels, double(metric.gauge->value())});
+      } else if (metric.histogram) {
+        auto& bounds = metric.histogram->bounds();
+        auto counts = metric.histogram->bucketCounts();
+        uint64_t cumulative_count = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+          cumulative_count += counts[i];
+          auto le = i < bounds.size() ? bounds[i]
+                                      : std::numeric_limits<double>::infinity();
+          auto labels = metric.labels;
+          labels.emplace_back("le", format_value(le));
+          res.push_back({name + "_bucket", std::move(labels), double(cumulative_count)});
+        }
+        res.push_back({name + "_sum", metric.labels, metric.histogram->sum()});
+        res.push_back(
+            {name + "_count", metric.labels, double(metric.histogram->count())});
+      }
+    }
+  }
+  return res;
+}
+
+std::string Registry::toPrometheus() {
+  collect();
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream os;
+  for (auto& [name, family] : families_) {
+    os << "# HELP " << name << ' ' << family.help << '\n';
+    os << "# TYPE " << name << ' ' << type_name(family.type) << '\n';
+    for (auto& [key, metric] : family.metrics) {
+      if (metric.counter) {
+        os << name;
+        write_labels(os, metric.labels);
+        os << ' ' << metric.counter->value() << '\n';
+      } else if (metric.gauge) {
+        os << name;
+        write_labels(os, metric.labels);
+        os << ' ' << metric.gauge->value() << '\n';
+      } else if (metric.histogram) {
+        auto& bounds = metric.histogram->bounds();
+        auto counts = metric.histogram->bucketCounts();
+        uint64_t cumulative_count = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+          cumulative_count += counts[i];
+          os << name << "_bucket";
+          write_labels(os,
+                       metric.labels,
+                       format_value(i < bounds.size()
+                                        ? bounds[i]
+                                        : std::numeric_limits<double>::infinity()));
+          os << ' ' << cumulative_count << '\n';
+        }
+        os << name << "_sum";
+        write_labels(os, metric.labels);
+        os << ' ' << format_value(metric.histogram->sum()) << '\n';
+        os << name << "_count";
+        write_labels(os, metric.labels);
+        os << ' ' << metric.histogram->count() << '\n';
+      }
+    }
+  }
+  return os.str();
+}
+
+void Registry::dumpPrometheus(const std::string& path) {
+  auto text = toPrometheus();
+  // Write to a temporary file first, so scrapers never see a partial dump.
+  auto tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path);
+    out << text;
+    out.close();
+    if (out.fail()) {
+      throw std::runtime_error("Cannot write metrics to " + tmp_path);
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str())) {
+    std::remove(tmp_path.c_str());
+    throw std::runtime_error("Cannot write metrics to " + path);
+  }
+}
+
+void Registry::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [name, family] : families_) {
+    for (auto& [key, metric] : family.metrics) {
+      if (metric.counter) {
+        metric.counter->reset();
+      }
+      if (metric.histogram) {
+        metric.histogram->reset();
+      }
+    }
+  }
+}
+
+Registry& registry() {
+  static Registry registry;
+  return registry;
+}
+
+}  // namespace metrics
@@ -0,0 +1,156 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file    Metrics.h
+ * @brief   Engine-wide registry of counters, gauges and histograms.
+ *
+ * Metrics are registered on the first use and live until the process exits, so
+ * references returned by the registry can be cached, e.g. in static variables.
+ * Updates are lock-free. Values which are expensive to track on every change
+ * (e.g. buffer pool residency) are refreshed by collectors right before the
+ * registry is read.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace metrics {
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+class Counter {
+ public:
+  void inc(uint64_t value = 1) { value_.fetch_add(value, std::memory_order_relaxed); }
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+  void reset() { value_.store(0, std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+class Gauge {
+ public:
+  void set(int64_t value) { value_.store(value, std::memory_order_relaxed); }
+  void add(int64_t value) { value_.fetch_add(value, std::memory_order_relaxed); }
+  void sub(int64_t value) { value_.fetch_sub(value, std::memory_order_relaxed); }
+  int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+class Histogram {
+ public:
+  // Upper bounds of buckets in ascending order, +Inf bucket is implicit.
+  explicit Histogram(std::vector<double> bounds);
+
+  void observe(double value);
+
+  const std::vector<double>& bounds() const { return bounds_; }
+  // Non-cumulative counts, the last one is for the +Inf bucket.
+  std::vector<uint64_t> bucketCounts() const;
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  double sum() const { return sum_.load(std::memory_order_relaxed); }
+  void reset();
+
+ private:
+  const std::vector<double> bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> bucket_counts_;
+  std::atomic<uint64_t> count_{0};
+  std::atomic<double> sum_{0};
+};
+
+// Buckets for durations in seconds, from 100us to 100s.
+std::vector<double> time_buckets();
+
+enum class MetricType { kCounter, kGauge, kHistogram };
+
+class Registry {
+ public:
+  using Collector = std::function<void(Registry&)>;
+  using CollectorId = size_t;
+
+  Counter& counter(const std::string& name,
+                   const std::string& help,
+                   const Labels& labels = {});
+  Gauge& gauge(const std::string& name,
+               const std::string& help,
+               const Labels& labels = {});
+  Histogram& histogram(const std::string& name,
+                       const std::string& help,
+                       const Labels& labels = {},
+                       const std::vector<double>& bounds = time_buckets());
+
+  // Collectors are called before metrics are read. Removal waits for a running
+  // collection to finish, so a collector can safely capture its owner.
+  CollectorId addCollector(Collector collector);
+  void removeCollector(CollectorId id);
+
+  // Current value of a counter or a gauge, std::nullopt if it was not registered.
+  std::optional<double> value(const std::string& name, const Labels& labels = {});
+  // Histogram with the given name and labels, nullptr if it was not registered.
+  const Histogram* findHistogram(const std::string& name, const Labels& labels = {});
+
+  struct Sample {
+    std::string name;
+    Labels labels;
+    double value;
+  };
+
+  // Current values as Prometheus samples. A histogram is reported as cumulative
+  // <name>_bucket samples with the "le" label, <name>_sum and <name>_count.
+  std::vector<Sample> snapshot();
+
+  // Metrics in the Prometheus text exposition format.
+  std::string toPrometheus();
+  // Throws std::runtime_error if the file cannot be written.
+  void dumpPrometheus(const std::string& path);
+
+  // Zero all counters and histograms. Gauges reflect the current state and are kept.
+  void reset();
+
+ private:
+  struct Metric {
+    Labels labels;
+    std::unique_ptr<Counter> counter;
+    std::unique_ptr<Gauge> gauge;
+    std::unique_ptr<Histogram> histogram;
+  };
+
+  struct Family {
+    MetricType type;
+    std::string help;
+    std::map<std::string, Metric> metrics;
+  };
+
+  Metric& getMetric(const std::string& name,
+                    const std::string& help,
+                    const Labels& labels,
+                    MetricType type);
+  Metric* findMetric(const std::string& name, const Labels& labels);
+  void collect();
+
+  std::mutex mutex_;
+  std::map<std::string, Family> families_;
+
+  std::mutex collectors_mutex_;
+  std::map<CollectorId, Collector> collectors_;
+  CollectorId next_collector_id_{0};
+};
+
+Registry& registry();
+
+}  // namespace metrics
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file    parallel_radix_sort.h
+ * @brief   Parallel LSD radix sort of values by fixed-width keys.
+ *
+ * Keys are normalized into unsigned integers of the same width whose natural
+ * order matches the order of the original keys, so each pass is a plain
+ * counting sort by an 8-bit digit. Digits which are equal for all keys are
+ * skipped, which makes narrow value ranges cheap to sort even for wide types.
+ **/
+
+#pragma once
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace radix_sort {
+
+template <typename T>
+using RadixKey = std::conditional_t<
+    sizeof(T) == 1,
+    uint8_t,
+    std::conditional_t<sizeof(T) == 2,
+                       uint16_t,
+                       std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+// Maps a value to an unsigned key with the same order. Negative floating point
+// values have all bits inverted, so larger magnitudes go first.
+template <typename T>
+RadixKey<T> to_radix_key(const T val) {
+  using KeyT = RadixKey<T>;
+  static_assert(sizeof(T) == sizeof(KeyT));
+  constexpr KeyT sign_bit = KeyT(1) << (sizeof(KeyT) * 8 - 1);
+  KeyT bits;
+  std::memcpy(&bits, &val, sizeof(bits));
+  if constexpr (std::is_floating_point_v<T>) {
+    return (bits & sign_bit) ? KeyT(~bits) : KeyT(bits | sign_bit);
+  } else if constexpr (std::is_signed_v<T>) {
+    return KeyT(bits ^ sign_bit);
+  } else {
+    return bits;
+  }
+}
+
+template <typename T>
+T from_radix_key(const RadixKey<T> key) {
+  using KeyT = RadixKey<T>;
+  constexpr KeyT sign_bit = KeyT(1) << (sizeof(KeyT) * 8 - 1);
+  KeyT bits;
+  if constexpr (std::is_floating_point_v<T>) {
+    bits = (key & sign_bit) ? KeyT(key ^ sign_bit) : KeyT(~key);
+  } else if constexpr (std::is_signed_v<T>) {
+    bits = KeyT(key ^ sign_bit);
+  } else {
+    bits = key;
+  }
+  T val;
+  std::memcpy(&val, &bits, sizeof(val));
+  return val;
+}
+
+// Input is split into chunks which are histogrammed and scattered independently.
+constexpr size_t kMinChunkSize = 1 << 14;
+
+}  // namespace radix_sort
+
+// Stable sort of keys and values by keys. Both arrays are reordered.
+template <typename T, typename V>
+void parallel_radix_sort_by_key(T* keys, V* values, const size_t size, const bool desc) {
+  using KeyT = radix_sort::RadixKey<T>;
+  if (size < 2) {
+    return;
+  }
+
+  const KeyT flip = desc ? KeyT(~KeyT(0)) : KeyT(0);
+  std::vector<KeyT> key_buff(size);
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+          key_buff[i] = KeyT(radix_sort::to_radix_key(keys[i]) ^ flip);
+        }
+      });
+
+  // Bits which differ from the first key in at least one key.
+  const KeyT first_key = key_buff.front();
+  const KeyT diff = tbb::parallel_reduce(
+      tbb::blocked_range<size_t>(0, size),
+      KeyT(0),
+      [&](const tbb::blocked_range<size_t>& r, KeyT res) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+          res |= key_buff[i] ^ first_key;
+        }
+        return res;
+      },
+      std::bit_or<KeyT>());
+  if (!diff) {
+    return;
+  }
+
+  const size_t max_chunks =
+      static_cast<size_t>(tbb::this_task_arena::max_concurrency()) * 4;
+  const size_t num_chunks =
+      std::max(size_t(1), std::min(size / radix_sort::kMinChunkSize, max_chunks));
+  auto chunk_begin = [size, num_chunks](size_t chunk_idx) {
+    return size * chunk_idx / num_chunks;
+  };
+
+  std::vector<KeyT> tmp_keys(size);
+  std::vector<V> tmp_values(size);
+  std::vector<std::array<size_t, 256>> offsets(num_chunks);
+  KeyT* src_keys = key_buff.data();
+  KeyT* dst_keys = tmp_keys.data();
+  V* src_values = values;
+  V* dst_values = tmp_values.data();
+  for (size_t shift = 0; shift < sizeof(KeyT) * 8; shift += 8) {
+    if (!((diff >> shift) & 0xFF)) {
+      continue;
+    }
+    tbb::parallel_for(size_t(0), num_chunks, [&](size_t chunk_idx) {
+      auto& hist = offsets[chunk_idx];
+      hist.fill(0);
+      for (size_t i = chunk_begin(chunk_idx); i < chunk_begin(chunk_idx + 1); ++i) {
+        ++hist[(src_keys[i] >> shift) & 0xFF];
+      }
+    });
+    size_t pos = 0;
+    for (size_t digit = 0; digit < 256; ++digit) {
+      for (auto& hist : offsets) {
+        const auto count = hist[digit];
+        hist[digit] = pos;
+        pos += count;
+      }
+    }
+    tbb::parallel_for(size_t(0), num_chunks, [&](size_t chunk_idx) {
+      auto& chunk_offsets = offsets[chunk_idx];
+      for (size_t i = chunk_begin(chunk_idx); i < chunk_begin(chunk_idx + 1); ++i) {
+        const auto out_pos = chunk_offsets[(src_keys[i] >> shift) & 0xFF]++;
+        dst_keys[out_pos] = src_keys[i];
+        dst_values[out_pos] = src_values[i];
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+
+  const bool copy_values = src_values != values;
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+          keys[i] = radix_sort::from_radix_key<T>(KeyT(src_keys[i] ^ flip));
+          if (copy_values) {
+            values[i] = src_values[i];
+          }
+        }
+      });
+}
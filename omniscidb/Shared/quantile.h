@@ -11,11 +11,19 @@
 
 #include "IR/OpTypeEnums.h"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
 #include <tbb/task_arena.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace hdk::quantile {
@@ -231,6 +239,22 @@ class ChunkedArray {
 
   bool empty() const { return chunks_.empty(); }
 
+  // Split stored values into contiguous segments of at most max_segment_size
+  // elements. Chunk sizes grow exponentially, so splitting is required to get
+  // balanced parallel scans.
+  template <typename T>
+  std::vector<std::pair<const T*, size_t>> segments(size_t max_segment_size) const {
+    std::vector<std::pair<const T*, size_t>> res;
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+      auto data = reinterpret_cast<const T*>(chunks_[i].data);
+      size_t elems = i + 1 == chunks_.size() ? cur_idx_ : chunks_[i].max_elems;
+      for (size_t offs = 0; offs < elems; offs += max_segment_size) {
+        res.emplace_back(data + offs, std::min(max_segment_size, elems - offs));
+      }
+    }
+    return res;
+  }
+
   size_t size() const {
     if (chunks_.empty()) {
       return 0;
@@ -261,8 +285,177 @@ class ChunkedArray {
   int thread_idx_ = -1;
 };
 
+// Map values to unsigned keys preserving their order, so that selection can
+// be done by radix digits.
+template <typename T>
+uint64_t to_ordered_key(T val) {
+  constexpr uint64_t sign_bit = uint64_t(1) << 63;
+  if constexpr (std::is_floating_point_v<T>) {
+    double dval = static_cast<double>(val);
+    uint64_t bits;
+    std::memcpy(&bits, &dval, sizeof(bits));
+    return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+  } else {
+    return static_cast<uint64_t>(static_cast<int64_t>(val)) ^ sign_bit;
+  }
+}
+
+template <typename T>
+T from_ordered_key(uint64_t key) {
+  constexpr uint64_t sign_bit = uint64_t(1) << 63;
+  if constexpr (std::is_floating_point_v<T>) {
+    uint64_t bits = (key & sign_bit) ? (key ^ sign_bit) : ~key;
+    double dval;
+    std::memcpy(&dval, &bits, sizeof(dval));
+    return static_cast<T>(dval);
+  } else {
+    return static_cast<T>(static_cast<int64_t>(key ^ sign_bit));
+  }
+}
+
+// Parallel radix selection of the k-th smallest value (0-based). Each pass
+// builds a histogram of the next 8-bit digit for values matching the already
+// selected prefix and narrows the prefix down to the bucket holding the k-th
+// value. Once few enough candidates are left, they are gathered and the rest of
+// the selection is done with nth_element. If with_next is set, the (k+1)-th
+// value is returned as the second element of the pair, otherwise the k-th value
+// is duplicated.
+template <typename T>
+std::pair<T, T> parallel_select(const std::vector<std::pair<const T*, size_t>>& segments,
+                                size_t count,
+                                size_t k,
+                                bool with_next) {
+  constexpr size_t gather_threshold = 1 << 16;
+  using Histogram = std::array<size_t, 256>;
+  const tbb::blocked_range<size_t> all_segments(0, segments.size());
+  const size_t target_idx = k;
+
+  auto min_max = tbb::parallel_reduce(
+      all_segments,
+      std::make_pair(std::numeric_limits<uint64_t>::max(), uint64_t(0)),
+      [&](const tbb::blocked_range<size_t>& r, std::pair<uint64_t, uint64_t> res) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+          for (size_t j = 0; j < segments[i].second; ++j) {
+            auto cur_key = to_ordered_key(segments[i].first[j]);
+            res.first = std::min(res.first, cur_key);
+            res.second = std::max(res.second, cur_key);
+          }
+        }
+        return res;
+      },
+      [](auto lhs, auto rhs) {
+        return std::make_pair(std::min(lhs.first, rhs.first),
+                              std::max(lhs.second, rhs.second));
+      });
+
+  uint64_t key = min_max.first;
+  if (min_max.first != min_max.second) {
+    // Skip digits which are common for all values.
+    int shift = (63 - __builtin_clzll(min_max.first ^ min_max.second)) / 8 * 8;
+    uint64_t prefix_mask = shift == 56 ? 0 : ~uint64_t(0) << (shift + 8);
+    uint64_t prefix = min_max.first & prefix_mask;
+    size_t candidates = count;
+    while (true) {
+      if (candidates <= gather_threshold) {
+        std::vector<uint64_t> keys = tbb::parallel_reduce(
+            all_segments,
+            std::vector<uint64_t>(),
+            [&](const tbb::blocked_range<size_t>& r, std::vector<uint64_t> res) {
+              for (size_t i = r.begin(); i != r.end(); ++i) {
+                for (size_t j = 0; j < segments[i].second; ++j) {
+                  auto cur_key = to_ordered_key(segments[i].first[j]);
+                  if ((cur_key & prefix_mask) == prefix) {
+                    res.push_back(cur_key);
+                  }
+                }
+              }
+              return res;
+            },
+            [](std::vector<uint64_t> lhs, const std::vector<uint64_t>& rhs) {
+              lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+              return lhs;
+            });
+        std::nth_element(keys.begin(), keys.begin() + k, keys.end());
+        key = keys[k];
+        break;
+      }
+
+      auto hist = tbb::parallel_reduce(
+          all_segments,
+          Histogram{},
+          [&](const tbb::blocked_range<size_t>& r, Histogram res) {
+            for (size_t i = r.begin(); i != r.end(); ++i) {
+              for (size_t j = 0; j < segments[i].second; ++j) {
+                auto cur_key = to_ordered_key(segments[i].first[j]);
+                if ((cur_key & prefix_mask) == prefix) {
+                  ++res[(cur_key >> shift) & 0xFF];
+                }
+              }
+            }
+            return res;
+          },
+          [](Histogram lhs, const Histogram& rhs) {
+            for (size_t i = 0; i < lhs.size(); ++i) {
+              lhs[i] += rhs[i];
+            }
+            return lhs;
+          });
+
+      size_t bucket = 0;
+      while (k >= hist[bucket]) {
+        k -= hist[bucket];
+        ++bucket;
+      }
+      candidates = hist[bucket];
+      prefix |= uint64_t(bucket) << shift;
+      prefix_mask |= uint64_t(0xFF) << shift;
+      if (shift == 0) {
+        key = prefix;
+        break;
+      }
+      shift -= 8;
+    }
+  }
+
+  T value = from_ordered_key<T>(key);
+  if (!with_next) {
+    return {value, value};
+  }
+
+  // The next value is either a duplicate of the selected one or the smallest
+  // value greater than it.
+  auto le_count_and_next = tbb::parallel_reduce(
+      all_segments,
+      std::make_pair(size_t(0), std::numeric_limits<uint64_t>::max()),
+      [&](const tbb::blocked_range<size_t>& r, std::pair<size_t, uint64_t> res) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+          for (size_t j = 0; j < segments[i].second; ++j) {
+            auto cur_key = to_ordered_key(segments[i].first[j]);
+            if (cur_key <= key) {
+              ++res.first;
+            } else {
+              res.second = std::min(res.second, cur_key);
+            }
+          }
+        }
+        return res;
+      },
+      [](auto lhs, auto rhs) {
+        return std::make_pair(lhs.first + rhs.first, std::min(lhs.second, rhs.second));
+      });
+  if (le_count_and_next.first > target_idx + 1) {
+    return {value, value};
+  }
+  return {value, from_ordered_key<T>(le_count_and_next.second)};
+}
+
 class Quantile {
  public:
+  // Big value sets are processed by a parallel radix selection instead of
+  // nth_element running in a single thread.
+  static constexpr size_t kParallelSelectionThreshold = 1 << 20;
+  static constexpr size_t kSelectionSegmentSize = 1 << 16;
+
   Quantile(SimpleAllocator* simple_allocator)
       : values_(simple_allocator), finalized_(false) {}
 
@@ -317,20 +510,33 @@ class Quantile {
         break;
     }
 
-    auto begin_iter = values_.begin<ValueType>();
-    auto end_iter = values_.end<ValueType>();
-    auto left_iter = begin_iter + left_idx;
+    ValueType left_value;
+    ValueType right_value;
+    if (values_.size() >= kParallelSelectionThreshold) {
+      std::tie(left_value, right_value) =
+          parallel_select(values_.segments<ValueType>(kSelectionSegmentSize),
+                          values_.size(),
+                          left_idx,
+                          left_idx != right_idx);
+    } else {
+      auto begin_iter = values_.begin<ValueType>();
+      auto end_iter = values_.end<ValueType>();
+      auto left_iter = begin_iter + left_idx;
+
+      std::nth_element(begin_iter, left_iter, end_iter);
+      left_value = right_value = *left_iter;
+      if (left_idx != right_idx) {
+        auto right_iter = left_iter + 1;
+        std::nth_element(left_iter, right_iter, end_iter);
+        right_value = *right_iter;
+      }
+    }
 
-    std::nth_element(begin_iter, left_iter, end_iter);
-    auto left_value = *left_iter;
     ResultType res;
     if (left_idx != right_idx) {
-      auto right_iter = left_iter + 1;
-      std::nth_element(left_iter, right_iter, end_iter);
       // It is either midpoint or linear interpolation.
       double diff_coeff =
           interpolation == hdk::ir::Interpolation::kMidpoint ? 0.5 : pos - floor(pos);
-      auto right_value = *right_iter;
       res = static_cast<ResultType>(left_value + (right_value - left_value) * diff_coeff);
     } else {
       res = static_cast<ResultType>(left_value);
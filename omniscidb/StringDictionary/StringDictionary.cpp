@@ -18,7 +18,9 @@
 #define STRINGDICTIONARY_EXPORT RUNTIME_EXPORT
 
 #include "StringDictionary/StringDictionary.h"
+#include "StringDictionary/TrigramIndex.h"
 
+#include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_reduce.h>
 #include <tbb/task_arena.h>
@@ -26,23 +28,32 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/sort/spreadsort/string_sort.hpp>
+#include <cstring>
+#include <fstream>
 #include <functional>
 #include <future>
 #include <iostream>
+#include <numeric>
 #include <string_view>
 #include <thread>
 #include <type_traits>
 
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
 // TODO(adb): fixup
 #ifdef _WIN32
 #include <fcntl.h>
 #include <io.h>
 #else
 #include <sys/fcntl.h>
+#include <unistd.h>
 #endif
 
 #include "Logger/Logger.h"
 #include "OSDependent/omnisci_fs.h"
+#include "Shared/Metrics.h"
 #include "Shared/sqltypes.h"
 #include "Shared/thread_count.h"
 #include "Utils/Regexp.h"
@@ -77,9 +88,27 @@ void fillInvalidStringIdsParallel(int64_t start, int64_t end, T* out_vec) {
                     });
 }
 
+struct DictionaryMetrics {
+  metrics::Gauge& dictionaries;
+  metrics::Gauge& strings;
+  metrics::Gauge& payload_bytes;
+};
+
+DictionaryMetrics& dictionary_metrics() {
+  static DictionaryMetrics res{
+      metrics::registry().gauge("hdk_string_dictionaries",
+                                "Number of live string dictionaries."),
+      metrics::registry().gauge("hdk_string_dictionary_strings",
+                                "Strings stored in live string dictionaries."),
+      metrics::registry().gauge("hdk_string_dictionary_payload_bytes",
+                                "Size of strings stored in live string dictionaries.")};
+  return res;
+}
+
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
+bool g_enable_stringdict_trigram_index{false};
 
 namespace legacy {
 
@@ -96,6 +125,7 @@ StringDictionary::StringDictionary(const DictRef& dict_ref,
     // Search code assumes non-empty table.
     , string_id_uint32_table_(std::max(initial_capacity, (size_t)2), INVALID_STR_ID)
     , hash_cache_(std::max(initial_capacity, (size_t)2))
+    , sorted_id_count_(0)
     , materialize_hashes_(materializeHashes)
     , offset_map_(nullptr)
     , payload_map_(nullptr)
@@ -105,6 +135,7 @@ StringDictionary::StringDictionary(const DictRef& dict_ref,
     , strings_cache_(nullptr) {
   // initial capacity must be a power of two for efficient bucket computation
   CHECK_EQ(size_t(0), (initial_capacity & (initial_capacity - 1)));
+  dictionary_metrics().dictionaries.add(1);
 }
 
 StringDictionary::StringDictionary(std::shared_ptr<StringDictionary> base_dict,
@@ -119,13 +150,18 @@ StringDictionary::StringDictionary(std::shared_ptr<StringDictionary> base_dict,
     // Search code assumes non-empty table.
     , string_id_uint32_table_(std::max(initial_capacity, (size_t)2), INVALID_STR_ID)
     , hash_cache_(std::max(initial_capacity, (size_t)2))
+    , sorted_id_count_(base_dict->hasSortedIds(base_generation_)
+                           ? static_cast<size_t>(base_generation_)
+                           : 0)
     , materialize_hashes_(materializeHashes)
     , offset_map_(nullptr)
     , payload_map_(nullptr)
     , offset_file_size_(0)
     , payload_file_size_(0)
     , payload_file_off_(0)
-    , strings_cache_(nullptr) {}
+    , strings_cache_(nullptr) {
+  dictionary_metrics().dictionaries.add(1);
+}
 
 bool StringDictionary::operator==(StringDictionary const& rhs) const {
   if (base_dict_ != rhs.base_dict_ || base_generation_ != rhs.base_generation_) {
@@ -201,11 +237,22 @@ int32_t StringDictionary::getDictId() const noexcept {
 }
 
 StringDictionary::~StringDictionary() noexcept {
+  auto& metrics = dictionary_metrics();
+  metrics.dictionaries.sub(1);
+  metrics.strings.sub(reported_str_count_);
+  metrics.payload_bytes.sub(reported_payload_size_);
   free(CANARY_BUFFER);
   if (payload_map_) {
     CHECK(offset_map_);
-    free(payload_map_);
-    free(offset_map_);
+    if (!isMapped(payload_map_)) {
+      free(payload_map_);
+    }
+    if (!isMapped(offset_map_)) {
+      free(offset_map_);
+    }
+  }
+  if (mapped_file_) {
+    omnisci::checked_munmap(mapped_file_, mapped_file_size_);
   }
 }
 
@@ -248,6 +295,9 @@ int32_t StringDictionary::getOrAdd(const std::string_view& str) noexcept {
     }
     ++str_count_;
     invalidateInvertedIndex();
+    updateTrigramIndex();
+    updateSortedIdCount();
+    reportSize();
   }
   return string_id_uint32_table_[bucket];
 }
@@ -422,6 +472,77 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
     }
   }
 
+  // Strings already present in the dictionary are resolved under the shared lock, so
+  // concurrent ingest threads and readers don't serialize on them. Only the strings
+  // still missing are added under the write lock.
+  const auto missing_indices = getOwnedBulk(input_strings, output_string_ids);
+  if (missing_indices.empty()) {
+    return;
+  }
+  if (missing_indices.size() == input_strings.size()) {
+    addBulk(input_strings, output_string_ids);
+    return;
+  }
+  std::vector<String> missing_strings;
+  missing_strings.reserve(missing_indices.size());
+  for (const auto idx : missing_indices) {
+    missing_strings.push_back(input_strings[idx]);
+  }
+  std::vector<T> missing_string_ids(missing_indices.size(),
+                                    static_cast<T>(INVALID_STR_ID));
+  addBulk(missing_strings, missing_string_ids.data());
+  for (size_t i = 0; i < missing_indices.size(); ++i) {
+    output_string_ids[missing_indices[i]] = missing_string_ids[i];
+  }
+}
+
+template <class T, class String>
+std::vector<size_t> StringDictionary::getOwnedBulk(
+    const std::vector<String>& input_strings,
+    T* output_string_ids) const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  // Callers may run in TBB tasks adding strings to this dictionary, e.g. when
+  // several columns share it. The waiting thread must not steal such a task, it
+  // would wait for the write lock while this thread holds the read lock.
+  return tbb::this_task_arena::isolate([&] {
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, input_strings.size(), 4096),
+        std::vector<size_t>(),
+        [&](const tbb::blocked_range<size_t>& r, std::vector<size_t> missing) {
+          for (size_t idx = r.begin(); idx != r.end(); ++idx) {
+            // Skip strings found in the base dictionary.
+            if (base_dict_ && output_string_ids[idx] != static_cast<T>(INVALID_STR_ID)) {
+              continue;
+            }
+            const auto& input_string = input_strings[idx];
+            if (input_string.empty()) {
+              output_string_ids[idx] = inline_int_null_value<T>();
+              continue;
+            }
+            const auto string_id =
+                input_string.size() <= MAX_STRLEN && str_count_
+                    ? string_id_uint32_table_[computeBucket(hash_string(input_string),
+                                                            input_string,
+                                                            string_id_uint32_table_)]
+                    : INVALID_STR_ID;
+            if (string_id == INVALID_STR_ID) {
+              missing.push_back(idx);
+            } else {
+              output_string_ids[idx] = string_id;
+            }
+          }
+          return missing;
+        },
+        [](std::vector<size_t> lhs, const std::vector<size_t>& rhs) {
+          lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+          return lhs;
+        });
+  });
+}
+
+template <class T, class String>
+void StringDictionary::addBulk(const std::vector<String>& input_strings,
+                               T* output_string_ids) {
   if (g_enable_stringdict_parallel) {
     getOrAddBulkParallel(input_strings, output_string_ids);
     return;
@@ -433,7 +554,7 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
   size_t idx = 0;
   for (const auto& input_string : input_strings) {
     // Skip strings found in the base dictionary.
-    if (base_dict_ && output_string_ids[idx] != INVALID_STR_ID) {
+    if (base_dict_ && output_string_ids[idx] != static_cast<T>(INVALID_STR_ID)) {
       ++idx;
       continue;
     }
@@ -478,6 +599,9 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
   const size_t num_strings_added = str_count_ - initial_str_count;
   if (num_strings_added > 0) {
     invalidateInvertedIndex();
+    updateTrigramIndex();
+    updateSortedIdCount();
+    reportSize();
   }
 }
 
@@ -499,7 +623,8 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
   size_t input_string_idx{0};
   for (const auto& input_string : input_strings) {
     // Skip strings found in the base dictionary.
-    if (base_dict_ && output_string_ids[input_string_idx] != INVALID_STR_ID) {
+    if (base_dict_ &&
+        output_string_ids[input_string_idx] != static_cast<T>(INVALID_STR_ID)) {
       ++input_string_idx;
       continue;
     }
@@ -559,6 +684,9 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
   str_count_ = shadow_str_count;
   if (num_strings_added > 0) {
     invalidateInvertedIndex();
+    updateTrigramIndex();
+    updateSortedIdCount();
+    reportSize();
   }
 }
 template void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
@@ -697,30 +825,165 @@ size_t StringDictionary::entryCount() const {
 
 namespace {
 
-bool is_like(const std::string& str,
+char lowercase(const char c) {
+  return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+}
+
+// Checks a pattern matches str at the given position. When icase is set, the
+// pattern is expected to be lowercased, as in string_ilike_simple().
+bool substring_at(const std::string_view str,
+                  const size_t pos,
+                  const std::string_view pattern,
+                  const bool icase) {
+  if (!icase) {
+    return std::memcmp(str.data() + pos, pattern.data(), pattern.size()) == 0;
+  }
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    if (pattern[i] != lowercase(str[pos + i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Substring search for simple LIKE patterns. The first and the last bytes of the
+// pattern are compared with 16 positions of the string at once, and only
+// positions matching both are compared with the whole pattern.
+bool contains_substring(const std::string_view str,
+                        const std::string_view pattern,
+                        const bool icase) {
+  if (pattern.size() > str.size()) {
+    return false;
+  }
+  if (pattern.empty()) {
+    return true;
+  }
+  const size_t last = pattern.size() - 1;
+  size_t pos = 0;
+#ifdef __SSE2__
+  auto upper = [icase](const char c) {
+    return (icase && c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+  };
+  const __m128i first_lo = _mm_set1_epi8(pattern[0]);
+  const __m128i first_up = _mm_set1_epi8(upper(pattern[0]));
+  const __m128i last_lo = _mm_set1_epi8(pattern[last]);
+  const __m128i last_up = _mm_set1_epi8(upper(pattern[last]));
+  for (; pos + last + 16 <= str.size(); pos += 16) {
+    const __m128i first_block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + pos));
+    const __m128i last_block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + pos + last));
+    const __m128i first_eq = _mm_or_si128(_mm_cmpeq_epi8(first_block, first_lo),
+                                          _mm_cmpeq_epi8(first_block, first_up));
+    const __m128i last_eq = _mm_or_si128(_mm_cmpeq_epi8(last_block, last_lo),
+                                         _mm_cmpeq_epi8(last_block, last_up));
+    uint32_t mask = _mm_movemask_epi8(_mm_and_si128(first_eq, last_eq));
+    while (mask) {
+      if (substring_at(str, pos + __builtin_ctz(mask), pattern, icase)) {
+        return true;
+      }
+      mask &= mask - 1;
+    }
+  }
+#endif
+  const char first_char = pattern[0];
+  const char last_char = pattern[last];
+  for (; pos + last < str.size(); ++pos) {
+    const char str_first = icase ? lowercase(str[pos]) : str[pos];
+    const char str_last = icase ? lowercase(str[pos + last]) : str[pos + last];
+    if (str_first == first_char && str_last == last_char &&
+        substring_at(str, pos, pattern, icase)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool is_like(const std::string_view str,
              const std::string& pattern,
              const bool icase,
              const bool is_simple,
              const char escape) {
-  return icase
-             ? (is_simple ? string_ilike_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_ilike(str.c_str(),
-                                         str.size(),
-                                         pattern.c_str(),
-                                         pattern.size(),
-                                         escape))
-             : (is_simple ? string_like_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_like(str.c_str(),
-                                        str.size(),
-                                        pattern.c_str(),
-                                        pattern.size(),
-                                        escape));
+  if (is_simple) {
+    return contains_substring(str, pattern, icase);
+  }
+  return icase ? string_ilike(
+                     str.data(), str.size(), pattern.c_str(), pattern.size(), escape)
+               : string_like(
+                     str.data(), str.size(), pattern.c_str(), pattern.size(), escape);
+}
+
+// Returns ids in [start_id, end_id) of strings accepted by the predicate. The scan
+// runs on the TBB pool and keeps ids sorted.
+template <typename Getter, typename Pred>
+std::vector<int32_t> scan_string_ids(const int32_t start_id,
+                                     const int32_t end_id,
+                                     Getter get_string,
+                                     Pred pred) {
+  if (start_id >= end_id) {
+    return {};
+  }
+  return tbb::parallel_reduce(
+      tbb::blocked_range<int32_t>(start_id, end_id, 4096),
+      std::vector<int32_t>(),
+      [&](const tbb::blocked_range<int32_t>& r, std::vector<int32_t> res) {
+        for (int32_t string_id = r.begin(); string_id != r.end(); ++string_id) {
+          if (pred(get_string(string_id))) {
+            res.push_back(string_id);
+          }
+        }
+        return res;
+      },
+      [](std::vector<int32_t> lhs, const std::vector<int32_t>& rhs) {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
+      });
+}
+
+// Same as scan_string_ids() but for a sorted list of candidate ids.
+template <typename Getter, typename Pred>
+std::vector<int32_t> filter_string_ids(const std::vector<int32_t>& string_ids,
+                                       Getter get_string,
+                                       Pred pred) {
+  std::vector<int8_t> matched(string_ids.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, string_ids.size()),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                      for (size_t i = r.begin(); i != r.end(); ++i) {
+                        matched[i] = pred(get_string(string_ids[i]));
+                      }
+                    });
+  std::vector<int32_t> res;
+  for (size_t i = 0; i < string_ids.size(); ++i) {
+    if (matched[i]) {
+      res.push_back(string_ids[i]);
+    }
+  }
+  return res;
 }
 
 }  // namespace
 
+template <typename Pred>
+std::vector<int32_t> StringDictionary::getMatchingIds(
+    const std::vector<std::string>& literals,
+    const int64_t generation,
+    Pred pred) const {
+  // Caller is supposed to hold a read lock, so the storage is not modified.
+  auto get_string = [this](int32_t string_id) {
+    return getStringFromStorageFast(string_id);
+  };
+  auto candidates = getTrigramCandidates(literals, generation);
+  // The waiting thread must not pick up tasks adding strings to this dictionary,
+  // they would block on the write lock while the read lock is held.
+  return tbb::this_task_arena::isolate([&] {
+    if (candidates) {
+      return filter_string_ids(*candidates, get_string, pred);
+    }
+    return scan_string_ids(
+        indexToId(0), static_cast<int32_t>(generation), get_string, pred);
+  });
+}
+
 std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                                                const bool icase,
                                                const bool is_simple,
@@ -728,11 +991,13 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                                                int64_t generation) const {
   generation = generation >= 0 ? std::min(generation, static_cast<int64_t>(entryCount()))
                                : static_cast<int64_t>(entryCount());
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape, generation);
-  const auto it = like_cache_.find(cache_key);
-  if (it != like_cache_.end()) {
-    return it->second;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    const auto it = like_cache_.find(cache_key);
+    if (it != like_cache_.end()) {
+      return it->second;
+    }
   }
 
   std::vector<int32_t> result;
@@ -745,39 +1010,18 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
     return result;
   }
 
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          icase,
-                          is_simple,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (int string_id = indexToId(worker_idx); string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_like(str, pattern, icase, is_simple, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    auto pred = [&](const std::string_view str) {
+      return is_like(str, pattern, icase, is_simple, escape);
+    };
+    auto matched = getMatchingIds(
+        get_like_pattern_literals(pattern, is_simple, escape), generation, pred);
+    result.insert(result.end(), matched.begin(), matched.end());
   }
   // place result into cache for reuse if similar query
-  const auto it_ok = like_cache_.insert(std::make_pair(cache_key, result));
-
-  CHECK(it_ok.second);
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  like_cache_.emplace(cache_key, result);
 
   return result;
 }
@@ -785,7 +1029,6 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
 std::vector<int32_t> StringDictionary::getEquals(const std::string& pattern,
                                                  const std::string& comp_operator,
                                                  int64_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   std::vector<int32_t> result;
   if (base_dict_) {
     result = base_dict_->getEquals(
@@ -795,55 +1038,20 @@ std::vector<int32_t> StringDictionary::getEquals(const std::string& pattern,
     }
   }
 
-  auto eq_id_itr = equal_cache_.find(pattern);
-  int32_t eq_id = -1;
-  if (eq_id_itr != equal_cache_.end()) {
-    auto eq_id = eq_id_itr->second;
-    if (comp_operator == "=") {
-      if (eq_id < generation) {
-        result.push_back(eq_id);
-      }
-    } else {
-      for (int32_t id = base_generation_; id < generation; id++) {
-        if (id != eq_id) {
-          result.push_back(id);
-        }
-      }
-    }
-  } else {
-    std::vector<std::thread> workers;
-    int worker_count = cpu_threads();
-    CHECK_GT(worker_count, 0);
-    for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-      workers.emplace_back(
-          [&eq_id, &pattern, generation, worker_idx, worker_count, this]() {
-            for (int string_id = indexToId(worker_idx); string_id < generation;
-                 string_id += worker_count) {
-              const auto str = getStringUnlocked(string_id);
-              if (str == pattern) {
-                // Only one thread can find matching string, so no additional sync.
-                eq_id = string_id;
-                break;
-              }
-            }
-          });
-    }
-    for (auto& worker : workers) {
-      worker.join();
-    }
-    if (eq_id >= 0) {
-      const auto it_ok = equal_cache_.insert(std::make_pair(pattern, eq_id));
-      CHECK(it_ok.second);
-    }
-    if (comp_operator == "<>") {
-      for (int32_t id = base_generation_; id < generation; id++) {
-        if (id != eq_id) {
-          result.push_back(id);
-        }
+  // The hash table holds all owned strings, so there is no need to scan them.
+  int32_t eq_id = INVALID_STR_ID;
+  if (!pattern.empty() && pattern.size() <= MAX_STRLEN) {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    eq_id = getOwnedUnlocked(pattern);
+  }
+  if (comp_operator == "<>") {
+    for (int32_t id = base_generation_; id < generation; id++) {
+      if (id != eq_id) {
+        result.push_back(id);
       }
-    } else if (eq_id >= 0 && eq_id < generation) {
-      result.push_back(eq_id);
     }
+  } else if (eq_id >= 0 && eq_id < generation) {
+    result.push_back(eq_id);
   }
   return result;
 }
@@ -851,6 +1059,11 @@ std::vector<int32_t> StringDictionary::getEquals(const std::string& pattern,
 std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
                                                   const std::string& comp_operator,
                                                   int64_t generation) const {
+  if (const auto id_range = getSortedIdRange(pattern, comp_operator, generation)) {
+    std::vector<int32_t> ret(id_range->second - id_range->first);
+    std::iota(ret.begin(), ret.end(), id_range->first);
+    return ret;
+  }
   generation = generation >= 0 ? std::min(generation, static_cast<int64_t>(entryCount()))
                                : static_cast<int64_t>(entryCount());
   {
@@ -863,7 +1076,6 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
     }
   }
 
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   std::vector<int32_t> ret;
   if (base_dict_) {
     ret = base_dict_->getCompare(
@@ -873,11 +1085,25 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
     }
   }
 
-  if (sorted_cache.size() < str_count_) {
-    buildSortedCache();
+  // The exclusive lock is needed only to bring the sorted cache up to date, the
+  // search and the scan run under the shared lock.
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  while (sorted_cache.size() < str_count_) {
+    read_lock.unlock();
+    {
+      mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+      if (sorted_cache.size() < str_count_) {
+        buildSortedCache();
+      }
+    }
+    read_lock.lock();
   }
 
-  auto cache_index = compare_cache_.get(pattern);
+  std::shared_ptr<StringDictionary::compare_cache_value_t> cache_index;
+  {
+    std::lock_guard<std::mutex> cache_lock(compare_cache_mutex_);
+    cache_index = compare_cache_.get(pattern);
+  }
 
   if (!cache_index) {
     cache_index = std::make_shared<StringDictionary::compare_cache_value_t>();
@@ -905,6 +1131,7 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
       }
     }
 
+    std::lock_guard<std::mutex> cache_lock(compare_cache_mutex_);
     compare_cache_.put(pattern, cache_index);
   }
 
@@ -992,10 +1219,10 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
 
 namespace {
 
-bool is_regexp_like(const std::string& str,
+bool is_regexp_like(const std::string_view str,
                     const std::string& pattern,
                     const char escape) {
-  return regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape);
+  return regexp_like(str.data(), str.size(), pattern.c_str(), pattern.size(), escape);
 }
 
 }  // namespace
@@ -1006,11 +1233,13 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   generation = generation >= 0 ? std::min(generation, static_cast<int64_t>(entryCount()))
                                : static_cast<int64_t>(entryCount());
 
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   const auto cache_key = std::make_tuple(pattern, escape, generation);
-  const auto it = regex_cache_.find(cache_key);
-  if (it != regex_cache_.end()) {
-    return it->second;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    const auto it = regex_cache_.find(cache_key);
+    if (it != regex_cache_.end()) {
+      return it->second;
+    }
   }
 
   std::vector<int32_t> result;
@@ -1022,35 +1251,17 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
     }
   }
 
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (int string_id = indexToId(worker_idx); string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_regexp_like(str, pattern, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    auto matched = getMatchingIds(get_regexp_pattern_literals(pattern),
+                                  generation,
+                                  [&](const std::string_view str) {
+                                    return is_regexp_like(str, pattern, escape);
+                                  });
+    result.insert(result.end(), matched.begin(), matched.end());
   }
-  const auto it_ok = regex_cache_.insert(std::make_pair(cache_key, result));
-  CHECK(it_ok.second);
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  regex_cache_.emplace(cache_key, result);
 
   return result;
 }
@@ -1394,14 +1605,194 @@ void* StringDictionary::addMemoryCapacity(void* addr,
     CHECK(CANARY_BUFFER);
     memset(CANARY_BUFFER, 0xff, canary_buff_size_to_add);
   }
-  void* new_addr = realloc(addr, mem_size + canary_buff_size_to_add);
-  CHECK(new_addr);
+  void* new_addr;
+  if (isMapped(addr)) {
+    // Mapped file is read-only, so its data is copied on the first addition.
+    new_addr = malloc(mem_size + canary_buff_size_to_add);
+    CHECK(new_addr);
+    memcpy(new_addr, addr, mem_size);
+  } else {
+    new_addr = realloc(addr, mem_size + canary_buff_size_to_add);
+    CHECK(new_addr);
+  }
   void* write_addr = reinterpret_cast<void*>(static_cast<char*>(new_addr) + mem_size);
   CHECK(memcpy(write_addr, CANARY_BUFFER, canary_buff_size_to_add));
   mem_size += canary_buff_size_to_add;
   return new_addr;
 }
 
+size_t StringDictionary::compact() {
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  // Canary buffer is only used to fill the added capacity and is re-allocated on
+  // the next growth.
+  size_t released = canary_buffer_size;
+  free(CANARY_BUFFER);
+  CANARY_BUFFER = nullptr;
+  canary_buffer_size = 0;
+  if (!payload_map_) {
+    return released;
+  }
+  auto shrink = [this, &released](
+                    auto*& addr, size_t& mem_size, const size_t used_size) {
+    // Keep non-empty buffers, so a null buffer still means nothing was allocated.
+    const size_t new_size = std::max(used_size, size_t(1));
+    if (new_size < mem_size && !isMapped(addr)) {
+      auto new_addr = realloc(addr, new_size);
+      CHECK(new_addr);
+      addr = static_cast<std::remove_reference_t<decltype(addr)>>(new_addr);
+      released += mem_size - new_size;
+      mem_size = new_size;
+    }
+  };
+  shrink(payload_map_, payload_file_size_, payload_file_off_);
+  shrink(offset_map_, offset_file_size_, str_count_ * sizeof(StringIdxEntry));
+  return released;
+}
+
+namespace {
+
+// Layout of files written by StringDictionary::save(). The header is followed by
+// the payload, string offsets, string hashes, the hash table and the sorted cache.
+// Each section starts at an 8-byte boundary.
+struct DictFileHeader {
+  char magic[8];
+  uint64_t version;
+  uint64_t str_count;
+  uint64_t payload_size;
+  uint64_t hash_count;
+  uint64_t hash_table_size;
+  uint64_t sorted_cache_size;
+  uint64_t sorted_id_count;
+};
+
+constexpr char kDictFileMagic[8] = {'H', 'D', 'K', 'D', 'I', 'C', 'T', '\0'};
+constexpr uint64_t kDictFileVersion = 1;
+
+size_t alignDictFileSection(size_t size) {
+  return (size + 7) & ~size_t(7);
+}
+
+}  // namespace
+
+void StringDictionary::save(const std::string& path) const {
+  CHECK(!base_dict_) << "Cannot save a proxy string dictionary";
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  DictFileHeader header;
+  memcpy(header.magic, kDictFileMagic, sizeof(header.magic));
+  header.version = kDictFileVersion;
+  header.str_count = str_count_;
+  header.payload_size = payload_file_off_;
+  header.hash_count = materialize_hashes_ ? str_count_ : 0;
+  header.hash_table_size = string_id_uint32_table_.size();
+  header.sorted_cache_size = sorted_cache.size();
+  header.sorted_id_count = sorted_id_count_;
+
+  // The file is replaced with rename, so processes mapping the old file keep
+  // using it.
+  const std::string tmp_path = path + ".tmp";
+  std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Cannot create string dictionary file: " + tmp_path);
+  }
+  const char padding[8] = {};
+  auto write_section = [&](const void* data, size_t size) {
+    out.write(static_cast<const char*>(data), size);
+    out.write(padding, alignDictFileSection(size) - size);
+  };
+  write_section(&header, sizeof(header));
+  write_section(payload_map_, header.payload_size);
+  write_section(offset_map_, str_count_ * sizeof(StringIdxEntry));
+  write_section(hash_cache_.data(), header.hash_count * sizeof(uint32_t));
+  write_section(string_id_uint32_table_.data(),
+                header.hash_table_size * sizeof(int32_t));
+  write_section(sorted_cache.data(), header.sorted_cache_size * sizeof(int32_t));
+  out.close();
+  if (!out) {
+    throw std::runtime_error("Cannot write string dictionary file: " + tmp_path);
+  }
+  boost::filesystem::rename(tmp_path, path);
+}
+
+std::shared_ptr<StringDictionary> StringDictionary::load(const DictRef& dict_ref,
+                                                         const std::string& path) {
+  const size_t file_size = boost::filesystem::file_size(path);
+  DictFileHeader header;
+  if (file_size < sizeof(header)) {
+    throw std::runtime_error("Invalid string dictionary file: " + path);
+  }
+#ifdef _WIN32
+  const int fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+#endif
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open string dictionary file: " + path);
+  }
+  auto mapped_file = omnisci::checked_mmap(fd, file_size);
+#ifdef _WIN32
+  _close(fd);
+#else
+  close(fd);
+#endif
+  memcpy(&header, mapped_file, sizeof(header));
+
+  const size_t payload_off = alignDictFileSection(sizeof(header));
+  const size_t offsets_off = payload_off + alignDictFileSection(header.payload_size);
+  const size_t hashes_off =
+      offsets_off + alignDictFileSection(header.str_count * sizeof(StringIdxEntry));
+  const size_t table_off =
+      hashes_off + alignDictFileSection(header.hash_count * sizeof(uint32_t));
+  const size_t sorted_cache_off =
+      table_off + alignDictFileSection(header.hash_table_size * sizeof(int32_t));
+  const size_t end_off =
+      sorted_cache_off + alignDictFileSection(header.sorted_cache_size * sizeof(int32_t));
+  if (memcmp(header.magic, kDictFileMagic, sizeof(header.magic)) ||
+      header.version != kDictFileVersion || end_off != file_size ||
+      header.hash_table_size <= header.str_count ||
+      (header.hash_table_size & (header.hash_table_size - 1)) ||
+      (header.hash_count && header.hash_count != header.str_count)) {
+    omnisci::checked_munmap(mapped_file, file_size);
+    throw std::runtime_error("Invalid string dictionary file: " + path);
+  }
+
+  auto dict = std::make_shared<StringDictionary>(
+      dict_ref, header.hash_count != 0, header.hash_table_size);
+  auto data = static_cast<const char*>(mapped_file);
+  dict->mapped_file_ = mapped_file;
+  dict->mapped_file_size_ = file_size;
+  dict->str_count_ = header.str_count;
+  if (header.str_count) {
+    // Strings stay in the mapped file, the rest is small enough to be copied.
+    dict->payload_map_ = const_cast<char*>(data + payload_off);
+    dict->payload_file_size_ = header.payload_size;
+    dict->payload_file_off_ = header.payload_size;
+    dict->offset_map_ = reinterpret_cast<StringIdxEntry*>(
+        const_cast<char*>(data + offsets_off));
+    dict->offset_file_size_ = header.str_count * sizeof(StringIdxEntry);
+  }
+  memcpy(dict->hash_cache_.data(),
+         data + hashes_off,
+         header.hash_count * sizeof(uint32_t));
+  memcpy(dict->string_id_uint32_table_.data(),
+         data + table_off,
+         header.hash_table_size * sizeof(int32_t));
+  dict->sorted_cache.resize(header.sorted_cache_size);
+  memcpy(dict->sorted_cache.data(),
+         data + sorted_cache_off,
+         header.sorted_cache_size * sizeof(int32_t));
+  dict->sorted_id_count_ = header.sorted_id_count;
+  dict->reportSize();
+  return dict;
+}
+
+void StringDictionary::reportSize() {
+  auto& metrics = dictionary_metrics();
+  metrics.strings.add(str_count_ - reported_str_count_);
+  metrics.payload_bytes.add(payload_file_off_ - reported_payload_size_);
+  reported_str_count_ = str_count_;
+  reported_payload_size_ = payload_file_off_;
+}
+
 void StringDictionary::invalidateInvertedIndex() noexcept {
   if (!like_cache_.empty()) {
     decltype(like_cache_)().swap(like_cache_);
@@ -1409,12 +1800,146 @@ void StringDictionary::invalidateInvertedIndex() noexcept {
   if (!regex_cache_.empty()) {
     decltype(regex_cache_)().swap(regex_cache_);
   }
-  if (!equal_cache_.empty()) {
-    decltype(equal_cache_)().swap(equal_cache_);
-  }
   compare_cache_.invalidateInvertedIndex();
 }
 
+bool StringDictionary::hasSortedIds(int64_t generation) const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  const size_t id_count = base_generation_ + str_count_;
+  return sorted_id_count_ >= (generation >= 0 ? std::min(static_cast<size_t>(generation),
+                                                         id_count)
+                                              : id_count);
+}
+
+std::optional<std::pair<int32_t, int32_t>> StringDictionary::getSortedIdRange(
+    const std::string& pattern,
+    const std::string& comp_operator,
+    int64_t generation) const {
+  if (comp_operator == "<>") {
+    return std::nullopt;
+  }
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  const int64_t id_count = base_generation_ + str_count_;
+  generation = generation >= 0 ? std::min(generation, id_count) : id_count;
+  if (sorted_id_count_ < static_cast<size_t>(generation)) {
+    return std::nullopt;
+  }
+  // Binary search over ids is a binary search over strings here.
+  const auto bound = [&](const bool upper) {
+    int32_t begin = 0;
+    int32_t end = static_cast<int32_t>(generation);
+    while (begin < end) {
+      const int32_t mid = begin + (end - begin) / 2;
+      const auto str = getStringUnlocked(mid);
+      if (upper ? str <= pattern : str < pattern) {
+        begin = mid + 1;
+      } else {
+        end = mid;
+      }
+    }
+    return begin;
+  };
+  const int32_t end = static_cast<int32_t>(generation);
+  if (comp_operator == "<") {
+    return std::make_pair(0, bound(false));
+  } else if (comp_operator == "<=") {
+    return std::make_pair(0, bound(true));
+  } else if (comp_operator == ">") {
+    return std::make_pair(bound(true), end);
+  } else if (comp_operator == ">=") {
+    return std::make_pair(bound(false), end);
+  } else if (comp_operator == "=") {
+    return std::make_pair(bound(false), bound(true));
+  }
+  return std::nullopt;
+}
+
+void StringDictionary::updateSortedIdCount() {
+  const size_t id_count = base_generation_ + str_count_;
+  // Once an id breaks the order, later additions cannot restore it.
+  if (sorted_id_count_ == id_count ||
+      sorted_id_count_ < static_cast<size_t>(base_generation_)) {
+    return;
+  }
+  std::string base_str;
+  std::string_view prev_str;
+  if (sorted_id_count_ > static_cast<size_t>(base_generation_)) {
+    prev_str = getStringFromStorageFast(sorted_id_count_ - 1);
+  } else if (sorted_id_count_ > 0) {
+    base_str = base_dict_->getString(sorted_id_count_ - 1);
+    prev_str = base_str;
+  }
+  for (size_t id = sorted_id_count_; id < id_count; ++id) {
+    const auto str = getStringFromStorageFast(id);
+    if (id > 0 && str <= prev_str) {
+      return;
+    }
+    prev_str = str;
+    ++sorted_id_count_;
+  }
+}
+
+void StringDictionary::updateTrigramIndex() const {
+  // Index is built on demand, so there is nothing to update until it is used.
+  if (!trigram_index_) {
+    return;
+  }
+  const int32_t start_idx = trigram_index_->size();
+  const int32_t end_idx = static_cast<int32_t>(str_count_);
+  constexpr int32_t strings_per_part = 1 << 16;
+  if (end_idx - start_idx <= strings_per_part) {
+    for (int32_t string_idx = start_idx; string_idx < end_idx; ++string_idx) {
+      trigram_index_->add(getStringFromStorageFast(indexToId(string_idx)), string_idx);
+    }
+    return;
+  }
+  // Index parts are built in parallel and then appended in order to keep posting
+  // lists sorted. Callers hold either the trigram index mutex or the exclusive
+  // dictionary lock, so the waiting thread must not pick up unrelated tasks which
+  // might try to take the same locks.
+  const int32_t part_count =
+      (end_idx - start_idx + strings_per_part - 1) / strings_per_part;
+  std::vector<TrigramIndex> parts(part_count);
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(int32_t(0), part_count, [&](int32_t part_idx) {
+      const int32_t part_start = start_idx + part_idx * strings_per_part;
+      const int32_t part_end = std::min(end_idx, part_start + strings_per_part);
+      for (int32_t string_idx = part_start; string_idx < part_end; ++string_idx) {
+        parts[part_idx].add(getStringFromStorageFast(indexToId(string_idx)),
+                            string_idx);
+      }
+    });
+  });
+  for (auto& part : parts) {
+    trigram_index_->append(std::move(part));
+  }
+}
+
+std::optional<std::vector<int32_t>> StringDictionary::getTrigramCandidates(
+    const std::vector<std::string>& literals,
+    int64_t generation) const {
+  // Caller is supposed to hold a read lock. Writers update the index under an
+  // exclusive lock, so only the index creation needs to be synchronized.
+  if (!g_enable_stringdict_trigram_index) {
+    return std::nullopt;
+  }
+  {
+    std::lock_guard<std::mutex> lock(trigram_index_mutex_);
+    if (!trigram_index_) {
+      auto timer = DEBUG_TIMER("Build string dictionary trigram index");
+      trigram_index_ = std::make_unique<TrigramIndex>();
+      updateTrigramIndex();
+    }
+  }
+  auto candidates = trigram_index_->getCandidates(literals, idToIndex(generation));
+  if (candidates) {
+    for (auto& string_id : *candidates) {
+      string_id = indexToId(string_id);
+    }
+  }
+  return candidates;
+}
+
 void StringDictionary::buildSortedCache() const {
   // This method is not thread-safe.
   const auto cur_cache_size = sorted_cache.size();
@@ -1511,6 +2036,22 @@ std::vector<int32_t> StringDictionary::buildUnionTranslationMap(
   return translated_ids;
 }
 
+std::vector<int32_t> StringDictionary::buildTransformTranslationMap(
+    const std::function<std::string(const std::string&)>& transform) {
+  auto timer = DEBUG_TIMER(__func__);
+  const int64_t num_strings = entryCount();
+  std::vector<std::string> strings;
+  strings.reserve(num_strings);
+  copyStrings(0, num_strings, strings);
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, strings.size()),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                      for (size_t i = r.begin(); i != r.end(); ++i) {
+                        strings[i] = transform(strings[i]);
+                      }
+                    });
+  return getOrAddBulk(strings);
+}
+
 }  // namespace legacy
 
 std::vector<int32_t> StringDictionaryTranslator::buildDictionaryTranslationMap(
@@ -25,6 +25,9 @@
 #include <functional>
 #include <future>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -73,6 +76,7 @@ class StringDictionaryTranslator {
 };
 
 class StringLocalCallback;
+class TrigramIndex;
 
 namespace legacy {
 
@@ -146,15 +150,43 @@ class StringDictionary {
                                   const std::string& comp_operator,
                                   int64_t generation = -1) const;
 
+  // Returns true if ids below the generation follow the lexical order of their
+  // strings, e.g. when the dictionary was filled by a sorted bulk import.
+  bool hasSortedIds(int64_t generation = -1) const;
+  // For dictionaries with sorted ids returns the [begin, end) range of ids matching
+  // the comparison with the pattern. Returns nullopt if ids are not sorted or the
+  // matching ids don't form a single range.
+  std::optional<std::pair<int32_t, int32_t>> getSortedIdRange(
+      const std::string& pattern,
+      const std::string& comp_operator,
+      int64_t generation = -1) const;
+
   std::vector<int32_t> getRegexpLike(const std::string& pattern,
                                      const char escape,
                                      int64_t generation = -1) const;
 
   std::vector<std::string> copyStrings(int64_t generation = -1) const;
 
+  // Shrinks payload and offset buffers to the stored strings, dropping the slack
+  // reserved for future additions. Returns the number of released bytes.
+  size_t compact();
+
+  // Writes strings, their hashes, the hash table and the sorted cache to a file
+  // which can be mapped back with load(). Proxy dictionaries can't be saved.
+  void save(const std::string& path) const;
+  // Maps a file written by save() instead of re-adding its strings. Mapped strings
+  // are shared with other processes loading the same file. Added strings are
+  // kept in memory, the file is never modified.
+  static std::shared_ptr<StringDictionary> load(const DictRef& dict_ref,
+                                                const std::string& path);
+
   std::vector<int32_t> buildIntersectionTranslationMap(
       const StringDictionary* dest) const;
   std::vector<int32_t> buildUnionTranslationMap(StringDictionary* dest) const;
+  // Maps each string id to the id of the transformed string. Transformed strings
+  // missing in the dictionary are added to it.
+  std::vector<int32_t> buildTransformTranslationMap(
+      const std::function<std::string(const std::string&)>& transform);
 
   static constexpr int32_t INVALID_STR_ID = -1;
   static constexpr size_t MAX_STRLEN = (1 << 15) - 1;
@@ -203,6 +235,13 @@ class StringDictionary {
   std::string getStringUnlocked(int32_t string_id) const noexcept;
   std::string getOwnedStringChecked(const int string_id) const noexcept;
   std::pair<char*, size_t> getOwnedStringBytesChecked(const int string_id) const noexcept;
+  // Looks up strings under the shared lock and returns indices of strings missing in
+  // the dictionary.
+  template <class T, class String>
+  std::vector<size_t> getOwnedBulk(const std::vector<String>& string_vec,
+                                   T* encoded_vec) const;
+  template <class T, class String>
+  void addBulk(const std::vector<String>& string_vec, T* encoded_vec);
   template <class T, class String>
   void getOrAddBulkParallel(const std::vector<String>& string_vec, T* encoded_vec);
   void copyStrings(int64_t string_id_start,
@@ -241,6 +280,17 @@ class StringDictionary {
                           size_t& mem_size,
                           const size_t min_capacity_requested = 0) noexcept;
   void invalidateInvertedIndex() noexcept;
+  void updateTrigramIndex() const;
+  void updateSortedIdCount();
+  // Propagate the dictionary growth to the engine-wide metrics.
+  void reportSize();
+  std::optional<std::vector<int32_t>> getTrigramCandidates(
+      const std::vector<std::string>& literals,
+      int64_t generation) const;
+  template <typename Pred>
+  std::vector<int32_t> getMatchingIds(const std::vector<std::string>& literals,
+                                      const int64_t generation,
+                                      Pred pred) const;
   std::vector<int32_t> getEquals(const std::string& pattern,
                                  const std::string& comp_operator,
                                  int64_t generation) const;
@@ -251,6 +301,11 @@ class StringDictionary {
   int indexToId(int string_idx) const { return string_idx + base_generation_; }
   int idToIndex(int string_id) const { return string_id - base_generation_; }
 
+  bool isMapped(const void* addr) const {
+    return addr >= mapped_file_ &&
+           addr < static_cast<const char*>(mapped_file_) + mapped_file_size_;
+  }
+
   uint32_t hashById(int string_id) const { return hashByIndex(idToIndex(string_id)); }
   uint32_t hashByIndex(int string_idx) const { return hash_cache_[string_idx]; }
 
@@ -262,21 +317,34 @@ class StringDictionary {
   std::vector<int32_t> string_id_uint32_table_;
   std::vector<uint32_t> hash_cache_;
   mutable std::vector<int32_t> sorted_cache;
+  // Number of leading ids assigned in the lexical order of their strings.
+  size_t sorted_id_count_;
   bool materialize_hashes_;
   StringIdxEntry* offset_map_;
   char* payload_map_;
   size_t offset_file_size_;
   size_t payload_file_size_;
   size_t payload_file_off_;
+  // File mapped by load(). Payload and offsets point into it until they grow.
+  void* mapped_file_{nullptr};
+  size_t mapped_file_size_{0};
+  // Size last added to the engine-wide metrics.
+  size_t reported_str_count_{0};
+  size_t reported_payload_size_{0};
   mutable mapd_shared_mutex rw_mutex_;
   mutable std::map<std::tuple<std::string, bool, bool, char, int64_t>,
                    std::vector<int32_t>>
       like_cache_;
   mutable std::map<std::tuple<std::string, char, int64_t>, std::vector<int32_t>>
       regex_cache_;
-  mutable std::map<std::string, int32_t> equal_cache_;
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
+  // Guards the compare cache accessed by concurrent readers.
+  mutable std::mutex compare_cache_mutex_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
+  // Built on the first LIKE or REGEXP lookup and maintained on string additions.
+  mutable std::unique_ptr<TrigramIndex> trigram_index_;
+  // Guards the index creation by concurrent readers.
+  mutable std::mutex trigram_index_mutex_;
 
   char* CANARY_BUFFER{nullptr};
   size_t canary_buffer_size = 0;
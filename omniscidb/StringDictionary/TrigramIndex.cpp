@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "TrigramIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+namespace {
+
+uint8_t lowercase(const char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c - 'A' + 'a')
+                                : static_cast<uint8_t>(c);
+}
+
+// Sorted unique trigrams of a string.
+void get_trigrams(const std::string_view str, std::vector<uint32_t>& trigrams) {
+  trigrams.clear();
+  if (str.size() < 3) {
+    return;
+  }
+  uint32_t trigram = (lowercase(str[0]) << 8) | lowercase(str[1]);
+  for (size_t i = 2; i < str.size(); ++i) {
+    trigram = ((trigram << 8) | lowercase(str[i])) & 0xFFFFFF;
+    trigrams.push_back(trigram);
+  }
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+bool is_regexp_quantifier(const char c) {
+  return c == '*' || c == '+' || c == '?' || c == '{';
+}
+
+// Returns the position following a quantifier starting at pos, if any.
+size_t skip_regexp_quantifier(const std::string& pattern, size_t pos) {
+  while (pos < pattern.size() && is_regexp_quantifier(pattern[pos])) {
+    if (pattern[pos] == '{') {
+      auto end = pattern.find('}', pos);
+      pos = end == std::string::npos ? pattern.size() : end + 1;
+    } else {
+      ++pos;
+    }
+  }
+  return pos;
+}
+
+// Returns the position of ']' closing a bracket expression list starting at pos.
+// Character classes, equivalence classes and collating symbols of the list, e.g.
+// [:alpha:], contain brackets of their own.
+size_t find_bracket_end(const std::string& pattern, size_t pos) {
+  while (pos < pattern.size()) {
+    if (pattern[pos] == ']') {
+      return pos;
+    }
+    if (pattern[pos] == '[' && pos + 1 < pattern.size() &&
+        (pattern[pos + 1] == ':' || pattern[pos + 1] == '=' || pattern[pos + 1] == '.')) {
+      const char terminator[] = {pattern[pos + 1], ']', '\0'};
+      auto end = pattern.find(terminator, pos + 2);
+      if (end == std::string::npos) {
+        return end;
+      }
+      pos = end + 2;
+    } else {
+      ++pos;
+    }
+  }
+  return std::string::npos;
+}
+
+}  // namespace
+
+void TrigramIndex::add(const std::string_view str, const int32_t string_idx) {
+  static thread_local std::vector<uint32_t> trigrams;
+  get_trigrams(str, trigrams);
+  for (auto trigram : trigrams) {
+    postings_[trigram].push_back(string_idx);
+  }
+  size_ = string_idx + 1;
+}
+
+void TrigramIndex::append(TrigramIndex&& other) {
+  if (postings_.empty()) {
+    postings_ = std::move(other.postings_);
+  } else {
+    for (auto& [trigram, ids] : other.postings_) {
+      auto& dst = postings_[trigram];
+      dst.insert(dst.end(), ids.begin(), ids.end());
+    }
+  }
+  size_ = std::max(size_, other.size_);
+  other.postings_.clear();
+}
+
+std::optional<std::vector<int32_t>> TrigramIndex::getCandidates(
+    const std::vector<std::string>& literals,
+    const int32_t limit) const {
+  std::vector<uint32_t> trigrams;
+  std::vector<uint32_t> literal_trigrams;
+  for (auto& literal : literals) {
+    get_trigrams(literal, literal_trigrams);
+    trigrams.insert(trigrams.end(), literal_trigrams.begin(), literal_trigrams.end());
+  }
+  if (trigrams.empty()) {
+    return std::nullopt;
+  }
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+  std::vector<const std::vector<int32_t>*> lists;
+  lists.reserve(trigrams.size());
+  for (auto trigram : trigrams) {
+    auto it = postings_.find(trigram);
+    if (it == postings_.end()) {
+      return std::vector<int32_t>();
+    }
+    lists.push_back(&it->second);
+  }
+  // Start from the most selective trigram to keep intermediate results small.
+  std::sort(lists.begin(), lists.end(), [](auto lhs, auto rhs) {
+    return lhs->size() < rhs->size();
+  });
+
+  auto& first = *lists.front();
+  std::vector<int32_t> res(first.begin(),
+                           std::lower_bound(first.begin(), first.end(), limit));
+  std::vector<int32_t> tmp;
+  for (size_t i = 1; i < lists.size() && !res.empty(); ++i) {
+    tmp.clear();
+    std::set_intersection(res.begin(),
+                          res.end(),
+                          lists[i]->begin(),
+                          lists[i]->end(),
+                          std::back_inserter(tmp));
+    res.swap(tmp);
+  }
+  return res;
+}
+
+std::vector<std::string> get_like_pattern_literals(const std::string& pattern,
+                                                   const bool is_simple,
+                                                   const char escape) {
+  if (is_simple) {
+    return {pattern};
+  }
+  std::vector<std::string> res;
+  std::string cur;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == escape && i + 1 < pattern.size()) {
+      cur += pattern[++i];
+    } else if (c == '%' || c == '_' || c == '[') {
+      if (!cur.empty()) {
+        res.emplace_back(std::move(cur));
+        cur.clear();
+      }
+      // Bracket expression matches a single character from the list.
+      if (c == '[') {
+        auto end = pattern.find(']', i + 1);
+        i = end == std::string::npos ? pattern.size() : end;
+      }
+    } else {
+      cur += c;
+    }
+  }
+  if (!cur.empty()) {
+    res.emplace_back(std::move(cur));
+  }
+  return res;
+}
+
+std::vector<std::string> get_regexp_pattern_literals(const std::string& pattern) {
+  if (pattern.find('|') != std::string::npos) {
+    return {};
+  }
+  std::vector<std::string> res;
+  std::string cur;
+  auto flush = [&]() {
+    if (!cur.empty()) {
+      res.emplace_back(std::move(cur));
+      cur.clear();
+    }
+  };
+
+  size_t pos = 0;
+  while (pos < pattern.size()) {
+    const char c = pattern[pos];
+    if (c == '[') {
+      // Bracket expression, a closing bracket can go first in the list.
+      flush();
+      pos += 1;
+      pos += (pos < pattern.size() && pattern[pos] == '^') ? 1 : 0;
+      pos += (pos < pattern.size() && pattern[pos] == ']') ? 1 : 0;
+      auto end = find_bracket_end(pattern, pos);
+      pos = skip_regexp_quantifier(
+          pattern, end == std::string::npos ? pattern.size() : end + 1);
+    } else if (c == '(') {
+      // Group contents might be optional or repeated, skip them.
+      flush();
+      int depth = 0;
+      for (; pos < pattern.size(); ++pos) {
+        if (pattern[pos] == '\\') {
+          ++pos;
+        } else if (pattern[pos] == '(') {
+          ++depth;
+        } else if (pattern[pos] == ')' && --depth == 0) {
+          break;
+        }
+      }
+      pos = skip_regexp_quantifier(pattern, pos + 1);
+    } else if (c == '.' || c == '^' || c == '$' || c == ')' || c == '}' ||
+               is_regexp_quantifier(c) ||
+               (c == '\\' && pos + 1 < pattern.size() &&
+                std::isalnum(static_cast<unsigned char>(pattern[pos + 1])))) {
+      // Any character, anchor or character class escape.
+      flush();
+      pos = skip_regexp_quantifier(pattern, pos + (c == '\\' ? 2 : 1));
+    } else {
+      char literal = c;
+      if (c == '\\' && pos + 1 < pattern.size()) {
+        literal = pattern[++pos];
+      }
+      ++pos;
+      if (pos < pattern.size() && is_regexp_quantifier(pattern[pos])) {
+        // Only a single repeated character is required by '+'.
+        if (pattern[pos] == '+') {
+          cur += literal;
+        }
+        flush();
+        pos = skip_regexp_quantifier(pattern, pos);
+      } else {
+        cur += literal;
+      }
+    }
+  }
+  flush();
+  return res;
+}
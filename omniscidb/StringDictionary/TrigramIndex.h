@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file    TrigramIndex.h
+ * @brief   Inverted index of string trigrams used to prefilter LIKE and REGEXP
+ *          candidates in a string dictionary.
+ *
+ * Each string is split into overlapping 3-byte sequences, and every trigram keeps
+ * a sorted list of indices of strings containing it. A string can match a pattern
+ * only if it contains all trigrams of the pattern's literal fragments, so exact
+ * matching is required for the intersection of posting lists only. Trigrams are
+ * built over ASCII lowercased bytes, which makes the same index usable for case
+ * sensitive and case insensitive patterns.
+ **/
+
+#pragma once
+
+#include "ThirdParty/robin_hood.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TrigramIndex {
+ public:
+  // Strings must be added in increasing index order.
+  void add(const std::string_view str, const int32_t string_idx);
+
+  // Appends an index built for strings following all strings of this one.
+  void append(TrigramIndex&& other);
+
+  // Number of indexed strings, including strings too short to have trigrams.
+  int32_t size() const { return size_; }
+
+  // Returns sorted indices below the limit of strings containing all given
+  // literals. No value is returned if literals are too short to filter strings.
+  std::optional<std::vector<int32_t>> getCandidates(
+      const std::vector<std::string>& literals,
+      const int32_t limit) const;
+
+ private:
+  robin_hood::unordered_map<uint32_t, std::vector<int32_t>> postings_;
+  int32_t size_{0};
+};
+
+// Literal fragments which have to be found in any string matching a LIKE pattern.
+// Wildcards and bracket expressions split the pattern into fragments.
+std::vector<std::string> get_like_pattern_literals(const std::string& pattern,
+                                                   const bool is_simple,
+                                                   const char escape);
+
+// Literal fragments which have to be found in any string matching an extended
+// POSIX regular expression. Fragments are detected conservatively: alternations,
+// groups and quantified atoms produce no literals.
+std::vector<std::string> get_regexp_pattern_literals(const std::string& pattern);
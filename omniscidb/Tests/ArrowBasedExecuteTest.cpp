@@ -19,8 +19,10 @@
 #include "TestHelpers.h"
 
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/QueryTrace.h"
 #include "QueryEngine/ResultSetReductionJIT.h"
 #include "ResultSet/ArrowResultSet.h"
+#include "Shared/Metrics.h"
 #include "Shared/scope.h"
 
 #include <gtest/gtest.h>
@@ -29,10 +31,12 @@
 #include <boost/config/pragma_message.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
 #include <cmath>
 #include <cstdio>
+#include <fstream>
 #include <random>
 #include <regex>
 
@@ -4949,6 +4953,72 @@ TEST_F(Select, DictionaryStringEquality) {
   }
 }
 
+TEST_F(Select, StringCompareSortedDict) {
+  const auto sorted_dict_import = config().storage.enable_sorted_dict_import;
+  ScopeGuard reset_sorted_dict_import = [&sorted_dict_import] {
+    config().storage.enable_sorted_dict_import = sorted_dict_import;
+  };
+  config().storage.enable_sorted_dict_import = true;
+
+  createTable("sorted_dict_test",
+              {{"i", ctx().int32()}, {"s", ctx().extDict(ctx().text(), 0)}});
+  insertCsvValues("sorted_dict_test", "1,foo\n2,bar\n3,baz\n4,qux\n5,\n6,abc");
+  for (auto dt : testedDevices()) {
+    auto count = [dt](const std::string& filter) {
+      return v<int64_t>(
+          run_simple_agg("SELECT COUNT(*) FROM sorted_dict_test WHERE " + filter + ";",
+                         dt));
+    };
+    ASSERT_EQ(count("s < 'baz'"), 2);
+    ASSERT_EQ(count("s <= 'baz'"), 3);
+    ASSERT_EQ(count("s > 'c'"), 2);
+    ASSERT_EQ(count("s >= 'foo'"), 2);
+    ASSERT_EQ(count("'bar' < s"), 3);
+    ASSERT_EQ(count("s < 'a'"), 0);
+    ASSERT_EQ(count("s > 'z'"), 0);
+
+    const auto rows = run_multiple_agg(
+        "SELECT s FROM sorted_dict_test WHERE s IS NOT NULL ORDER BY s DESC;", dt);
+    const std::vector<std::string> expected{"qux", "foo", "baz", "bar", "abc"};
+    ASSERT_EQ(rows->rowCount(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(boost::get<std::string>(v<NullableString>(rows->row(i, true, true)[0])),
+                expected[i]);
+    }
+  }
+
+  // New strings smaller than existing ones break the order of ids.
+  insertCsvValues("sorted_dict_test", "7,aaa");
+  for (auto dt : testedDevices()) {
+    ASSERT_EQ(v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM sorted_dict_test WHERE s < 'b';", dt)),
+              2);
+    const auto rows = run_multiple_agg(
+        "SELECT s FROM sorted_dict_test WHERE s < 'bar' ORDER BY s;", dt);
+    ASSERT_EQ(rows->rowCount(), size_t(2));
+    EXPECT_EQ(boost::get<std::string>(v<NullableString>(rows->row(0, true, true)[0])),
+              "aaa");
+  }
+  dropTable("sorted_dict_test");
+}
+
+TEST_F(Select, SortedDictImportOverflow) {
+  const auto old_storage = config().storage;
+  ScopeGuard reset_storage = [&old_storage] { config().storage = old_storage; };
+  config().storage.enable_sorted_dict_import = true;
+  // Encode on import to get the overflow error from the insert.
+  config().storage.enable_non_lazy_data_import = true;
+
+  createTable("sorted_dict_overflow_test", {{"s", ctx().extDict(ctx().text(), 0, 1)}});
+  std::ostringstream oss;
+  for (int i = 0; i < 300; ++i) {
+    oss << "str" << i << "\n";
+  }
+  EXPECT_THROW(insertCsvValues("sorted_dict_overflow_test", oss.str()),
+               std::runtime_error);
+  dropTable("sorted_dict_overflow_test");
+}
+
 TEST_F(Select, StringsNoneEncoding) {
   createTestLotsColsTable();
   for (auto dt : testedDevices()) {
@@ -8185,6 +8255,174 @@ TEST_F(Select, LogicalValues) {
   }
 }
 
+TEST_F(Select, ExplainAnalyze) {
+  auto explain_analyze = [](const std::string& query) {
+    auto co = getCompilationOptions(ExecutorDeviceType::CPU);
+    auto eo = getExecutionOptions(false).with_explain_analyze();
+    return runSqlQuery(query, co, eo);
+  };
+
+  {
+    const auto res = explain_analyze("SELECT x, COUNT(*) FROM test GROUP BY x;");
+    const auto profile = res.getProfile();
+    ASSERT_TRUE(profile);
+    ASSERT_FALSE(profile->steps.empty());
+    const auto& step = profile->steps.back();
+    EXPECT_EQ(step.device_type, "CPU");
+    EXPECT_EQ(step.work_units, size_t(1));
+    EXPECT_GT(step.kernels, size_t(0));
+    EXPECT_GE(step.code_cache_hits + step.code_cache_misses, size_t(1));
+    EXPECT_GT(step.fragments_scanned, size_t(0));
+    EXPECT_EQ(step.fragments_skipped, size_t(0));
+    EXPECT_EQ(step.input_rows, 2 * g_num_rows);
+    EXPECT_EQ(step.output_rows, size_t(2));
+    EXPECT_EQ(step.query_desc_type, "Perfect Hash");
+    EXPECT_GT(step.fetched_bytes[Data_Namespace::CPU_LEVEL], size_t(0));
+
+    const auto token = res.getToken();
+    ASSERT_EQ(size_t(1), token->rowCount());
+    const auto crt_row = token->row(0, true, true);
+    const auto explain_str = boost::get<std::string>(v<NullableString>(crt_row[0]));
+    EXPECT_EQ(explain_str, profile->toString());
+    EXPECT_EQ(explain_str.find("Step 1: "), size_t(0));
+  }
+
+  {
+    const auto res = explain_analyze("SELECT COUNT(*) FROM test WHERE x > 1000;");
+    const auto profile = res.getProfile();
+    ASSERT_TRUE(profile);
+    const auto& step = profile->steps.back();
+    EXPECT_EQ(step.fragments_scanned, size_t(0));
+    EXPECT_GT(step.fragments_skipped, size_t(0));
+    EXPECT_EQ(step.input_rows, size_t(0));
+  }
+
+  {
+    const auto res = explain_analyze(
+        "SELECT COUNT(*) FROM test JOIN test_inner ON test.x = test_inner.x;");
+    const auto profile = res.getProfile();
+    ASSERT_TRUE(profile);
+    size_t hash_tables = 0;
+    for (auto& step : profile->steps) {
+      hash_tables += step.hash_tables;
+    }
+    EXPECT_GT(hash_tables, size_t(0));
+  }
+}
+
+TEST_F(Select, ExplainAnalyzeHwCounters) {
+  const auto orig_enable_perf_counters = config().debug.enable_perf_counters;
+  config().debug.enable_perf_counters = true;
+  ScopeGuard reset = [&] {
+    config().debug.enable_perf_counters = orig_enable_perf_counters;
+  };
+
+  auto co = getCompilationOptions(ExecutorDeviceType::CPU);
+  auto eo = getExecutionOptions(false).with_explain_analyze();
+  const auto res = runSqlQuery(
+      "SELECT test.x, COUNT(*) FROM test JOIN test_inner ON test.x = test_inner.x "
+      "GROUP BY test.x;",
+      co,
+      eo);
+  const auto profile = res.getProfile();
+  ASSERT_TRUE(profile);
+  for (auto& step : profile->steps) {
+    if (PerfEventCounters::isAvailable()) {
+      EXPECT_EQ(step.kernel_hw_counters.measurements, step.kernels);
+      EXPECT_EQ(step.hash_table_hw_counters.measurements, step.hash_tables);
+      if (step.kernels) {
+        EXPECT_GT(step.kernel_hw_counters.cycles, uint64_t(0));
+      }
+    } else {
+      // Counters are silently skipped when perf events are not allowed.
+      EXPECT_EQ(step.kernel_hw_counters.measurements, size_t(0));
+      EXPECT_EQ(step.hash_table_hw_counters.measurements, size_t(0));
+    }
+  }
+}
+
+TEST_F(Select, Metrics) {
+  auto& registry = metrics::registry();
+  registry.reset();
+  auto co = getCompilationOptions(ExecutorDeviceType::CPU);
+  auto eo = getExecutionOptions(false);
+  runSqlQuery("SELECT COUNT(*) FROM test WHERE x > 7;", co, eo);
+  runSqlQuery("SELECT COUNT(*) FROM test WHERE x > 7;", co, eo);
+
+  EXPECT_GT(*registry.value("hdk_kernels_total"), 0.0);
+  auto cache_hits = registry.value("hdk_code_cache_lookups_total",
+                                   {{"device", "CPU"}, {"result", "hit"}});
+  ASSERT_TRUE(cache_hits);
+  EXPECT_GT(*cache_hits, 0.0);
+  auto compilation =
+      registry.findHistogram("hdk_compilation_seconds", {{"device", "CPU"}});
+  ASSERT_TRUE(compilation);
+  EXPECT_GT(compilation->count(), uint64_t(0));
+  EXPECT_EQ(registry.value("hdk_running_kernels"), 0.0);
+  EXPECT_GT(*registry.value("hdk_string_dictionaries"), 0.0);
+
+  const auto text = registry.toPrometheus();
+  EXPECT_NE(text.find("# TYPE hdk_kernels_total counter"), std::string::npos);
+  EXPECT_NE(text.find("hdk_buffer_pool_allocated_bytes{level=\"CPU\",device=\"0\"}"),
+            std::string::npos);
+}
+
+TEST_F(Select, QueryTrace) {
+  const auto trace_dir =
+      boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  const auto orig_trace_dir = config().debug.query_trace_dir;
+  config().debug.query_trace_dir = trace_dir.string();
+  ScopeGuard reset = [&] {
+    config().debug.query_trace_dir = orig_trace_dir;
+    boost::filesystem::remove_all(trace_dir);
+  };
+
+  auto co = getCompilationOptions(ExecutorDeviceType::CPU);
+  auto eo = getExecutionOptions(false).with_query_trace();
+  runSqlQuery("SELECT x, COUNT(*) FROM test GROUP BY x;", co, eo);
+
+  std::vector<boost::filesystem::path> traces;
+  for (auto& entry : boost::filesystem::directory_iterator(trace_dir)) {
+    traces.push_back(entry.path());
+  }
+  ASSERT_EQ(traces.size(), size_t(1));
+  EXPECT_EQ(traces.front().extension().string(), ".json");
+
+  std::ifstream in(traces.front().string());
+  std::string trace((std::istreambuf_iterator<char>(in)),
+                    std::istreambuf_iterator<char>());
+  EXPECT_EQ(trace.find("{\"traceEvents\":["), size_t(0));
+  EXPECT_NE(trace.find("\"name\":\"executeRelAlgQuery\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"ExecutionKernel::run\""), std::string::npos);
+
+  // No trace is written when tracing is disabled.
+  runSqlQuery("SELECT COUNT(*) FROM test;", co, eo.with_query_trace(false));
+  EXPECT_EQ(std::distance(boost::filesystem::directory_iterator(trace_dir),
+                          boost::filesystem::directory_iterator()),
+            1);
+
+  // A query traced in a caller's trace becomes its part, e.g. to cover the result
+  // conversion.
+  {
+    QueryTrace outer(config(), true, __FILE__, __LINE__, "outer");
+    auto res = runSqlQuery("SELECT COUNT(*) FROM test;", co, eo);
+    res.getToken()->toArrow();
+  }
+  traces.clear();
+  for (auto& entry : boost::filesystem::directory_iterator(trace_dir)) {
+    traces.push_back(entry.path());
+  }
+  ASSERT_EQ(traces.size(), size_t(2));
+  auto outer_trace = std::find_if(traces.begin(), traces.end(), [](const auto& path) {
+    std::ifstream in(path.string());
+    std::string trace((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    return trace.find("\"name\":\"outer\"") != std::string::npos &&
+           trace.find("\"name\":\"executeRelAlgQuery\"") != std::string::npos;
+  });
+  EXPECT_NE(outer_trace, traces.end());
+}
+
 TEST_F(Select, UnsupportedNodes) {
   for (auto dt : testedDevices()) {
     // MAT No longer throws a logicalValues gets a regular parse error'
@@ -8634,6 +8872,29 @@ TEST_F(Select, TopNSortWithWatchdogOn) {
   }
 }
 
+TEST_F(Select, RadixSort) {
+  ScopeGuard reset = [orig_exec = config().exec, orig_rs = config().rs] {
+    config().exec = orig_exec;
+    config().rs = orig_rs;
+  };
+  config().rs.enable_columnar_output = true;
+  config().exec.radix_sort_min = 0;
+  for (auto dt : testedDevices()) {
+    for (bool enable_radix_sort : {false, true}) {
+      config().exec.enable_radix_sort = enable_radix_sort;
+      c("SELECT x FROM test ORDER BY x;", dt);
+      c("SELECT t FROM test WHERE t IS NOT NULL ORDER BY t DESC;", dt);
+      c("SELECT z FROM test WHERE z IS NOT NULL ORDER BY z;", dt);
+      c("SELECT f FROM test WHERE f IS NOT NULL ORDER BY f DESC;", dt);
+      c("SELECT d FROM test WHERE d IS NOT NULL ORDER BY d;", dt);
+      c("SELECT str FROM test ORDER BY str;", dt);
+      c("SELECT str FROM test ORDER BY str DESC;", dt);
+      // Filtered out entries are not initialized.
+      c("SELECT str FROM test WHERE x > 7 ORDER BY str;", dt);
+    }
+  }
+}
+
 TEST_F(Select, GroupByPerfectHash) {
   const auto default_bigint_flag = config().exec.group_by.bigint_count;
   ScopeGuard reset = [default_bigint_flag] {
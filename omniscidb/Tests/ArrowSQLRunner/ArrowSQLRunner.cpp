@@ -111,12 +111,10 @@ class ArrowSQLRunnerImpl {
   }
 
   ExecutionResult runQuery(std::unique_ptr<hdk::ir::QueryDag> dag,
-                           ExecutorDeviceType device_type,
-                           bool allow_loop_joins) {
+                           const CompilationOptions& co,
+                           const ExecutionOptions& eo) {
     auto ra_executor =
         std::make_unique<RelAlgExecutor>(executor_.get(), schema_mgr_, std::move(dag));
-    auto eo = getExecutionOptions(allow_loop_joins);
-    auto co = getCompilationOptions(device_type);
     ExecutionResult res;
 
     execution_time_ += measure<std::chrono::microseconds>::execution(
@@ -125,6 +123,14 @@ class ArrowSQLRunnerImpl {
     return res;
   }
 
+  ExecutionResult runQuery(std::unique_ptr<hdk::ir::QueryDag> dag,
+                           ExecutorDeviceType device_type,
+                           bool allow_loop_joins) {
+    return runQuery(std::move(dag),
+                    getCompilationOptions(device_type),
+                    getExecutionOptions(allow_loop_joins));
+  }
+
   ExecutionResult runSqlQuery(const std::string& sql,
                               ExecutorDeviceType device_type,
                               const ExecutionOptions& eo) {
@@ -461,6 +467,12 @@ ExecutionResult runSqlQuery(const std::string& sql,
   return ArrowSQLRunnerImpl::get()->runSqlQuery(sql, device_type, allow_loop_joins);
 }
 
+ExecutionResult runQuery(std::unique_ptr<hdk::ir::QueryDag> dag,
+                         const CompilationOptions& co,
+                         const ExecutionOptions& eo) {
+  return ArrowSQLRunnerImpl::get()->runQuery(std::move(dag), co, eo);
+}
+
 ExecutionResult runQuery(std::unique_ptr<hdk::ir::QueryDag> dag,
                          ExecutorDeviceType device_type,
                          bool allow_loop_joins) {
@@ -74,6 +74,10 @@ ExecutionResult runSqlQuery(const std::string& sql,
                             ExecutorDeviceType device_type,
                             bool allow_loop_joins);
 
+ExecutionResult runQuery(std::unique_ptr<hdk::ir::QueryDag> dag,
+                         const CompilationOptions& co,
+                         const ExecutionOptions& eo);
+
 ExecutionResult runQuery(std::unique_ptr<hdk::ir::QueryDag> dag,
                          ExecutorDeviceType device_type = ExecutorDeviceType::CPU,
                          bool allow_loop_joins = false);
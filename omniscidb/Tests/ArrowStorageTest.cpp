@@ -765,6 +765,42 @@ TEST_F(ArrowStorageTest, ImportArrowTable) {
   storage.dropTable("test_empty");
 }
 
+TEST_F(ArrowStorageTest, ImportArrowTable_FixedSizeBinary) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  auto make_chunk = [](const std::vector<std::string>& vals) {
+    arrow::FixedSizeBinaryBuilder builder(arrow::fixed_size_binary(4));
+    for (auto& val : vals) {
+      if (val == "<NULL>") {
+        ARROW_THROW_NOT_OK(builder.AppendNull());
+      } else {
+        ARROW_THROW_NOT_OK(builder.Append(reinterpret_cast<const uint8_t*>(val.data())));
+      }
+    }
+    std::shared_ptr<arrow::Array> res;
+    ARROW_THROW_NOT_OK(builder.Finish(&res));
+    return res;
+  };
+  auto col_data = std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{
+      make_chunk({"xx00"s, "ab01"s, "cd02"s, "ef03"s})->Slice(1),
+      make_chunk({"gh04"s, "<NULL>"s, "ij05"s})});
+  auto schema = arrow::schema({arrow::field("col1", arrow::fixed_size_binary(4)),
+                               arrow::field("col2", arrow::fixed_size_binary(4))});
+  auto at = arrow::Table::Make(schema, {col_data, col_data});
+
+  auto tinfo = storage.importArrowTable(at, "table1", ArrowStorage::TableOptions{2});
+  ASSERT_TRUE(storage.getColumnInfo(*tinfo, "col1")->type->isText());
+  std::vector<std::string> expected = {
+      "ab01"s, "cd02"s, "ef03"s, "gh04"s, "<NULL>"s, "ij05"s};
+  checkData(storage, tinfo->table_id, 6, 2, expected, expected);
+
+  auto tinfo2 = storage.importArrowTable(
+      at,
+      "table2",
+      {{"col1", ctx.text()}, {"col2", ctx.extDict(ctx.text(), 0)}},
+      ArrowStorage::TableOptions{2});
+  checkData(storage, tinfo2->table_id, 6, 2, expected, expected);
+}
+
 TEST_F(ArrowStorageTest, DropTable) {
   ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
   auto tinfo = storage.createTable("table1",
@@ -806,6 +842,72 @@ TEST_F(ArrowStorageTest, DropTable_SharedDicts) {
             nullptr);
 }
 
+TEST_F(ArrowStorageTest, CreateTable_DictDomains) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  ArrowStorage::TableOptions table_options;
+  table_options.dict_domains = {{"col1", "domain1"}};
+  auto tinfo1 = storage.createTable("table1",
+                                    {{"col1", ctx.extDict(ctx.text(), 0)},
+                                     {"col2", ctx.extDict(ctx.text(), 0)}},
+                                    table_options);
+  table_options.dict_domains = {{"col3", "domain1"}};
+  auto tinfo2 = storage.createTable("table2",
+                                    {{"col3", ctx.extDict(ctx.text(), 0)},
+                                     {"col2", ctx.extDict(ctx.text(), 0)}},
+                                    table_options);
+  auto dict_id1 = getDictId(storage.getColumnInfo(*tinfo1, "col1")->type);
+  ASSERT_EQ(getDictId(storage.getColumnInfo(*tinfo2, "col3")->type), dict_id1);
+  ASSERT_NE(getDictId(storage.getColumnInfo(*tinfo1, "col2")->type),
+            getDictId(storage.getColumnInfo(*tinfo2, "col2")->type));
+
+  table_options.dict_domains = {{"col1", "domain1"}};
+  EXPECT_THROW_WITH_MESSAGE(
+      storage.createTable(
+          "table3", {{"col1", ctx.extDict(ctx.text(), 0, 2)}}, table_options),
+      "Column 'col1' and dictionary domain 'domain1' use different dictionary id "
+      "sizes");
+
+  storage.dropTable("table1");
+  ASSERT_NE(storage.getDictMetadata(dict_id1, /*load_dict=*/false), nullptr);
+  storage.dropTable("table2");
+  ASSERT_EQ(storage.getDictMetadata(dict_id1, /*load_dict=*/false), nullptr);
+
+  auto tinfo4 = storage.createTable(
+      "table4", {{"col1", ctx.extDict(ctx.text(), 0)}}, table_options);
+  ASSERT_NE(getDictId(storage.getColumnInfo(*tinfo4, "col1")->type), dict_id1);
+}
+
+TEST_F(ArrowStorageTest, CreateTable_DictDomains_Errors) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  ArrowStorage::TableOptions table_options;
+  table_options.dict_domains = {{"col2", "domain1"}};
+  EXPECT_THROW(storage.createTable(
+                   "table1", {{"col1", ctx.extDict(ctx.text(), 0)}}, table_options),
+               std::runtime_error);
+  table_options.dict_domains = {{"col1", "domain1"}};
+  EXPECT_THROW(storage.createTable("table1", {{"col1", ctx.text()}}, table_options),
+               std::runtime_error);
+}
+
+TEST_F(ArrowStorageTest, CreateTable_ShareDictsByColumnName) {
+  auto config = std::make_shared<Config>(*config_);
+  config->storage.share_dicts_by_column_name = true;
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+  auto tinfo1 = storage.createTable("table1",
+                                    {{"col1", ctx.extDict(ctx.text(), 0)},
+                                     {"col2", ctx.extDict(ctx.text(), 0)}});
+  ArrowStorage::TableOptions table_options;
+  table_options.dict_domains = {{"col2", ""}};
+  auto tinfo2 = storage.createTable("table2",
+                                    {{"col1", ctx.extDict(ctx.text(), 0)},
+                                     {"col2", ctx.extDict(ctx.text(), 0)}},
+                                    table_options);
+  ASSERT_EQ(getDictId(storage.getColumnInfo(*tinfo1, "col1")->type),
+            getDictId(storage.getColumnInfo(*tinfo2, "col1")->type));
+  ASSERT_NE(getDictId(storage.getColumnInfo(*tinfo1, "col2")->type),
+            getDictId(storage.getColumnInfo(*tinfo2, "col2")->type));
+}
+
 void Test_ImportCsv_Numbers(const std::string& file_name,
                             const ArrowStorage::CsvParseOptions parse_options,
                             ConfigPtr config,
@@ -1269,6 +1371,88 @@ TEST_F(ArrowStorageTest, ImportCsv_Dict) {
   Test_ImportCsv_Dict(false, false, parse_options, config_);
 }
 
+TEST_F(ArrowStorageTest, ImportCsv_Dict_Compact) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  ArrowStorage::TableOptions table_options;
+  auto dict_type = ctx.extDict(ctx.text(), 0);
+  auto tinfo = storage.importCsvFile(getFilePath("strings.csv"),
+                                     "table1",
+                                     {{"col1", dict_type}, {"col2", dict_type}},
+                                     table_options,
+                                     ArrowStorage::CsvParseOptions());
+  ASSERT_GT(storage.compactDictionaries(), (size_t)0);
+  storage.appendCsvFile(getFilePath("strings.csv"), "table1");
+
+  std::vector<std::string> col1_expected = {"s1"s, "ss2"s, "sss3"s, "ssss4"s, "sssss5"s};
+  std::vector<std::string> col2_expected = {
+      "dd1"s, "dddd2"s, "dddddd3"s, "dddddddd4"s, "dddddddddd5"s};
+  checkData(storage,
+            tinfo->table_id,
+            10,
+            table_options.fragment_size,
+            duplicate(col1_expected),
+            duplicate(col2_expected));
+}
+
+TEST_F(ArrowStorageTest, ImportCsv_Dict_LazyMaterializationStatus) {
+  auto config = std::make_shared<Config>(*config_);
+  config->storage.enable_lazy_dict_materialization = true;
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+  auto tinfo = storage.importCsvFile(
+      getFilePath("strings.csv"),
+      "table1",
+      {{"col1", ctx.extDict(ctx.text(), 0)}, {"col2", ctx.extDict(ctx.text(), 0)}});
+
+  auto status = storage.getDictMaterializationStatus();
+  ASSERT_EQ(status.size(), (size_t)2);
+  for (auto& dict_status : status) {
+    ASSERT_FALSE(dict_status.is_materialized);
+    ASSERT_FALSE(dict_status.is_scheduled);
+    ASSERT_EQ(dict_status.column_count, (size_t)1);
+    ASSERT_EQ(dict_status.materialized_column_count, (size_t)0);
+  }
+
+  storage.getDictMetadata(status.front().dict_id, true);
+  status = storage.getDictMaterializationStatus();
+  ASSERT_TRUE(status.front().is_materialized);
+  ASSERT_EQ(status.front().materialized_column_count, (size_t)1);
+  ASSERT_FALSE(status.back().is_materialized);
+  ASSERT_EQ(status.back().materialized_column_count, (size_t)0);
+}
+
+TEST_F(ArrowStorageTest, ImportCsv_Dict_BackgroundMaterialization) {
+  auto config = std::make_shared<Config>(*config_);
+  config->storage.enable_lazy_dict_materialization = true;
+  config->storage.background_dict_materialization_threads = 2;
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+  ArrowStorage::TableOptions table_options;
+  table_options.fragment_size = 3;
+  auto dict_type = ctx.extDict(ctx.text(), -1);
+  auto tinfo = storage.importCsvFile(getFilePath("strings.csv"),
+                                     "table1",
+                                     {{"col1", dict_type}, {"col2", dict_type}},
+                                     table_options);
+  storage.appendCsvFile(getFilePath("strings.csv"), "table1");
+  storage.waitDictionaryMaterialization();
+
+  auto status = storage.getDictMaterializationStatus();
+  ASSERT_EQ(status.size(), (size_t)1);
+  ASSERT_TRUE(status.front().is_materialized);
+  ASSERT_FALSE(status.front().is_scheduled);
+  ASSERT_EQ(status.front().column_count, (size_t)2);
+  ASSERT_EQ(status.front().materialized_column_count, (size_t)2);
+
+  std::vector<std::string> col1_expected = {"s1"s, "ss2"s, "sss3"s, "ssss4"s, "sssss5"s};
+  std::vector<std::string> col2_expected = {
+      "dd1"s, "dddd2"s, "dddddd3"s, "dddddddd4"s, "dddddddddd5"s};
+  checkData(storage,
+            tinfo->table_id,
+            10,
+            table_options.fragment_size,
+            duplicate(col1_expected),
+            duplicate(col2_expected));
+}
+
 TEST_F(ArrowStorageTest, ImportCsv_Dict_SmallBlock) {
   ArrowStorage::CsvParseOptions parse_options;
   parse_options.block_size = 50;
@@ -1411,6 +1595,83 @@ TEST_F(ArrowStorageTest, AppendCsv_SharedDict) {
   Test_ImportCsv_Dict(true, true, parse_options, config_);
 }
 
+TEST_F(ArrowStorageTest, AppendArrow_SharedDictColumns) {
+  auto config = std::make_shared<Config>(*config_);
+  config->storage.enable_non_lazy_data_import = true;
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+  // Columns sharing the dictionary are encoded one by one, while other tasks
+  // may run parallel lookups of known strings in the same dictionary.
+  constexpr int col_count = 8;
+  constexpr int row_count = 50'000;
+  auto dict_type = ctx.extDict(ctx.text(), -1);
+  std::vector<ArrowStorage::ColumnDescription> col_descs;
+  arrow::SchemaBuilder schema_builder;
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> col_arrs;
+  std::vector<std::vector<std::string>> expected(col_count);
+  for (int col_idx = 0; col_idx < col_count; ++col_idx) {
+    auto col_name = "col" + std::to_string(col_idx + 1);
+    col_descs.push_back({col_name, dict_type});
+    ARROW_THROW_NOT_OK(
+        schema_builder.AddField(std::make_shared<arrow::Field>(col_name, arrow::utf8())));
+    arrow::StringBuilder builder;
+    for (int row_idx = 0; row_idx < row_count; ++row_idx) {
+      expected[col_idx].push_back("str" + std::to_string((row_idx + col_idx * 1000) %
+                                                         (row_count / 2)));
+      ARROW_THROW_NOT_OK(builder.Append(expected[col_idx].back()));
+    }
+    col_arrs.push_back(
+        std::make_shared<arrow::ChunkedArray>(builder.Finish().ValueOrDie()));
+  }
+  auto at = arrow::Table::Make(schema_builder.Finish().ValueOrDie(), col_arrs);
+
+  auto tinfo = storage.createTable("table1", col_descs);
+  // The second append finds all strings in the dictionary.
+  storage.appendArrowTable(at, "table1");
+  storage.appendArrowTable(at, "table1");
+
+  for (auto& col_expected : expected) {
+    col_expected = duplicate(col_expected);
+  }
+  checkData(storage,
+            tinfo->table_id,
+            row_count * 2,
+            32'000'000,
+            expected[0],
+            expected[1],
+            expected[2],
+            expected[3],
+            expected[4],
+            expected[5],
+            expected[6],
+            expected[7]);
+}
+
+TEST_F(ArrowStorageTest, AppendArrow_SharedDictColumnsOrder) {
+  auto config = std::make_shared<Config>(*config_);
+  config->storage.enable_non_lazy_data_import = true;
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+  auto tinfo = storage.createTable("table1",
+                                   {{"col1", ctx.extDict(ctx.text(), -1)},
+                                    {"col2", ctx.extDict(ctx.text(), -1)}});
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  storage.appendCsvData("b,c\na,a\n", tinfo->table_id, parse_options);
+
+  // Ids are assigned in the column order.
+  auto col_info = storage.getColumnInfo(TEST_DB_ID, tinfo->table_id, 1);
+  auto& dict = *storage.getDictMetadata(getDictId(col_info->type))->stringDict;
+  ASSERT_EQ(dict.storageEntryCount(), (size_t)3);
+  ASSERT_EQ(dict.getIdOfString("b"), 0);
+  ASSERT_EQ(dict.getIdOfString("a"), 1);
+  ASSERT_EQ(dict.getIdOfString("c"), 2);
+  checkData(storage,
+            tinfo->table_id,
+            2,
+            32'000'000,
+            std::vector<std::string>({"b"s, "a"s}),
+            std::vector<std::string>({"c"s, "a"s}));
+}
+
 TEST_F(ArrowStorageTest, AppendJsonData) {
   ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
   TableInfoPtr tinfo = storage.createTable(
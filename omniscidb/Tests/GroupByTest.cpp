@@ -27,6 +27,8 @@
 
 #include <boost/filesystem.hpp>
 #include <fstream>
+#include <map>
+#include <set>
 
 EXTERN extern bool g_is_test_env;
 
@@ -368,6 +370,217 @@ TEST_F(BigCardinalityThresholdTest, EmptyFilters) {
   }
 }
 
+class AdaptiveGroupByTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    createTable("adaptive_groupby", {{"id", ctx().int64()}, {"v", ctx().int32()}}, {32});
+    std::stringstream ss;
+    for (int64_t i = 0; i < 40; ++i) {
+      // Use distinct wide range keys to force baseline hash layout. The reduced result
+      // doesn't fit a buffer of the biggest fragment size.
+      ss << i * 1000000007LL << ", " << i << std::endl;
+    }
+    insertCsvValues("adaptive_groupby", ss.str());
+  }
+
+  void TearDown() override { dropTable("adaptive_groupby"); }
+
+  static QueryStepProfile runGroupBy() {
+    auto res = runSqlQuery("SELECT id, SUM(v) FROM adaptive_groupby GROUP BY id;",
+                           getCompilationOptions(ExecutorDeviceType::CPU),
+                           getExecutionOptions(false).with_explain_analyze());
+    EXPECT_EQ(res.getRows()->rowCount(), size_t(40));
+    auto profile = res.getProfile();
+    EXPECT_TRUE(profile);
+    for (auto& step : profile->steps) {
+      if (step.groupby_buffer_entries) {
+        return step;
+      }
+    }
+    ADD_FAILURE() << "No group-by step in the profile";
+    return {};
+  }
+};
+
+TEST_F(AdaptiveGroupByTest, GrowBufferOnOutOfSlots) {
+  auto old_exec = config().exec;
+  ScopeGuard reset = [&old_exec] { config().exec = old_exec; };
+  config().exec.group_by.enable_cpu_multifrag_kernels = false;
+  config().exec.group_by.default_max_groups_buffer_entry_guess = 16;
+  config().exec.group_by.enable_adaptive_groupby = true;
+
+  // The initial 16 entries guess runs out of slots. The retry path re-executes the
+  // step with the biggest fragment size of 32 entries, which is still not enough, and
+  // then doubles it.
+  auto first = runGroupBy();
+  EXPECT_EQ(first.groupby_buffer_retries, size_t(2));
+  EXPECT_EQ(first.groupby_buffer_entries, size_t(64));
+
+  // The observed 40 groups are put into the cardinality cache as 80 entries, so the
+  // next execution doesn't need to grow the buffer.
+  auto second = runGroupBy();
+  EXPECT_EQ(second.groupby_buffer_retries, size_t(0));
+  EXPECT_EQ(second.groupby_buffer_entries, size_t(80));
+}
+
+class TreeReductionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    createTable("tree_reduction", {{"id", ctx().int64()}, {"v", ctx().int32()}}, {10});
+    std::stringstream ss;
+    for (int64_t i = 0; i < 200; ++i) {
+      // Use wide range keys to force baseline hash layout.
+      auto key = (i % 50) * 1000000000LL;
+      ss << key << ", " << i << std::endl;
+      expected_sums[key] += i;
+    }
+    insertCsvValues("tree_reduction", ss.str());
+  }
+
+  void TearDown() override { dropTable("tree_reduction"); }
+
+  std::map<int64_t, int64_t> expected_sums;
+};
+
+TEST_F(TreeReductionTest, BaselineGroupBy) {
+  auto old_exec = config().exec;
+  ScopeGuard reset = [&old_exec] { config().exec = old_exec; };
+  config().exec.group_by.enable_cpu_multifrag_kernels = false;
+  config().exec.group_by.tree_reduction_threshold = 2;
+  for (bool enable_tree_reduction : {false, true}) {
+    config().exec.group_by.enable_tree_reduction = enable_tree_reduction;
+    auto result = run_multiple_agg(
+        "SELECT id, SUM(v) FROM tree_reduction GROUP BY id ORDER BY id;",
+        ExecutorDeviceType::CPU);
+    ASSERT_EQ(result->rowCount(), expected_sums.size());
+    for (auto& [key, sum] : expected_sums) {
+      auto row = result->getNextRow(false, false);
+      ASSERT_EQ(row.size(), size_t(2));
+      EXPECT_EQ(v<int64_t>(row[0]), key);
+      EXPECT_EQ(v<int64_t>(row[1]), sum);
+    }
+  }
+}
+
+class RoaringCountDistinctTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    createTable("roaring_cd",
+                {{"id", ctx().int32()}, {"v", ctx().int64()}, {"w", ctx().int64()}},
+                {1000});
+    std::stringstream ss;
+    for (int64_t i = 0; i < 10000; ++i) {
+      auto id = i % 3;
+      // Sparse values with the range narrow enough for a bitmap.
+      auto w = i * 1000;
+      if (i % 97 == 0) {
+        ss << id << ", , " << w << std::endl;
+        continue;
+      }
+      // A dense cluster of values followed by sparse values spread over a wide range.
+      auto val = i < 6000 ? i : i * 1000003LL;
+      ss << id << ", " << val << ", " << w << std::endl;
+      expected_groups[id].insert(val);
+      expected_total.insert(val);
+    }
+    insertCsvValues("roaring_cd", ss.str());
+  }
+
+  void TearDown() override { dropTable("roaring_cd"); }
+
+  std::map<int64_t, std::set<int64_t>> expected_groups;
+  std::set<int64_t> expected_total;
+};
+
+TEST_F(RoaringCountDistinctTest, ExactCount) {
+  auto old_exec = config().exec;
+  ScopeGuard reset = [&old_exec] { config().exec = old_exec; };
+  // Force roaring sets regardless of the expected density.
+  config().exec.group_by.roaring_count_distinct_min_density = 0;
+  config().exec.group_by.roaring_count_distinct_bitmap_threshold = 0;
+  for (bool enable_roaring : {false, true}) {
+    config().exec.group_by.enable_roaring_count_distinct = enable_roaring;
+    {
+      auto result = run_multiple_agg("SELECT COUNT(DISTINCT v) FROM roaring_cd;",
+                                     ExecutorDeviceType::CPU);
+      auto row = result->getNextRow(false, false);
+      ASSERT_EQ(row.size(), size_t(1));
+      EXPECT_EQ(v<int64_t>(row[0]), static_cast<int64_t>(expected_total.size()));
+    }
+    {
+      auto result = run_multiple_agg(
+          "SELECT id, COUNT(DISTINCT v) FROM roaring_cd GROUP BY id ORDER BY id;",
+          ExecutorDeviceType::CPU);
+      ASSERT_EQ(result->rowCount(), expected_groups.size());
+      for (auto& [id, vals] : expected_groups) {
+        auto row = result->getNextRow(false, false);
+        ASSERT_EQ(row.size(), size_t(2));
+        EXPECT_EQ(v<int64_t>(row[0]), id);
+        EXPECT_EQ(v<int64_t>(row[1]), static_cast<int64_t>(vals.size()));
+      }
+    }
+  }
+}
+
+TEST_F(RoaringCountDistinctTest, Watchdog) {
+  auto old_exec = config().exec;
+  ScopeGuard reset = [&old_exec] { config().exec = old_exec; };
+  config().exec.group_by.enable_roaring_count_distinct = true;
+  config().exec.group_by.roaring_count_distinct_min_density = 0;
+  config().exec.group_by.roaring_count_distinct_bitmap_threshold = 0;
+  config().exec.watchdog.enable = true;
+  // The range of v is too wide for a bitmap, the watchdog rejects it even though a
+  // roaring set could be used instead of a hash set.
+  EXPECT_THROW(run_multiple_agg("SELECT COUNT(DISTINCT v) FROM roaring_cd;",
+                                ExecutorDeviceType::CPU),
+               std::runtime_error);
+  // Roaring sets replacing bitmaps are allowed.
+  auto result = run_multiple_agg("SELECT COUNT(DISTINCT w) FROM roaring_cd;",
+                                 ExecutorDeviceType::CPU);
+  auto row = result->getNextRow(false, false);
+  ASSERT_EQ(row.size(), size_t(1));
+  EXPECT_EQ(v<int64_t>(row[0]), int64_t(10000));
+}
+
+class SparseHllTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    createTable("sparse_hll", {{"id", ctx().int32()}, {"v", ctx().int64()}}, {2000});
+    std::stringstream ss;
+    for (int64_t i = 0; i < 20000; ++i) {
+      // One large group to switch its sketch to dense registers and many small ones.
+      auto id = i < 10000 ? 0 : i % 1000 + 1;
+      ss << id << ", " << i << std::endl;
+    }
+    insertCsvValues("sparse_hll", ss.str());
+  }
+
+  void TearDown() override { dropTable("sparse_hll"); }
+};
+
+TEST_F(SparseHllTest, MatchesDenseRegisters) {
+  auto old_exec = config().exec;
+  ScopeGuard reset = [&old_exec] { config().exec = old_exec; };
+  config().exec.group_by.sparse_hll_groups_threshold = 1;
+  std::vector<std::map<int64_t, int64_t>> estimates;
+  for (bool enable_sparse_hll : {false, true}) {
+    config().exec.group_by.enable_sparse_hll = enable_sparse_hll;
+    auto result = run_multiple_agg(
+        "SELECT id, APPROX_COUNT_DISTINCT(v) FROM sparse_hll GROUP BY id;",
+        ExecutorDeviceType::CPU);
+    ASSERT_EQ(result->rowCount(), size_t(1001));
+    auto& group_estimates = estimates.emplace_back();
+    for (size_t i = 0; i < result->rowCount(); ++i) {
+      auto row = result->getNextRow(false, false);
+      ASSERT_EQ(row.size(), size_t(2));
+      group_estimates[v<int64_t>(row[0])] = v<int64_t>(row[1]);
+    }
+  }
+  EXPECT_EQ(estimates[0], estimates[1]);
+  EXPECT_NEAR(estimates[1][0], 10000, 10000 * 0.1);
+  EXPECT_NEAR(estimates[1][1], 10, 1);
+}
+
 int main(int argc, char** argv) {
   g_is_test_env = true;
 
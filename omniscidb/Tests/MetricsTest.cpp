@@ -0,0 +1,165 @@
+/**
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Shared/Metrics.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <thread>
+
+TEST(Metrics, Counter) {
+  metrics::Registry registry;
+  auto& counter = registry.counter("test_total", "Test counter.");
+  counter.inc();
+  counter.inc(2);
+  EXPECT_EQ(counter.value(), uint64_t(3));
+  // The same metric is returned for the same name and labels.
+  EXPECT_EQ(&registry.counter("test_total", "Test counter."), &counter);
+  EXPECT_EQ(registry.value("test_total"), 3.0);
+  EXPECT_FALSE(registry.value("test_total", {{"kind", "other"}}));
+  EXPECT_FALSE(registry.value("missing_total"));
+
+  registry.reset();
+  EXPECT_EQ(counter.value(), uint64_t(0));
+}
+
+TEST(Metrics, ConcurrentUpdates) {
+  metrics::Registry registry;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&registry]() {
+      for (int j = 0; j < 1000; ++j) {
+        registry.counter("test_total", "Test counter.").inc();
+        registry.histogram("test_seconds", "Test histogram.").observe(0.5);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(registry.value("test_total"), 4000.0);
+  auto histogram = registry.findHistogram("test_seconds");
+  ASSERT_TRUE(histogram);
+  EXPECT_EQ(histogram->count(), uint64_t(4000));
+  EXPECT_DOUBLE_EQ(histogram->sum(), 2000.0);
+}
+
+TEST(Metrics, Gauge) {
+  metrics::Registry registry;
+  auto& gauge = registry.gauge("test_bytes", "Test gauge.", {{"device", "CPU"}});
+  gauge.add(10);
+  gauge.sub(3);
+  EXPECT_EQ(registry.value("test_bytes", {{"device", "CPU"}}), 7.0);
+  gauge.set(-1);
+  EXPECT_EQ(gauge.value(), -1);
+  // Gauges are not affected by reset.
+  registry.reset();
+  EXPECT_EQ(gauge.value(), -1);
+}
+
+TEST(Metrics, Histogram) {
+  metrics::Histogram histogram({1, 2, 5});
+  for (double value : {0.5, 1.0, 1.5, 3.0, 10.0, 20.0}) {
+    histogram.observe(value);
+  }
+  EXPECT_EQ(histogram.bucketCounts(), std::vector<uint64_t>({2, 1, 1, 2}));
+  EXPECT_EQ(histogram.count(), uint64_t(6));
+  EXPECT_DOUBLE_EQ(histogram.sum(), 36.0);
+  histogram.reset();
+  EXPECT_EQ(histogram.bucketCounts(), std::vector<uint64_t>({0, 0, 0, 0}));
+  EXPECT_EQ(histogram.count(), uint64_t(0));
+}
+
+TEST(Metrics, Collector) {
+  metrics::Registry registry;
+  int64_t value = 5;
+  auto id = registry.addCollector([&value](metrics::Registry& registry) {
+    registry.gauge("test_collected", "Collected gauge.").set(value);
+  });
+  EXPECT_EQ(registry.value("test_collected"), 5.0);
+  value = 7;
+  EXPECT_EQ(registry.value("test_collected"), 7.0);
+  registry.removeCollector(id);
+  value = 9;
+  EXPECT_EQ(registry.value("test_collected"), 7.0);
+}
+
+TEST(Metrics, Prometheus) {
+  metrics::Registry registry;
+  registry.counter("test_lookups_total", "Lookups.", {{"result", "hit"}}).inc(2);
+  registry.counter("test_lookups_total", "Lookups.", {{"result", "miss"}}).inc();
+  registry.gauge("test_name", "Quoted \"label\".", {{"name", "a\"b\\c"}}).set(1);
+  auto& histogram = registry.histogram("test_seconds", "Latency.", {}, {0.5, 1});
+  histogram.observe(0.25);
+  histogram.observe(2);
+
+  const std::string expected =
+      "# HELP test_lookups_total Lookups.\n"
+      "# TYPE test_lookups_total counter\n"
+      "test_lookups_total{result=\"hit\"} 2\n"
+      "test_lookups_total{result=\"miss\"} 1\n"
+      "# HELP test_name Quoted \"label\".\n"
+      "# TYPE test_name gauge\n"
+      "test_name{name=\"a\\\"b\\\\c\"} 1\n"
+      "# HELP test_seconds Latency.\n"
+      "# TYPE test_seconds histogram\n"
+      "test_seconds_bucket{le=\"0.5\"} 1\n"
+      "test_seconds_bucket{le=\"1\"} 1\n"
+      "test_seconds_bucket{le=\"+Inf\"} 2\n"
+      "test_seconds_sum 2.25\n"
+      "test_seconds_count 2\n";
+  EXPECT_EQ(registry.toPrometheus(), expected);
+
+  auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  registry.dumpPrometheus(path.string());
+  std::ifstream in(path.string());
+  std::string dumped((std::istreambuf_iterator<char>(in)),
+                     std::istreambuf_iterator<char>());
+  boost::filesystem::remove(path);
+  EXPECT_EQ(dumped, expected);
+
+  EXPECT_THROW(registry.dumpPrometheus("/nonexistent/dir/metrics.prom"),
+               std::runtime_error);
+}
+
+TEST(Metrics, Snapshot) {
+  metrics::Registry registry;
+  registry.counter("test_total", "Counter.", {{"kind", "a"}}).inc(3);
+  registry.gauge("test_bytes", "Gauge.").set(-2);
+  registry.histogram("test_seconds", "Latency.", {}, {1}).observe(0.5);
+
+  auto samples = registry.snapshot();
+  ASSERT_EQ(samples.size(), size_t(6));
+  EXPECT_EQ(samples[0].name, "test_bytes");
+  EXPECT_EQ(samples[0].value, -2.0);
+  EXPECT_EQ(samples[1].name, "test_seconds_bucket");
+  EXPECT_EQ(samples[1].labels, metrics::Labels({{"le", "1"}}));
+  EXPECT_EQ(samples[1].value, 1.0);
+  EXPECT_EQ(samples[2].labels, metrics::Labels({{"le", "+Inf"}}));
+  EXPECT_EQ(samples[3].name, "test_seconds_sum");
+  EXPECT_EQ(samples[3].value, 0.5);
+  EXPECT_EQ(samples[4].name, "test_seconds_count");
+  EXPECT_EQ(samples[4].value, 1.0);
+  EXPECT_EQ(samples[5].name, "test_total");
+  EXPECT_EQ(samples[5].labels, metrics::Labels({{"kind", "a"}}));
+  EXPECT_EQ(samples[5].value, 3.0);
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -197,6 +197,108 @@ TEST_F(PartitionedGroupByTest, Issue695) {
   compare_res_data(res, id1_vals, id2_vals, id3_vals, id4_vals, v1_sums, v2_sums);
 }
 
+TEST_F(PartitionedGroupByTest, SkewedKeys) {
+  auto old_exec = config().exec;
+  auto old_cache = config().cache;
+  ScopeGuard g([&old_exec, &old_cache]() {
+    config().exec = old_exec;
+    config().cache = old_cache;
+    dropTable("test_skewed");
+  });
+
+  // Zipf-like distribution: key i has ~(max_key / i) rows.
+  constexpr int64_t max_key = 20;
+  std::vector<int64_t> keys;
+  std::vector<int64_t> sums;
+  std::stringstream ss;
+  for (int64_t key = 1; key <= max_key; ++key) {
+    auto val = key == max_key ? 1000000000000 : key;  // to avoid perfect hash
+    int64_t sum = 0;
+    for (int64_t i = 0; i < max_key * 4 / key; ++i) {
+      ss << val << "," << i << std::endl;
+      sum += i;
+    }
+    keys.push_back(val);
+    sums.push_back(sum);
+  }
+  createTable("test_skewed", {{"id", ctx().int64()}, {"v", ctx().int32()}}, {20});
+  insertCsvValues("test_skewed", ss.str());
+
+  config().exec.group_by.default_max_groups_buffer_entry_guess = 1;
+  config().exec.group_by.big_group_threshold = 1;
+  config().exec.group_by.enable_cpu_partitioned_groupby = true;
+  config().exec.group_by.partitioning_buffer_size_threshold = 10;
+  config().exec.group_by.partitioning_group_size_threshold = 100;
+  config().exec.group_by.min_partitions = 2;
+  config().exec.group_by.max_partitions = 8;
+  config().exec.group_by.partitioning_buffer_target_size = 200;
+  config().exec.group_by.enable_skew_aware_partitioning = true;
+  config().exec.group_by.partitioning_skew_threshold = 1.1;
+  config().exec.enable_multifrag_execution_result = true;
+  // Cached cardinality would skip partitioning on the second run.
+  config().cache.use_estimator_result_cache = false;
+
+  // NDV-based buffers of skewed partitions are used only when the step can be
+  // retried with a grown buffer.
+  for (bool enable_adaptive_groupby : {false, true}) {
+    config().exec.group_by.enable_adaptive_groupby = enable_adaptive_groupby;
+    QueryBuilder builder(ctx(), getSchemaProvider(), configPtr());
+    auto dag = builder.scan("test_skewed").agg({"id"s}, {"sum(v)"s}).sort(0).finalize();
+    auto res = runQuery(std::move(dag),
+                        getCompilationOptions(ExecutorDeviceType::CPU),
+                        getExecutionOptions(false).with_explain_analyze());
+    compare_res_data(res, keys, sums);
+
+    auto profile = res.getProfile();
+    ASSERT_TRUE(profile);
+    auto step = std::find_if(
+        profile->steps.begin(), profile->steps.end(), [](const QueryStepProfile& step) {
+          return step.groupby_partitions != 0;
+        });
+    ASSERT_NE(step, profile->steps.end());
+    EXPECT_EQ(step->groupby_skewed_partitions, enable_adaptive_groupby);
+  }
+}
+
+TEST_F(PartitionedGroupByTest, AggregationWithTopN) {
+  auto old_exec = config().exec;
+  ScopeGuard g([&old_exec]() { config().exec = old_exec; });
+
+  config().exec.group_by.default_max_groups_buffer_entry_guess = 1;
+  config().exec.group_by.big_group_threshold = 1;
+  config().exec.group_by.enable_cpu_partitioned_groupby = true;
+  config().exec.group_by.partitioning_buffer_size_threshold = 10;
+  config().exec.group_by.partitioning_group_size_threshold = 1.5;
+  config().exec.group_by.min_partitions = 2;
+  config().exec.group_by.max_partitions = 8;
+  config().exec.group_by.partitioning_buffer_target_size = 200;
+  config().exec.enable_multifrag_execution_result = true;
+
+  constexpr size_t limit = 5;
+  constexpr size_t offset = 2;
+  std::vector<int64_t> expected_ids;
+  std::vector<int64_t> expected_sums;
+  for (size_t i = row_count - offset; i > row_count - offset - limit; --i) {
+    expected_ids.push_back(id1_vals[i - 1]);
+    expected_sums.push_back(v1_sums[i - 1]);
+  }
+
+  for (bool enable_top_n : {false, true}) {
+    config().exec.group_by.enable_partitioned_top_n = enable_top_n;
+    QueryBuilder builder(ctx(), getSchemaProvider(), configPtr());
+    auto dag = builder.scan("test1")
+                   .agg({"id1"s}, {"sum(v1)"s})
+                   .sort(1,
+                         SortDirection::Descending,
+                         NullSortedPosition::Last,
+                         limit,
+                         offset)
+                   .finalize();
+    auto res = runQuery(std::move(dag));
+    compare_res_data(res, expected_ids, expected_sums);
+  }
+}
+
 int main(int argc, char* argv[]) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
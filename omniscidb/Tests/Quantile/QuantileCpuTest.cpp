@@ -16,6 +16,7 @@
 
 #include "Shared/Intervals.h"
 #include "Shared/approx_quantile.h"
+#include "Shared/quantile.h"
 #include "Tests/TestHelpers.h"
 
 #include <gtest/gtest.h>
@@ -25,7 +26,9 @@
 
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <numeric>  // iota
+#include <random>
 #include <thread>   // hardware_concurrency - in tbb?
 
 using Real = double;
@@ -412,6 +415,74 @@ TEST(Quantile, SmallDataSetsAndMemory) {
   }
 }
 
+namespace {
+
+class TestAllocator : public SimpleAllocator {
+ public:
+  int8_t* allocate(const size_t num_bytes, const size_t) override {
+    buffers_.emplace_back(std::make_unique<int8_t[]>(num_bytes));
+    return buffers_.back().get();
+  }
+
+ private:
+  std::vector<std::unique_ptr<int8_t[]>> buffers_;
+};
+
+template <typename T>
+void checkExactQuantile(const std::vector<T>& values) {
+  std::vector<T> sorted(values);
+  std::sort(sorted.begin(), sorted.end());
+  for (double q : {0.0, 0.1, 0.5, 0.75, 1.0}) {
+    for (auto interpolation :
+         {hdk::ir::Interpolation::kLower, hdk::ir::Interpolation::kMidpoint}) {
+      TestAllocator allocator;
+      hdk::quantile::Quantile quantile(&allocator);
+      for (auto val : values) {
+        quantile.add(val);
+      }
+      quantile.finalize<T, double>(q, interpolation);
+      double pos = (sorted.size() - 1) * q;
+      size_t left_idx = std::floor(pos);
+      size_t right_idx =
+          interpolation == hdk::ir::Interpolation::kLower ? left_idx : std::ceil(pos);
+      auto left = sorted[left_idx];
+      auto right = sorted[right_idx];
+      double expected = left_idx == right_idx
+                            ? static_cast<double>(left)
+                            : static_cast<double>(left + (right - left) * 0.5);
+      EXPECT_EQ(expected, (quantile.quantile<T, double>(q, interpolation)))
+          << "q=" << q;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ExactQuantile, ParallelSelection) {
+  size_t const N = hdk::quantile::Quantile::kParallelSelectionThreshold * 2 + 1;
+  std::mt19937_64 gen(42);
+  {
+    // Few distinct values with many duplicates.
+    std::uniform_int_distribution<int32_t> dist(-1000, 1000);
+    std::vector<int32_t> values(N);
+    std::generate(values.begin(), values.end(), [&]() { return dist(gen); });
+    checkExactQuantile(values);
+  }
+  {
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<int64_t>::min(),
+                                                std::numeric_limits<int64_t>::max());
+    std::vector<int64_t> values(N);
+    std::generate(values.begin(), values.end(), [&]() { return dist(gen); });
+    checkExactQuantile(values);
+  }
+  {
+    std::normal_distribution<double> dist(0.0, 1e6);
+    std::vector<double> values(N);
+    std::generate(values.begin(), values.end(), [&]() { return dist(gen); });
+    checkExactQuantile(values);
+  }
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
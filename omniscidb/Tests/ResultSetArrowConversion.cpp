@@ -34,6 +34,7 @@
 #include <filesystem>
 #include <iostream>
 #include <limits>
+#include <optional>
 
 // arrow headers
 #include <arrow/api.h>
@@ -832,6 +833,87 @@ TEST(ArrowTable, Chunked_NULLS2) {
       table->column(2));
 }
 
+TEST(ArrowTable, Chunked_Dictionary) {
+  bool prev_enable_columnar_output = config().rs.enable_columnar_output;
+  bool prev_enable_lazy_fetch = config().rs.enable_lazy_fetch;
+  ScopeGuard reset = [prev_enable_columnar_output, prev_enable_lazy_fetch] {
+    config().rs.enable_columnar_output = prev_enable_columnar_output;
+    config().rs.enable_lazy_fetch = prev_enable_lazy_fetch;
+  };
+  config().rs.enable_columnar_output = true;
+  config().rs.enable_lazy_fetch = false;
+
+  auto res =
+      runSqlQuery("select t, i from chunked_nulls;", ExecutorDeviceType::CPU, true);
+  std::vector<std::string> col_names{"t", "i"};
+  // Force bulk dictionary fetch to get dictionary arrays indexed by string ids.
+  ArrowResultSetConverter converter(res.getRows(), col_names, -1, 0, 1000.0);
+  auto table = converter.convertToArrowTable();
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(table->num_rows(), (int64_t)6);
+
+  std::vector<std::optional<std::string>> expected{
+      "aaa"s, std::nullopt, "CCC"s, std::nullopt, "ee"s, std::nullopt};
+  std::vector<std::optional<std::string>> actual;
+  for (auto& chunk : table->column(0)->chunks()) {
+    ASSERT_EQ(chunk->type_id(), arrow::Type::DICTIONARY);
+    auto dict_chunk = std::static_pointer_cast<arrow::DictionaryArray>(chunk);
+    auto indices = std::static_pointer_cast<arrow::Int32Array>(dict_chunk->indices());
+    auto dict = std::static_pointer_cast<arrow::StringArray>(dict_chunk->dictionary());
+    for (int64_t i = 0; i < chunk->length(); ++i) {
+      if (chunk->IsNull(i)) {
+        actual.push_back(std::nullopt);
+      } else {
+        actual.push_back(dict->GetString(indices->Value(i)));
+      }
+    }
+  }
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(ColumnBatch, FetchColumns) {
+  bool prev_enable_multifrag_execution_result =
+      config().exec.enable_multifrag_execution_result;
+  ScopeGuard reset = [prev_enable_multifrag_execution_result] {
+    config().exec.enable_multifrag_execution_result =
+        prev_enable_multifrag_execution_result;
+  };
+  config().exec.enable_multifrag_execution_result = false;
+
+  auto res = runSqlQuery("select * from chunked_nulls;", ExecutorDeviceType::CPU, true);
+  auto batch = res.getToken()->fetchColumns(1, 4);
+  ASSERT_EQ(batch.row_count, (size_t)4);
+  ASSERT_EQ(batch.columns.size(), (size_t)4);
+
+  auto& t = batch.columns[0];
+  ASSERT_TRUE(t.dict);
+  EXPECT_TRUE(t.isNull(0));
+  EXPECT_EQ(t.dict->getString(t.values<int32_t>()[1]), "CCC"s);
+  EXPECT_TRUE(t.isNull(2));
+  EXPECT_EQ(t.dict->getString(t.values<int32_t>()[3]), "ee"s);
+
+  auto& i = batch.columns[1];
+  EXPECT_EQ(i.nulls, std::vector<uint8_t>({0, 1, 1, 0}));
+  EXPECT_EQ(i.values<int64_t>()[0], 0);
+  EXPECT_EQ(i.values<int64_t>()[3], 1);
+
+  auto& bi = batch.columns[2];
+  EXPECT_EQ(bi.nulls, std::vector<uint8_t>({0, 0, 0, 1}));
+  EXPECT_EQ(bi.values<int64_t>()[0], 2);
+  EXPECT_EQ(bi.values<int64_t>()[2], 4);
+
+  auto& d = batch.columns[3];
+  EXPECT_EQ(d.nulls, std::vector<uint8_t>({1, 1, 0, 0}));
+  EXPECT_EQ(d.values<double>()[2], 40.4);
+  EXPECT_EQ(d.values<double>()[3], 50.5);
+
+  // Row range is clamped to the table size.
+  auto tail = res.getToken()->fetchColumns(4, 100);
+  ASSERT_EQ(tail.row_count, (size_t)2);
+  EXPECT_EQ(tail.columns[2].values<int64_t>()[1], 6);
+  EXPECT_TRUE(tail.columns[3].isNull(1));
+}
+
 //  Tests for large tables
 TEST(ArrowTable, LargeTables) {
   bool prev_enable_columnar_output = config().rs.enable_columnar_output;
@@ -26,6 +26,8 @@
 #include <string_view>
 #include <vector>
 
+EXTERN extern bool g_enable_stringdict_trigram_index;
+
 std::string generate_random_str(std::mt19937& generator, const int64_t str_len) {
   constexpr char alphanum_lookup_table[] =
       "0123456789"
@@ -231,6 +233,51 @@ BENCHMARK_DEFINE_F(StringDictionaryFixture, BulkTranslation_10M_Unique)
   }
 }
 
+// Each iteration uses a new pattern to avoid hitting the LIKE cache. Patterns are
+// taken from dictionary strings, so each of them matches at least one string.
+void run_like_benchmark(benchmark::State& state,
+                        const std::vector<std::string>& strings,
+                        const bool use_trigram_index,
+                        const bool use_regexp) {
+  const bool prev_enable_trigram_index = g_enable_stringdict_trigram_index;
+  g_enable_stringdict_trigram_index = use_trigram_index;
+  const auto string_dict = create_and_populate_str_dict(1, true, strings);
+  // Build the index outside of the measured loop.
+  string_dict->getLike("%", false, false, '\\');
+  size_t pattern_idx = 0;
+  for (auto _ : state) {
+    const auto& str = strings[(pattern_idx++ * 7919) % strings.size()];
+    if (use_regexp) {
+      benchmark::DoNotOptimize(
+          string_dict->getRegexpLike(".*" + str.substr(2, 5) + ".*", '\\'));
+    } else {
+      benchmark::DoNotOptimize(
+          string_dict->getLike("%" + str.substr(2, 5) + "%", false, false, '\\'));
+    }
+  }
+  g_enable_stringdict_trigram_index = prev_enable_trigram_index;
+}
+
+BENCHMARK_DEFINE_F(StringDictionaryFixture, Like_1M_Unique)
+(benchmark::State& state) {
+  run_like_benchmark(state, append_strings_10M_1M_10, false, false);
+}
+
+BENCHMARK_DEFINE_F(StringDictionaryFixture, Like_1M_Unique_TrigramIndex)
+(benchmark::State& state) {
+  run_like_benchmark(state, append_strings_10M_1M_10, true, false);
+}
+
+BENCHMARK_DEFINE_F(StringDictionaryFixture, RegexpLike_1M_Unique)
+(benchmark::State& state) {
+  run_like_benchmark(state, append_strings_10M_1M_10, false, true);
+}
+
+BENCHMARK_DEFINE_F(StringDictionaryFixture, RegexpLike_1M_Unique_TrigramIndex)
+(benchmark::State& state) {
+  run_like_benchmark(state, append_strings_10M_1M_10, true, true);
+}
+
 BENCHMARK_REGISTER_F(StringDictionaryFixture, Create)
     ->MeasureProcessCPUTime()
     ->UseRealTime()
@@ -266,6 +313,26 @@ BENCHMARK_REGISTER_F(StringDictionaryFixture, BulkTranslation_10M_Unique)
     ->UseRealTime()
     ->Unit(benchmark::kMillisecond);
 
+BENCHMARK_REGISTER_F(StringDictionaryFixture, Like_1M_Unique)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(StringDictionaryFixture, Like_1M_Unique_TrigramIndex)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(StringDictionaryFixture, RegexpLike_1M_Unique)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(StringDictionaryFixture, RegexpLike_1M_Unique_TrigramIndex)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
 class StringDictionaryProxyFixture : public benchmark::Fixture {
  public:
   void SetUp(const ::benchmark::State& state) override {
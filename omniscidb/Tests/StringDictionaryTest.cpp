@@ -19,19 +19,24 @@
 #include "Shared/scope.h"
 #include "StringDictionary/StringDictionary.h"
 
+#include <algorithm>
+#include <boost/filesystem.hpp>
 #include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <limits>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 using namespace std::string_literals;
 
 EXTERN extern bool g_cache_string_hash;
 EXTERN extern bool g_enable_stringdict_parallel;
+EXTERN extern bool g_enable_stringdict_trigram_index;
 
 TEST(StringDictionary, AddAndGet) {
   const DictRef dict_ref(-1, 1);
@@ -189,6 +194,42 @@ TEST(StringDictionary, GetOrAddBulk) {
   }
 }
 
+TEST(StringDictionary, GetOrAddBulkConcurrent) {
+  const DictRef dict_ref(-1, 1);
+  StringDictionary string_dict(dict_ref, g_cache_string_hash);
+  constexpr int thread_count = 8;
+  constexpr int batch_size = 10000;
+  constexpr int unique_count = 3000;
+  std::vector<std::vector<std::string>> batches(thread_count);
+  std::vector<std::vector<int32_t>> batch_ids(thread_count,
+                                              std::vector<int32_t>(batch_size));
+  for (int t = 0; t < thread_count; ++t) {
+    for (int i = 0; i < batch_size; ++i) {
+      // Each batch has strings shared with other batches and own strings.
+      batches[t].push_back(i % 2 ? std::to_string((i * 7 + t) % unique_count)
+                                 : std::to_string(t) + "_" + std::to_string(i % 100));
+    }
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&string_dict, &batches, &batch_ids, t]() {
+      string_dict.getOrAddBulk(batches[t], batch_ids[t].data());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::unordered_set<std::string> unique_strings;
+  for (int t = 0; t < thread_count; ++t) {
+    unique_strings.insert(batches[t].begin(), batches[t].end());
+    for (int i = 0; i < batch_size; ++i) {
+      ASSERT_EQ(string_dict.getString(batch_ids[t][i]), batches[t][i]);
+    }
+  }
+  ASSERT_EQ(string_dict.storageEntryCount(), unique_strings.size());
+}
+
 TEST(StringDictionary, BuildTranslationMap) {
   const DictRef dict_ref1(-1, 1);
   const DictRef dict_ref2(-1, 2);
@@ -884,6 +925,91 @@ TEST(NestedStringDictionary, GetCompare) {
   sortAndCompare(dict2->getCompare("str6", "<>", 1), {0});
 }
 
+TEST(NestedStringDictionary, SortedIds) {
+  auto dict1 =
+      std::make_shared<StringDictionary>(DictRef{-1, 1}, -1, g_cache_string_hash);
+  ASSERT_TRUE(dict1->hasSortedIds());
+  dict1->getOrAddBulk(std::vector<std::string>{"str1", "str3", "str5"});
+  ASSERT_TRUE(dict1->hasSortedIds());
+  ASSERT_EQ(dict1->getSortedIdRange("str3", "<"), std::make_pair(0, 1));
+  ASSERT_EQ(dict1->getSortedIdRange("str3", "<="), std::make_pair(0, 2));
+  ASSERT_EQ(dict1->getSortedIdRange("str4", ">"), std::make_pair(2, 3));
+  ASSERT_EQ(dict1->getSortedIdRange("str3", ">="), std::make_pair(1, 3));
+  ASSERT_EQ(dict1->getSortedIdRange("str3", "="), std::make_pair(1, 2));
+  ASSERT_EQ(dict1->getSortedIdRange("str3", "<", 1), std::make_pair(0, 1));
+  ASSERT_FALSE(dict1->getSortedIdRange("str3", "<>"));
+
+  auto dict2 = std::make_shared<StringDictionary>(dict1, -1, g_cache_string_hash);
+  ASSERT_EQ(dict2->getOrAdd("str6"), 3);
+  ASSERT_TRUE(dict2->hasSortedIds());
+  ASSERT_EQ(dict2->getSortedIdRange("str5", ">="), std::make_pair(2, 4));
+  ASSERT_EQ(dict2->getOrAdd("str2"), 4);
+  ASSERT_FALSE(dict2->hasSortedIds());
+  ASSERT_TRUE(dict2->hasSortedIds(4));
+  ASSERT_FALSE(dict2->getSortedIdRange("str5", ">="));
+  sortAndCompare(dict2->getCompare("str5", ">="), {2, 3});
+
+  ASSERT_EQ(dict1->getOrAdd("str0"), 3);
+  ASSERT_FALSE(dict1->hasSortedIds());
+  ASSERT_TRUE(dict2->hasSortedIds(4));
+  auto dict3 = std::make_shared<StringDictionary>(dict1, -1, g_cache_string_hash);
+  ASSERT_EQ(dict3->getOrAdd("str7"), 4);
+  ASSERT_FALSE(dict3->hasSortedIds());
+}
+
+TEST(StringDictionary, SaveAndLoad) {
+  const auto path = (boost::filesystem::temp_directory_path() /
+                     boost::filesystem::unique_path("string_dict_%%%%-%%%%-%%%%.bin"))
+                        .string();
+  ScopeGuard remove_file = [&path] { boost::filesystem::remove(path); };
+
+  const int str_count = 1000;
+  {
+    StringDictionary string_dict(DictRef{-1, 1}, g_cache_string_hash);
+    string_dict.getOrAddBulk(std::vector<std::string>{"str0", "str1", "str2"});
+    for (int i = 3; i < str_count; ++i) {
+      ASSERT_EQ(string_dict.getOrAdd("str" + std::to_string(i)), i);
+    }
+    // Build the sorted cache to get it saved.
+    sortAndCompare(string_dict.getCompare("str998", ">"), {999});
+    string_dict.save(path);
+  }
+
+  auto loaded = StringDictionary::load(DictRef{-1, 2}, path);
+  ASSERT_EQ(loaded->getDictId(), 2);
+  ASSERT_EQ(loaded->storageEntryCount(), static_cast<size_t>(str_count));
+  for (int i = 0; i < str_count; ++i) {
+    ASSERT_EQ(loaded->getString(i), "str" + std::to_string(i));
+    ASSERT_EQ(loaded->getIdOfString("str" + std::to_string(i)), i);
+  }
+  ASSERT_FALSE(loaded->hasSortedIds());
+  ASSERT_TRUE(loaded->hasSortedIds(3));
+  sortAndCompare(loaded->getCompare("str998", ">"), {999});
+
+  // Additions don't modify the file.
+  ASSERT_EQ(loaded->getOrAdd("str1"), 1);
+  ASSERT_EQ(loaded->getOrAdd("new str"), str_count);
+  loaded->getOrAddBulk(std::vector<std::string>{"str2", "new str", "new str 2"});
+  ASSERT_EQ(loaded->storageEntryCount(), static_cast<size_t>(str_count + 2));
+  ASSERT_EQ(loaded->getString(str_count + 1), "new str 2");
+  ASSERT_EQ(loaded->getString(5), "str5");
+  loaded->compact();
+  ASSERT_EQ(loaded->getIdOfString("new str 2"s), str_count + 1);
+
+  auto reloaded = StringDictionary::load(DictRef{-1, 3}, path);
+  ASSERT_EQ(reloaded->storageEntryCount(), static_cast<size_t>(str_count));
+  ASSERT_EQ(reloaded->getIdOfString("new str"s), StringDictionary::INVALID_STR_ID);
+}
+
+TEST(StringDictionary, LoadInvalidFile) {
+  const auto path = (boost::filesystem::temp_directory_path() /
+                     boost::filesystem::unique_path("string_dict_%%%%-%%%%-%%%%.bin"))
+                        .string();
+  ScopeGuard remove_file = [&path] { boost::filesystem::remove(path); };
+  std::ofstream(path) << "not a dictionary";
+  ASSERT_THROW(StringDictionary::load(DictRef{-1, 1}, path), std::runtime_error);
+}
+
 TEST(NestedStringDictionary, GetRegexpLike) {
   auto dict1 =
       std::make_shared<StringDictionary>(DictRef{-1, 1}, -1, g_cache_string_hash);
@@ -914,6 +1040,57 @@ TEST(NestedStringDictionary, GetRegexpLike) {
   ASSERT_EQ(dict2->getRegexpLike("str[12467]", '\\'), std::vector<int>({0, 1, 4, 5}));
 }
 
+TEST(NestedStringDictionary, TrigramIndex) {
+  const bool prev_enable_trigram_index = g_enable_stringdict_trigram_index;
+  ScopeGuard reset = [prev_enable_trigram_index] {
+    g_enable_stringdict_trigram_index = prev_enable_trigram_index;
+  };
+  g_enable_stringdict_trigram_index = true;
+
+  auto dict1 =
+      std::make_shared<StringDictionary>(DictRef{-1, 1}, -1, g_cache_string_hash);
+  dict1->getOrAddBulk(std::vector<std::string>{"foobar", "FooBaz", "bar", "xfoo_bar"});
+
+  ASSERT_EQ(dict1->getLike("%foo%", false, false, '\\'), std::vector<int>({0, 3}));
+  ASSERT_EQ(dict1->getLike("foo", true, true, '\\'), std::vector<int>({0, 1, 3}));
+  ASSERT_EQ(dict1->getLike("%o\\_b%", false, false, '\\'), std::vector<int>({3}));
+  ASSERT_EQ(dict1->getLike("%foo%", false, false, '\\', 2), std::vector<int>({0}));
+  ASSERT_EQ(dict1->getLike("ba%", false, false, '\\'), std::vector<int>({2}));
+  ASSERT_EQ(dict1->getRegexpLike("Foo.*", '\\'), std::vector<int>({1}));
+  ASSERT_EQ(dict1->getRegexpLike(".*fo+_?bar", '\\'), std::vector<int>({0, 3}));
+  ASSERT_EQ(dict1->getRegexpLike("(foo|bar).*", '\\'), std::vector<int>({0, 2}));
+  // Character classes in bracket expressions contain ']'.
+  ASSERT_EQ(dict1->getRegexpLike("[[:alpha:]]oobar", '\\'), std::vector<int>({0}));
+  ASSERT_EQ(dict1->getRegexpLike(".*[[:alpha:]]bar", '\\'), std::vector<int>({0}));
+
+  // New strings are added to the existing index.
+  auto dict2 = std::make_shared<StringDictionary>(dict1, -1, g_cache_string_hash);
+  ASSERT_EQ(dict1->getOrAdd("barfoo"), 4);
+  ASSERT_EQ(dict2->getOrAdd("foofoo"), 4);
+  dict2->getOrAddBulk(std::vector<std::string>{"bar", "afoob"});
+
+  ASSERT_EQ(dict1->getLike("%foo%", false, false, '\\'), std::vector<int>({0, 3, 4}));
+  ASSERT_EQ(dict2->getLike("%foo%", false, false, '\\'), std::vector<int>({0, 3, 4, 5}));
+  ASSERT_EQ(dict2->getLike("%foo%", false, false, '\\', 5), std::vector<int>({0, 3, 4}));
+  ASSERT_EQ(dict2->getRegexpLike(".*foob.*", '\\'), std::vector<int>({0, 5}));
+}
+
+TEST(StringDictionary, SimpleLikeLongStrings) {
+  // Strings are long enough to be searched 16 positions at a time.
+  const std::string prefix(40, 'x');
+  StringDictionary dict(DictRef{-1, 1}, -1, g_cache_string_hash);
+  dict.getOrAddBulk(std::vector<std::string>{prefix + "aBcD" + prefix,
+                                             prefix + "abd" + prefix + "abcd",
+                                             prefix + "ab" + prefix,
+                                             prefix + "AbCd"});
+
+  ASSERT_EQ(dict.getLike("abcd", false, true, '\\'), std::vector<int>({1}));
+  ASSERT_EQ(dict.getLike("abcd", true, true, '\\'), std::vector<int>({0, 1, 3}));
+  ASSERT_EQ(dict.getLike("xab", true, true, '\\'), std::vector<int>({0, 1, 2, 3}));
+  ASSERT_EQ(dict.getLike("xabx", false, true, '\\'), std::vector<int>({2}));
+  ASSERT_EQ(dict.getLike(prefix + prefix, false, true, '\\'), std::vector<int>());
+}
+
 TEST(NestedStringDictionary, BuildTranslationMap_EmptyDict) {
   auto source1 =
       std::make_shared<StringDictionary>(DictRef{-1, 1}, -1, g_cache_string_hash);
@@ -1002,6 +1179,27 @@ TEST(NestedStringDictionary, BuildTranslationMap) {
                               7}));
 }
 
+TEST(NestedStringDictionary, BuildTransformTranslationMap) {
+  auto dict1 =
+      std::make_shared<StringDictionary>(DictRef{-1, 1}, -1, g_cache_string_hash);
+  dict1->getOrAddBulk(std::vector<std::string>{"ABC", "abc", "Xyz"});
+  auto dict2 = std::make_shared<StringDictionary>(dict1, -1, g_cache_string_hash);
+  ASSERT_EQ(dict2->getOrAdd("DEF"), 3);
+  // Add some string that should be ignored on translation.
+  ASSERT_EQ(dict1->getOrAdd("xyz"), 3);
+
+  auto to_lower = [](const std::string& str) {
+    std::string res(str);
+    std::transform(res.begin(), res.end(), res.begin(), ::tolower);
+    return res;
+  };
+  ASSERT_EQ(dict2->buildTransformTranslationMap(to_lower),
+            std::vector<int>({1, 1, 4, 5}));
+  ASSERT_EQ(dict2->entryCount(), size_t(6));
+  ASSERT_EQ(dict2->getString(4), "xyz");
+  ASSERT_EQ(dict2->getString(5), "def");
+}
+
 TEST(NestedStringDictionary, BuildIntersectionTranslationMap) {
   // Use existing dictionary from GetBulk
   const DictRef dict_ref1(-1, 1);
@@ -181,6 +181,16 @@ TEST_F(LowerFunctionTest, LowercaseGroupBy) {
   compare_result_set(expected_result_set, result_set);
 }
 
+TEST_F(LowerFunctionTest, LowercaseProjectionAndFilter) {
+  auto result_set = run_multiple_agg(
+      "select lower(first_name), lower(lower(country_code)) from "
+      "lower_function_test_people where lower(first_name) = 'john' order by age;",
+      ExecutorDeviceType::CPU);
+  std::vector<std::vector<ScalarTargetValue>> expected_result_set{
+      {"john", "ca"}, {"john", "us"}, {"john", "us"}};
+  compare_result_set(expected_result_set, result_set);
+}
+
 TEST_F(LowerFunctionTest, LowercaseJoin) {
   auto result_set = run_multiple_agg(
       "select first_name, name as country_name "
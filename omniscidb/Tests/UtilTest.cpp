@@ -172,6 +172,35 @@ TEST(Utils, Regexp) {
   ASSERT_TRUE(regexp_like("hello [", 7, ".*\\[.*", 6, '\\'));
 }
 
+TEST(Utils, RegexpLiteralPrefix) {
+  ASSERT_TRUE(regexp_like("abc", 3, "^abc", 4, '\\'));
+  ASSERT_FALSE(regexp_like("abcd", 4, "abc", 3, '\\'));
+  ASSERT_TRUE(regexp_like("abd", 3, "abc?d", 5, '\\'));
+  ASSERT_TRUE(regexp_like("ad", 2, "ab*d", 4, '\\'));
+  ASSERT_TRUE(regexp_like("abbd", 4, "ab+d", 4, '\\'));
+  ASSERT_FALSE(regexp_like("ad", 2, "ab+d", 4, '\\'));
+  ASSERT_TRUE(regexp_like("ad", 2, "ab{0,2}d", 8, '\\'));
+  ASSERT_TRUE(regexp_like("xyz", 3, "abc|xyz", 7, '\\'));
+  ASSERT_TRUE(regexp_like("error: 42", 9, "error: [0-9]+", 13, '\\'));
+  ASSERT_FALSE(regexp_like("warning: 42", 11, "error: [0-9]+", 13, '\\'));
+  // Invalid patterns match nothing.
+  ASSERT_FALSE(regexp_like("abc", 3, "a(bc", 4, '\\'));
+  // Too complex matches are reported as no match.
+  const std::string long_str(30, 'a');
+  ASSERT_FALSE(regexp_like(long_str.data(), long_str.size(), "(a*)*b", 6, '\\'));
+}
+
+TEST(Utils, RegexpManyPatterns) {
+  for (int i = 0; i < 3000; ++i) {
+    const auto str = "str" + std::to_string(i);
+    const auto pattern = "str" + std::to_string(i) + "[0-9]*";
+    ASSERT_TRUE(
+        regexp_like(str.data(), str.size(), pattern.data(), pattern.size(), '\\'));
+    ASSERT_FALSE(regexp_like(
+        str.data(), str.size(), pattern.data() + 1, pattern.size() - 1, '\\'));
+  }
+}
+
 int main(int argc, char* argv[]) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
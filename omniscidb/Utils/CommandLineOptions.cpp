@@ -32,6 +32,7 @@
 
 bool g_use_table_device_offset;  // TODO(adb): where did this go?
 extern bool g_cache_string_hash;
+extern bool g_enable_stringdict_trigram_index;
 extern int64_t g_bitmap_memory_limit;
 extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
@@ -156,6 +157,13 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_enable_stringdict_parallel)
           ->implicit_value(true),
       "Allow StringDictionary to parallelize loads using multiple threads");
+  help_desc.add_options()(
+      "stringdict-trigram-index",
+      po::value<bool>(&g_enable_stringdict_trigram_index)
+          ->default_value(g_enable_stringdict_trigram_index)
+          ->implicit_value(true),
+      "Build trigram indexes on string dictionaries to prefilter LIKE and REGEXP "
+      "matches.");
   help_desc.add_options()("log-user-origin",
                           po::value<bool>(&log_user_origin)
                               ->default_value(log_user_origin)
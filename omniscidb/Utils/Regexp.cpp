@@ -26,7 +26,97 @@
 
 #ifndef __CUDACC__
 #include <boost/regex.hpp>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+// Compiled regexp_like pattern. Compiled patterns are immutable and matched by many
+// threads concurrently.
+struct CompiledRegexp {
+  std::string pattern;
+  // Empty for invalid patterns, which match nothing.
+  std::optional<boost::regex> re;
+  // Every matching string starts with this prefix.
+  std::string literal_prefix;
+  // The pattern matches literal_prefix only.
+  bool is_literal = false;
+};
+
+constexpr size_t kMaxCachedRegexps = 1024;
+
+void fill_literal_prefix(CompiledRegexp& compiled) {
+  std::string_view pattern = compiled.pattern;
+  // Alternatives don't share a prefix.
+  if (pattern.find('|') != std::string_view::npos) {
+    return;
+  }
+  if (!pattern.empty() && pattern.front() == '^') {
+    pattern.remove_prefix(1);
+  }
+  size_t len = 0;
+  while (len < pattern.size() && !strchr(".[]()*+?{}^$\\", pattern[len])) {
+    ++len;
+  }
+  if (len == pattern.size()) {
+    compiled.is_literal = true;
+  } else if (len && strchr("*?{", pattern[len])) {
+    // The last literal is optional.
+    --len;
+  }
+  compiled.literal_prefix = pattern.substr(0, len);
+}
+
+std::shared_ptr<const CompiledRegexp> compile_regexp(std::string_view pattern) {
+  static std::shared_mutex cache_mutex;
+  static std::unordered_map<std::string_view, std::shared_ptr<const CompiledRegexp>>
+      cache;
+  {
+    std::shared_lock<std::shared_mutex> read_lock(cache_mutex);
+    auto it = cache.find(pattern);
+    if (it != cache.end()) {
+      return it->second;
+    }
+  }
+
+  auto compiled = std::make_shared<CompiledRegexp>();
+  compiled->pattern = std::string(pattern);
+  try {
+    compiled->re.emplace(compiled->pattern, boost::regex::extended);
+    fill_literal_prefix(*compiled);
+  } catch (std::runtime_error& error) {
+    compiled->re.reset();
+  }
+
+  std::unique_lock<std::shared_mutex> write_lock(cache_mutex);
+  if (cache.size() >= kMaxCachedRegexps) {
+    // Compiled patterns are still owned by threads using them.
+    cache.clear();
+  }
+  // Keys point to patterns owned by cached values.
+  auto res = cache.emplace(compiled->pattern, compiled);
+  return res.first->second;
+}
+
+// Patterns are compiled once and shared by all threads through the cache above. Each
+// thread also keeps the last used pattern to match rows of a column without locking.
+const CompiledRegexp& get_compiled_regexp(const char* pattern, const int32_t pat_len) {
+  thread_local std::shared_ptr<const CompiledRegexp> last_compiled;
+  const std::string_view pattern_view(pattern, pat_len);
+  if (!last_compiled || last_compiled->pattern != pattern_view) {
+    last_compiled = compile_regexp(pattern_view);
+  }
+  return *last_compiled;
+}
+
+}  // namespace
 #endif
 
 /*
@@ -44,16 +134,23 @@ extern "C" RUNTIME_EXPORT DEVICE bool regexp_like(const char* str,
                                                   const int32_t pat_len,
                                                   const char escape_char) {
 #ifndef __CUDACC__
-  bool result;
+  const auto& compiled = get_compiled_regexp(pattern, pat_len);
+  if (!compiled.re) {
+    return false;
+  }
+  const std::string_view str_view(str, str_len);
+  if (compiled.is_literal) {
+    return str_view == compiled.literal_prefix;
+  }
+  if (str_view.substr(0, compiled.literal_prefix.size()) != compiled.literal_prefix) {
+    return false;
+  }
   try {
-    boost::regex re(pattern, pat_len, boost::regex::extended);
-    boost::cmatch what;
-    result = boost::regex_match(str, str + str_len, what, re);
+    return boost::regex_match(str, str + str_len, *compiled.re);
   } catch (std::runtime_error& error) {
-    // LOG(ERROR) << "Regexp match error: " << error.what();
-    result = false;
+    // Boost throws on too complex matches, e.g. '(a*)*b' against long strings.
+    return false;
   }
-  return result;
 #else
   return false;
 #endif
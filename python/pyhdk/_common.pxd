@@ -6,6 +6,8 @@
 from libcpp cimport bool
 from libcpp.string cimport string
 from libcpp.memory cimport shared_ptr
+from libcpp.pair cimport pair
+from libcpp.vector cimport vector
 
 cdef extern from "omniscidb/IR/Type.h":
   enum CTypeId "hdk::ir::Type::Id":
@@ -250,6 +252,8 @@ cdef extern from "omniscidb/Shared/Config.h":
     string use_ra_cache
     bool enable_automatic_ir_metadata
     string log_dir
+    bool enable_query_trace
+    string query_trace_dir
 
   cdef cppclass CStorageConfig "StorageConfig":
     bool enable_lazy_dict_materialization
@@ -277,3 +281,20 @@ cdef extern from "omniscidb/ConfigBuilder/ConfigBuilder.h":
 
 cdef extern from "boost/variant.hpp":
   T *boost_get "boost::get"[T](void *)
+
+cdef extern from "omniscidb/Shared/Metrics.h":
+  cdef cppclass CMetricsSample "metrics::Registry::Sample":
+    string name
+    vector[pair[string, string]] labels
+    double value
+
+  cdef cppclass CMetricsRegistry "metrics::Registry":
+    vector[CMetricsSample] snapshot()
+    string toPrometheus()
+    void dumpPrometheus(const string&) except +
+    void reset()
+
+  cdef CMetricsRegistry& CGetMetricsRegistry "metrics::registry"()
+
+cdef class MetricsRegistry:
+  cdef CMetricsRegistry* c_registry
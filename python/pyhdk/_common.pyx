@@ -4,7 +4,7 @@
 # SPDX-License-Identifier: Apache-2.0
 
 from libcpp.memory cimport unique_ptr, make_unique, shared_ptr
-from cython.operator cimport dereference
+from cython.operator cimport dereference, address
 
 cdef class TypeId:
   cdef CTypeId c_val
@@ -212,3 +212,28 @@ def initLogger(*, debug_logs=None, log_dir="hdk_log", **kwargs):
   if not isinstance(debug_logs, str) and debug_logs:
     opts.get().severity_ = CSeverity.DEBUG3
   CInitLogger(dereference(opts))
+
+# All objects refer to the same process-wide registry.
+cdef class MetricsRegistry:
+  def __cinit__(self):
+    self.c_registry = address(CGetMetricsRegistry())
+
+  # Current values as a list of (name, labels, value) Prometheus samples.
+  # Histograms are reported as <name>_bucket samples with the "le" label,
+  # <name>_sum and <name>_count.
+  def snapshot(self):
+    cdef vector[CMetricsSample] samples = self.c_registry.snapshot()
+    cdef size_t i
+    res = []
+    for i in range(samples.size()):
+      res.append((samples[i].name, dict(samples[i].labels), samples[i].value))
+    return res
+
+  def to_prometheus(self):
+    return self.c_registry.toPrometheus()
+
+  def dump_prometheus(self, path):
+    self.c_registry.dumpPrometheus(path)
+
+  def reset(self):
+    self.c_registry.reset()
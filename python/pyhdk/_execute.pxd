@@ -72,6 +72,8 @@ cdef extern from "omniscidb/QueryEngine/CompilationOptions.h":
     bool output_columnar_hint
     bool allow_multifrag
     bool just_explain
+    bool explain_analyze
+    bool query_trace
     bool allow_loop_joins
     bool with_watchdog
     bool jit_debug
@@ -3,6 +3,7 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
+from libc.stdint cimport int8_t, int32_t, uint8_t
 from libcpp cimport bool
 from libcpp.memory cimport shared_ptr, unique_ptr
 from libcpp.string cimport string
@@ -52,6 +53,21 @@ cdef extern from "omniscidb/QueryEngine/RelAlgDagBuilder.h":
   cdef cppclass CRelAlgDagBuilder "RelAlgDagBuilder"(CQueryDag):
     CRelAlgDagBuilder(const string&, int, CSchemaProviderPtr, shared_ptr[CConfig]) except +
 
+cdef extern from "omniscidb/StringDictionary/StringDictionary.h":
+  cdef cppclass CStringDictionary "StringDictionary":
+    vector[string] getStrings(const vector[int32_t]&) except +
+
+cdef extern from "omniscidb/ResultSetRegistry/ColumnBatch.h":
+  cdef cppclass CColumnSpan "hdk::ColumnSpan":
+    const CType* type
+    vector[int8_t] data
+    vector[uint8_t] nulls
+    shared_ptr[CStringDictionary] dict
+
+  cdef cppclass CColumnBatch "hdk::ColumnBatch":
+    size_t row_count
+    vector[CColumnSpan] columns
+
 cdef extern from "omniscidb/ResultSetRegistry/ResultSetTableToken.h":
   cdef cppclass CResultSetTableToken "hdk::ResultSetTableToken":
     size_t rowCount()
@@ -61,6 +77,7 @@ cdef extern from "omniscidb/ResultSetRegistry/ResultSetTableToken.h":
     string contentToString(bool)
 
     vector[CTargetValue] row(size_t, bool, bool) except +
+    CColumnBatch fetchColumns(size_t, size_t) except +
 
 ctypedef shared_ptr[const CResultSetTableToken] CResultSetTableTokenPtr
 
@@ -89,6 +106,12 @@ cdef class ExecutionResult:
   # to provide an ability to work with an execution result as with a regular
   # table
   cdef object _scan
+  # Arrow table converted in advance, when the query is traced.
+  cdef object _arrow_table
+
+cdef extern from "omniscidb/QueryEngine/QueryTrace.h":
+  cdef cppclass CQueryTrace "QueryTrace":
+    CQueryTrace(const CConfig&, bool, const char*, int, const char*) except +
 
 cdef extern from "omniscidb/QueryEngine/RelAlgExecutor.h":
   cdef cppclass CRelAlgExecutor "RelAlgExecutor":
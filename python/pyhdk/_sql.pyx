@@ -3,7 +3,7 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
-from libc.stdint cimport int64_t
+from libc.stdint cimport int32_t, int64_t
 from libcpp.memory cimport make_shared, make_unique
 from libcpp.utility cimport move
 from cython.operator cimport dereference, preincrement, address
@@ -17,6 +17,8 @@ from pyhdk._execute cimport Executor, CExecutorDeviceType, CArrowResultSetConver
 from pyhdk._execute cimport CNullableString, CScalarTargetValue, CArrayTargetValue, CTargetValue, isNull
 from pyhdk._execute cimport isNull, isInt, getInt, isFloat, getFloat, isDouble, getDouble, isString, getString
 
+import numpy as np
+
 cdef class Calcite:
   cdef CalciteMgr* calcite
   cdef CSchemaProviderPtr schema_provider
@@ -72,12 +74,40 @@ cdef extract_array_value(const CArrayTargetValue *array, const CType *c_type):
 
   return None
 
+cdef extract_column_span(const CColumnSpan *col, size_t row_count):
+  cdef const CType *col_type = col.type
+  cdef size_t elem_size = col_type.size()
+  cdef vector[int32_t] ids
+  nulls = np.frombuffer((<const char*>col.nulls.data())[:row_count], dtype=np.bool_)
+  if col_type.isFloatingPoint():
+    dtype = np.float32 if elem_size == 4 else np.float64
+  else:
+    dtype = np.dtype("int" + str(elem_size * 8))
+  values = np.frombuffer((<const char*>col.data.data())[:row_count * elem_size], dtype=dtype)
+
+  if col_type.isExtDictionary():
+    # Decode each distinct id once.
+    unique_ids, inverse = np.unique(values[~nulls], return_inverse=True)
+    ids = unique_ids
+    strings = np.array(col.dict.get().getStrings(ids), dtype=object)
+    res = np.full(row_count, None, dtype=object)
+    res[~nulls] = strings[inverse]
+    return res
+
+  if col_type.isBoolean():
+    values = values.astype(np.bool_)
+  if col_type.nullable():
+    return np.ma.masked_array(values, mask=nulls)
+  return values
+
 cdef class ExecutionResult:
   def row_count(self):
     cdef CResultSetTableTokenPtr c_token = self.c_result.getToken()
     return int(c_token.get().rowCount())
 
   def to_arrow(self):
+    if self._arrow_table is not None:
+      return self._arrow_table
     cdef CResultSetTableTokenPtr c_token = self.c_result.getToken()
     cdef shared_ptr[CArrowTable] at = c_token.get().toArrow()
     return pyarrow_wrap_table(at)
@@ -133,6 +163,39 @@ cdef class ExecutionResult:
 
     return res
 
+  def fetch_columns(self, start=0, count=None):
+    """
+    Fetch a range of rows as a dictionary of NumPy arrays, one per column.
+
+    Values are copied column by column instead of being converted cell by cell.
+    Nullable columns are returned as masked arrays, dictionary encoded strings
+    as object arrays holding None for nulls. Dates, times and decimals are
+    returned in their encoded integer representation. Columns holding arrays
+    or none-encoded strings are not supported.
+
+    Parameters
+    ----------
+    start : int, default: 0
+        The first row to fetch.
+    count : int, optional
+        The maximum number of rows to fetch. All remaining rows are fetched
+        by default.
+
+    Returns
+    -------
+    dict
+    """
+    cdef CResultSetTableTokenPtr c_token = self.c_result.getToken()
+    cdef size_t c_count = c_token.get().rowCount() if count is None else count
+    cdef CColumnBatch batch = c_token.get().fetchColumns(start, c_count)
+    cdef size_t col_idx = 0
+    res = {}
+    while col_idx < batch.columns.size():
+      name = self.c_result.getTargetsMeta().at(col_idx).get_resname()
+      res[name] = extract_column_span(address(batch.columns.at(col_idx)), batch.row_count)
+      col_idx += 1
+    return res
+
   def head(self, n):
     res = ExecutionResult()
     res.c_result = self.c_result.head(n)
@@ -204,10 +267,19 @@ cdef class RelAlgExecutor:
     c_eo.get().with_watchdog = kwargs.get("enable_watchdog", config.exec.watchdog.enable)
     c_eo.get().with_dynamic_watchdog = kwargs.get("enable_dynamic_watchdog", config.exec.watchdog.enable_dynamic)
     c_eo.get().just_explain = kwargs.get("just_explain", False)
+    c_eo.get().explain_analyze = kwargs.get("explain_analyze", False)
+    c_eo.get().query_trace = kwargs.get("query_trace", config.debug.enable_query_trace)
     c_eo.get().forced_gpu_proportion = kwargs.get("forced_gpu_proportion", config.exec.heterogeneous.forced_gpu_proportion)
     c_eo.get().forced_cpu_proportion = 100 - c_eo.get().forced_gpu_proportion
+    # The query trace is extended to the conversion of the result to Arrow.
+    cdef unique_ptr[CQueryTrace] c_trace
+    if c_eo.get().query_trace:
+      c_trace.reset(new CQueryTrace(dereference(config), True, "_sql.pyx", 0, "RelAlgExecutor.execute"))
     cdef CExecutionResult c_res = self.c_rel_alg_executor.get().executeRelAlgQuery(dereference(c_co.get()), dereference(c_eo.get()), False)
     cdef ExecutionResult res = ExecutionResult()
     res.c_result = move(c_res)
     res.c_data_mgr = self.c_data_mgr
+    if c_trace.get() != NULL:
+      res._arrow_table = res.to_arrow()
+      c_trace.reset()
     return res
@@ -16,6 +16,7 @@ from pyhdk._execute import Executor, ResultSetRegistry
 from pyhdk._builder import QueryBuilder, QueryExpr, QueryNode
 
 import pyarrow
+import re
 import uuid
 from collections.abc import Iterable
 import glob
@@ -2097,6 +2098,30 @@ class QueryOptions:
             )
         self._opts["just_explain"] = value
 
+    @property
+    def explain_analyze(self):
+        return self._opts.get("explain_analyze", False)
+
+    @explain_analyze.setter
+    def explain_analyze(self, value):
+        if type(value) != type(True):
+            raise TypeError(
+                f"Expected bool value for 'explain_analyze' option. Got: {type(value)}."
+            )
+        self._opts["explain_analyze"] = value
+
+    @property
+    def query_trace(self):
+        return self._opts.get("query_trace", False)
+
+    @query_trace.setter
+    def query_trace(self, value):
+        if type(value) != type(True):
+            raise TypeError(
+                f"Expected bool value for 'query_trace' option. Got: {type(value)}."
+            )
+        self._opts["query_trace"] = value
+
     @property
     def device_type(self):
         return self._opts.get("device_type", "auto")
@@ -2460,7 +2485,9 @@ class HDK:
         Parameters
         ----------
         sql_query : str
-            SQL query to execute.
+            SQL query to execute. The query prefixed with EXPLAIN ANALYZE is
+            executed and its runtime profile is returned instead of the result.
+            Use ExecutionResult.to_explain_str to get the profile.
         query_opts : QueryOptions or dict, default: None
             Query execution options.
         **kwargs : dict
@@ -2491,6 +2518,12 @@ class HDK:
                 f"Expected dict or QueryOptions for 'query_opts' arg. Got: {type(query_opts)}."
             )
 
+        # Calcite doesn't parse EXPLAIN ANALYZE, it is passed as a query option.
+        explain_analyze = re.match(r"\s*EXPLAIN\s+ANALYZE\s", sql_query, re.IGNORECASE)
+        if explain_analyze:
+            sql_query = sql_query[explain_analyze.end() :]
+            query_opts = dict(query_opts, explain_analyze=True)
+
         parts = []
         for name, orig_table in kwargs.items():
             if (
@@ -1011,6 +1011,29 @@ class TestBuilder(BaseTest):
 
         hdk.drop_table(ht)
 
+    def test_fetch_columns(self, exe_cfg):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict(
+            {
+                "a": [1, 2, None, 4],
+                "b": [1.1, None, 3.3, 4.4],
+                "c": ["str1", None, "str3", "str1"],
+            }
+        )
+
+        res = ht.proj("c", "b", "a").run(device_type=exe_cfg.device_type)
+        cols = res.fetch_columns()
+        assert list(cols.keys()) == ["c", "b", "a"]
+        assert list(cols["c"]) == ["str1", None, "str3", "str1"]
+        assert cols["b"].tolist() == [1.1, None, 3.3, 4.4]
+        assert cols["a"].tolist() == [1, 2, None, 4]
+
+        cols = res.fetch_columns(1, 2)
+        assert list(cols["c"]) == [None, "str3"]
+        assert cols["a"].tolist() == [2, None]
+
+        hdk.drop_table(ht)
+
     def test_shape(self, exe_cfg):
         hdk = pyhdk.init()
         ht = hdk.import_pydict({"a": [1, 2, 3, 4, 5], "b": [10, 20, 30, 40, 50]})
@@ -1318,6 +1341,19 @@ class TestSql(BaseTest):
         )
         check_res(res3, {"b": [4, 3, 2, 1, 0], "a": [2, 3, 4, 5, 6]})
 
+    def test_explain_analyze(self, exe_cfg):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": [1, 2, 3, 4, 5], "b": [5, 4, 3, 2, 1]})
+
+        res = hdk.sql(
+            "explain analyze SELECT SUM(a) FROM t1 WHERE b > 2;",
+            t1=ht,
+            query_opts={"device_type": exe_cfg.device_type},
+        )
+        explain_str = res.to_explain_str()
+        assert explain_str.startswith("Step 1: ")
+        assert "Total: " in explain_str
+
 
 class BaseTaxiTest:
     @staticmethod
@@ -95,3 +95,28 @@ class TestCalcite:
         assert len(ra["rels"]) == 2
         assert ra["rels"][0]["relOp"] == "LogicalTableScan"
         assert ra["rels"][1]["relOp"] == "LogicalProject"
+
+
+class TestMetrics:
+    def test_registry(self, tmp_path):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": [1, 2, 3]})
+        hdk.sql(f"SELECT SUM(a) FROM {ht.table_name};")
+
+        registry = pyhdk.MetricsRegistry()
+        samples = {
+            (name, tuple(sorted(labels.items()))): value
+            for name, labels, value in registry.snapshot()
+        }
+        assert samples[("hdk_kernels_total", ())] > 0
+        assert ("hdk_running_kernels", ()) in samples
+
+        text = registry.to_prometheus()
+        assert "# TYPE hdk_kernels_total counter\n" in text
+
+        path = tmp_path / "metrics.prom"
+        registry.dump_prometheus(str(path))
+        assert "# TYPE hdk_kernels_total counter\n" in path.read_text()
+
+        with pytest.raises(RuntimeError):
+            registry.dump_prometheus(str(tmp_path / "missing" / "metrics.prom"))
@@ -6,7 +6,9 @@
 # SPDX-License-Identifier: Apache-2.0
 
 
+import glob
 import json
+import os
 import pandas
 import pyarrow
 import pytest
@@ -73,6 +75,29 @@ class TestSql:
         explain_str = res.to_explain_str()
         assert explain_str[:15] == "IR for the CPU:"
 
+    def test_explain_analyze(self):
+        res = self.execute_sql("SELECT COUNT(*) FROM test;", explain_analyze=True)
+        explain_str = res.to_explain_str()
+        assert explain_str.startswith("Step 1: ")
+        assert "Total: " in explain_str
+
+    def test_query_trace(self):
+        # Traces are written to the log directory by default.
+        pattern = os.path.join("hdk_log", "query_trace_*.json")
+        old_traces = set(glob.glob(pattern))
+        res = self.execute_sql("SELECT COUNT(*) FROM test;", query_trace=True)
+        assert res.to_arrow().to_pandas()["EXPR$0"].tolist() == [3]
+        new_traces = set(glob.glob(pattern)) - old_traces
+        assert len(new_traces) == 1
+        trace_path = new_traces.pop()
+        with open(trace_path) as f:
+            trace = json.load(f)
+        os.remove(trace_path)
+        names = {event["name"] for event in trace["traceEvents"]}
+        # The query trace covers the conversion of the result to Arrow.
+        assert "RelAlgExecutor.execute" in names
+        assert "executeRelAlgQuery" in names
+
     def test_storage_exceptions(self):
         at = pyarrow.Table.from_pandas(
             pandas.DataFrame({"c": [1, 2, 3], "d": [10, 20, 30]})